@@ -1,13 +1,18 @@
 #ifndef BACKTESTER_H
 #define BACKTESTER_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 #include "../strategies/strategy_manager.h"
+#include "../data_processing/bar_aggregator.h"
 #include "../data_processing/data_processor.h"
 
 // The Backtester class is responsible for running backtests on historical data.
 // It uses the strategy manager to execute strategies and the data processor to handle raw data.
+// Time bars of config::BAR_INTERVAL_NANOS are built once from the replayed trades and delivered to
+// every strategy in time order with the ticks: each bar arrives before the first tick past its interval.
 class Backtester {
 public:
     // Constructor that takes a strategy manager and a data processor.
@@ -18,9 +23,18 @@ public:
     // It loads, processes the data, and applies strategies to the historical data points.
     void runBacktest(const std::string& historicalDataFile);
 
+    // Method to run the backtest on the ticks with timestamps in [start, end) (nanoseconds since epoch),
+    // optionally restricted to a set of instruments. Only the part of the file covering the range is read.
+    void runBacktest(const std::string& historicalDataFile, std::int64_t start, std::int64_t end,
+                     const std::vector<InstrumentId>& instruments = {});
+
 private:
+    // Process a loaded batch and run the strategies over it.
+    void replay(TickBatch& batch, const std::string& historicalDataFile);
+
     std::shared_ptr<StrategyManager> strategyManager_;  // Manages the execution of trading strategies
     std::shared_ptr<DataProcessor> dataProcessor_;      // Handles the processing of raw historical data
+    BarAggregator bars_;                                // Builds the bars shared by all strategies
 };
 
 #endif // BACKTESTER_H
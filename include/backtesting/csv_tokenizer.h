@@ -0,0 +1,83 @@
+#ifndef CSV_TOKENIZER_H
+#define CSV_TOKENIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "../data_processing/tick_batch.h"
+
+// The CsvTokenizer class parses historical tick data in CSV form directly into a TickBatch.
+// Delimiters and newlines are located 64 bytes at a time with a vectorized scan (AVX2 or SSE2,
+// selected at runtime, with a portable scalar fallback), and each field is parsed straight
+// into its typed column without creating intermediate strings.
+//
+// The first line is treated as a header and mapped to columns by name
+// (e.g. "Date,Price,Volume" or "timestamp,instrument,bid,ask,bid_size,ask_size,price,qty").
+// Unknown columns are ignored. If the first line already contains data, the default
+// "Date,Price,Volume" layout is assumed. Quoted fields are not supported.
+class CsvTokenizer {
+public:
+    // Scanning kernel used to find delimiters.
+    enum class Kernel {
+        Scalar,  // Byte-by-byte scan, available everywhere
+        Sse2,    // 4 x 16-byte compares per 64-byte block
+        Avx2     // 2 x 32-byte compares per 64-byte block
+    };
+
+    // Constructor that selects the scanning kernel. Defaults to the best kernel supported by the CPU.
+    explicit CsvTokenizer(Kernel kernel = detectKernel());
+
+    // Detect the fastest kernel supported by the current CPU.
+    static Kernel detectKernel();
+
+    // Check whether a kernel can run on the current CPU.
+    static bool isSupported(Kernel kernel);
+
+    // Kernel used by this tokenizer.
+    Kernel kernel() const { return kernel_; }
+
+    // Parse a complete CSV document and append its rows to the batch.
+    // Rows whose timestamp cannot be parsed are skipped.
+    // Returns the number of rows appended.
+    std::size_t parse(std::string_view text, TickBatch& batch) const;
+
+    // Parse a run of data rows using the column layout of the given header line.
+    // `rows` must start at the beginning of a line and must not contain the header itself;
+    // this is used to parse a slice of a larger file. Returns the number of rows appended.
+    std::size_t parseRows(std::string_view headerLine, std::string_view rows, TickBatch& batch) const;
+
+    // Offset of the first data row in a document (0 if the document has no header line).
+    static std::size_t dataOffset(std::string_view text);
+
+    // Index of the timestamp column described by a header line.
+    static std::size_t timestampColumn(std::string_view headerLine);
+
+private:
+    // Meaning of a CSV column.
+    enum class Field : std::uint8_t {
+        Ignored,
+        Timestamp,
+        Instrument,
+        BidPrice,
+        AskPrice,
+        BidSize,
+        AskSize,
+        TradePrice,
+        TradeQuantity
+    };
+
+    // Map the header line to column roles. Returns false if the line is data, not a header.
+    static bool parseHeader(std::string_view line, std::vector<Field>& fields);
+
+    // Parse one field into the tick being assembled. Returns false if the value is malformed.
+    static bool parseField(Field field, std::string_view text, Tick& tick);
+
+    // Bitmask of ',' and '\n' positions in a 64-byte block.
+    using MaskFunction = std::uint64_t (*)(const char* block);
+
+    Kernel kernel_;
+    MaskFunction mask_;
+};
+
+#endif // CSV_TOKENIZER_H
@@ -0,0 +1,26 @@
+#ifndef DELTA_CODEC_H
+#define DELTA_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Delta + zig-zag + varint codec for blocks of 64-bit integers.
+//
+// Each value is stored as the difference to the previous value of the block (the first value
+// as a difference to zero), zig-zag mapped so that small negative deltas stay small, and written
+// as a LEB128 varint. Because every block starts from zero, any block can be decoded on its own.
+// Sorted timestamps and slowly moving prices mostly encode to one or two bytes per value.
+
+// Append the encoding of `count` values to `out`.
+void encodeDeltaBlock(const std::int64_t* values, std::size_t count, std::vector<std::uint8_t>& out);
+
+// Decode `count` values from the bytes in [in, end) into `out`.
+// Decoding runs in two passes so that each pass is a simple loop: the varints are unpacked first
+// (eight single-byte varints at a time when no continuation bit is set), then the zig-zag mapping
+// is undone and the deltas are prefix-summed.
+// Returns a pointer past the consumed bytes, or nullptr if the input is truncated or malformed.
+const std::uint8_t* decodeDeltaBlock(const std::uint8_t* in, const std::uint8_t* end, std::size_t count,
+                                     std::int64_t* out);
+
+#endif // DELTA_CODEC_H
@@ -1,24 +1,139 @@
 #ifndef HISTORICAL_DATA_LOADER_H
 #define HISTORICAL_DATA_LOADER_H
 
+#include <cstring>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "../data_processing/mapped_file.h"
+#include "../data_processing/tick_batch.h"
+
+// Forward range over the lines of a text buffer.
+// Each line is yielded as a std::string_view into the buffer (without the trailing '\n' or '\r'),
+// so iterating never copies the data. The views stay valid as long as the buffer does.
+class LineRange {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        iterator() = default;
+        iterator(const char* position, const char* end) : position_(position), end_(end) { advance(); }
+
+        reference operator*() const { return line_; }
+        pointer operator->() const { return &line_; }
+
+        iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator previous = *this;
+            advance();
+            return previous;
+        }
+
+        bool operator==(const iterator& other) const { return line_.data() == other.line_.data(); }
+
+    private:
+        // Move to the next line; an exhausted iterator has a null line pointer and compares equal to end().
+        void advance() {
+            if (position_ == end_) {
+                line_ = std::string_view();
+                return;
+            }
+            const void* newline = std::memchr(position_, '\n', static_cast<std::size_t>(end_ - position_));
+            const char* lineEnd = newline ? static_cast<const char*>(newline) : end_;
+            std::size_t length = static_cast<std::size_t>(lineEnd - position_);
+            if (length > 0 && position_[length - 1] == '\r') {
+                --length;
+            }
+            line_ = std::string_view(position_, length);
+            position_ = newline ? lineEnd + 1 : end_;
+        }
+
+        const char* position_ = nullptr;
+        const char* end_ = nullptr;
+        std::string_view line_;
+    };
+
+    explicit LineRange(std::string_view text) : text_(text) {}
+
+    iterator begin() const { return iterator(text_.data(), text_.data() + text_.size()); }
+    iterator end() const { return iterator(); }
+
+private:
+    std::string_view text_;
+};
 
 // The HistoricalDataLoader class is responsible for loading historical market data from a file.
 // This data will be used for backtesting strategies on past market conditions.
 class HistoricalDataLoader {
 public:
+    // How the file contents are brought into memory.
+    enum class LoadMode {
+        Buffered,  // Read the file into a heap buffer
+        Mapped     // Map the file and parse it in place (zero copy)
+    };
+
     // Constructor that initializes the loader with a file name.
     // The file should contain historical data for backtesting.
-    HistoricalDataLoader(const std::string& fileName);
+    // In mapped mode the kernel is told the file is read sequentially; `hugePages` additionally
+    // requests transparent huge pages for the mapping.
+    HistoricalDataLoader(const std::string& fileName, LoadMode mode = LoadMode::Mapped, bool hugePages = false);
 
     // Method to load data from the file.
     // The data is returned as a vector of strings, where each string represents a line from the file.
     std::vector<std::string> loadData();
 
+    // Method to load the file straight into typed columns.
+    // Binary tick store files (see tick_store.h) are recognized by their magic bytes and read
+    // through a mapping; only the columns selected by `columns` are read, the others are left zero.
+    // CSV text is tokenized with the vectorized CsvTokenizer, which always fills every column.
+    // Returns the number of ticks loaded.
+    std::size_t loadBatch(TickBatch& batch, TickColumnMask columns = kAllTickColumns);
+
+    // Method to load only the ticks with timestamps in [start, end).
+    // If `instruments` is not empty, only ticks of those instruments are kept; invalid ids select none.
+    // Tick stores are searched with their built-in time index. CSV files are mapped and searched
+    // with a sparse sidecar index (see time_index.h), which is built on first use and saved next to
+    // the file, so only the part of the file covering the range is parsed.
+    // Returns the number of ticks loaded.
+    std::size_t loadRange(TickBatch& batch, std::int64_t start, std::int64_t end,
+                          const std::vector<InstrumentId>& instruments = {},
+                          TickColumnMask columns = kAllTickColumns);
+
+    // Check whether the file is a binary tick store rather than CSV text.
+    bool isTickStore() const;
+
+    // Map the file and return its lines as string views over the mapping.
+    // The views remain valid for the lifetime of the loader.
+    LineRange lines();
+
 private:
+    // Map the file on first use and return the mapping.
+    const MappedFile& mapping();
+
+    // Remove rows appended after `first` that fall outside [start, end) or the instrument set.
+    static void filterRange(TickBatch& batch, std::size_t first, std::int64_t start, std::int64_t end,
+                            const std::vector<InstrumentId>& instruments);
+
     // Name of the file containing the historical data.
     std::string fileName_;
+
+    // Selected load mode and huge page preference.
+    LoadMode mode_;
+    bool hugePages_;
+
+    // Mapping of the file, created lazily.
+    std::unique_ptr<MappedFile> mapping_;
 };
 
 #endif // HISTORICAL_DATA_LOADER_H
@@ -0,0 +1,158 @@
+#ifndef TICK_STORE_H
+#define TICK_STORE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../config/settings.h"
+#include "../data_processing/mapped_file.h"
+#include "../data_processing/tick_batch.h"
+
+// Binary columnar tick store.
+//
+// File layout (little endian, every section aligned to 64 bytes):
+//   TickStoreHeader                      fixed 64-byte header
+//   TickStoreColumn[header.columnCount]  one descriptor per column
+//   column blocks                        one block per column, raw or compressed (see TickStoreEncoding)
+//   TickStoreIndexEntry[indexCount]      sparse time index, one entry every `indexStride` rows
+//
+// Rows are ordered by timestamp, so the time index can be binary searched to find the first row
+// at or after a given time. Each column can be read on its own; with the file mapped, columns
+// that are never touched are never read from disk.
+//
+// A compressed column starts with a directory of (blockCount + 1) uint64 offsets, relative to the
+// start of the column, followed by independently decodable delta/varint blocks of `blockRows`
+// rows (see delta_codec.h). Prices are stored as integers scaled by 10^priceDecimals.
+
+// Magic bytes at the start of every tick store file.
+constexpr std::array<char, 8> kTickStoreMagic = {'H', 'F', 'T', 'T', 'I', 'C', 'K', 'S'};
+
+// Current format version.
+constexpr std::uint32_t kTickStoreVersion = 1;
+
+// Fixed file header.
+struct TickStoreHeader {
+    std::array<char, 8> magic;      // kTickStoreMagic
+    std::uint32_t version;          // kTickStoreVersion
+    std::uint32_t columnCount;      // Number of column descriptors
+    std::uint64_t rowCount;         // Number of rows in every column
+    std::uint64_t indexOffset;      // File offset of the time index
+    std::uint64_t indexCount;       // Number of time index entries
+    std::uint32_t indexStride;      // Rows between consecutive index entries
+    std::uint32_t reserved;
+    std::int64_t firstTimestamp;    // Timestamp of the first row
+    std::int64_t lastTimestamp;     // Timestamp of the last row
+};
+static_assert(sizeof(TickStoreHeader) == 64, "TickStoreHeader must stay 64 bytes");
+
+// Encoding of a column block.
+enum class TickStoreEncoding : std::uint32_t {
+    Raw = 0,         // Plain little-endian values
+    DeltaVarint = 1  // Blocks of delta + zig-zag + varint encoded integers
+};
+
+// Descriptor of one column block.
+struct TickStoreColumn {
+    std::uint32_t column;         // TickColumn identifier
+    std::uint32_t encoding;       // TickStoreEncoding of the block
+    std::uint64_t offset;         // File offset of the column block
+    std::uint64_t bytes;          // Size of the column block in bytes
+    std::uint32_t blockRows;      // Rows per compressed block (0 for raw columns)
+    std::uint32_t priceDecimals;  // Decimal scale of compressed price columns
+};
+static_assert(sizeof(TickStoreColumn) == 32, "TickStoreColumn must stay 32 bytes");
+
+// One entry of the sparse time index.
+struct TickStoreIndexEntry {
+    std::int64_t timestamp;  // Timestamp of the indexed row
+    std::uint64_t row;       // Row number
+};
+
+// Options that control how a tick store is written.
+struct TickStoreOptions {
+    std::uint32_t indexStride = config::TIME_INDEX_STRIDE;             // Rows per time index entry
+    bool compressed = config::TICK_STORE_COMPRESSION;                  // Use delta/varint encoded columns
+    std::uint32_t blockRows = config::TICK_STORE_BLOCK_ROWS;           // Rows per compressed block
+    std::uint32_t priceDecimals = config::TICK_STORE_PRICE_DECIMALS;   // Price precision kept when compressed
+};
+
+// The TickStoreWriter class writes a TickBatch to a tick store file.
+class TickStoreWriter {
+public:
+    // Write the batch to the given file.
+    // Compression is lossy for prices: they are rounded to `priceDecimals` decimal places. A price
+    // column that cannot be scaled to integers (NaN, infinite or too large) is written raw instead.
+    // Throws std::runtime_error if the file cannot be written or the rows are not ordered by time.
+    static void write(const std::string& fileName, const TickBatch& batch, const TickStoreOptions& options = {});
+};
+
+// The TickStoreReader class maps a tick store file and gives access to its columns.
+// Column spans point directly into the mapping and stay valid for the lifetime of the reader.
+class TickStoreReader {
+public:
+    // Constructor that maps and validates the file.
+    // Throws std::runtime_error if the file is not a valid tick store.
+    explicit TickStoreReader(const std::string& fileName);
+
+    // Check whether a buffer starts with the tick store magic bytes.
+    static bool isTickStore(std::string_view contents);
+
+    // Number of rows in the store.
+    std::size_t rowCount() const { return static_cast<std::size_t>(header_.rowCount); }
+
+    // File header.
+    const TickStoreHeader& header() const { return header_; }
+
+    // Sparse time index.
+    std::span<const TickStoreIndexEntry> timeIndex() const { return index_; }
+
+    // First row whose timestamp is not less than `timestamp`.
+    std::size_t lowerBound(std::int64_t timestamp) const;
+
+    // Copy rows [begin, end) of the selected columns into the batch.
+    // Columns outside the mask are left zero. Returns the number of rows appended.
+    std::size_t read(TickBatch& batch, TickColumnMask columns = kAllTickColumns, std::size_t begin = 0,
+                     std::size_t end = static_cast<std::size_t>(-1)) const;
+
+    // Check whether a column is stored compressed.
+    bool isCompressed(TickColumn column) const {
+        return columns_[static_cast<std::size_t>(column)].encoding == TickStoreEncoding::DeltaVarint;
+    }
+
+    // Zero-copy access to a raw column. The element type must match the column type.
+    // Compressed columns cannot be viewed in place and return an empty span; use read() instead.
+    template <typename T>
+    std::span<const T> column(TickColumn column) const {
+        const auto& block = columns_[static_cast<std::size_t>(column)];
+        const bool viewable = block.data && block.encoding == TickStoreEncoding::Raw;
+        return std::span<const T>(reinterpret_cast<const T*>(block.data), viewable ? rowCount() : 0);
+    }
+
+private:
+    // Location and encoding of a column inside the mapping.
+    struct ColumnBlock {
+        const char* data = nullptr;
+        std::uint64_t bytes = 0;
+        TickStoreEncoding encoding = TickStoreEncoding::Raw;
+        std::uint32_t blockRows = 0;
+        std::uint32_t priceDecimals = 0;
+    };
+
+    // Decode rows [begin, end) of a compressed column as scaled integers.
+    void decode(const ColumnBlock& block, std::size_t begin, std::size_t end, std::int64_t* out) const;
+
+    // Timestamps of rows [begin, end), decoding them if the column is compressed.
+    std::span<const std::int64_t> timestamps(std::size_t begin, std::size_t end,
+                                             std::vector<std::int64_t>& scratch) const;
+
+    MappedFile file_;
+    TickStoreHeader header_{};
+    std::array<ColumnBlock, static_cast<std::size_t>(TickColumn::Count)> columns_{};
+    std::span<const TickStoreIndexEntry> index_;
+};
+
+#endif // TICK_STORE_H
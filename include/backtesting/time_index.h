@@ -0,0 +1,56 @@
+#ifndef TIME_INDEX_H
+#define TIME_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// The TimeIndex class is a sparse time index over a CSV history file.
+// It records the timestamp and byte offset of every `stride`-th data row, so that a time range
+// can be mapped to a byte range of the file without scanning it. The rows must be ordered by time.
+//
+// The index is built once and saved next to the data file (same name plus ".idx"). It is rebuilt
+// automatically when the data file changes size or modification time.
+class TimeIndex {
+public:
+    // One index entry.
+    struct Entry {
+        std::int64_t timestamp;  // Timestamp of the indexed row
+        std::uint64_t offset;    // Byte offset of the start of the row
+    };
+
+    // Load the sidecar index of a data file, or build and save it if it is missing or stale.
+    // `text` is the full contents of the data file.
+    // Throws std::runtime_error if the rows are not ordered by time.
+    static TimeIndex loadOrBuild(const std::string& dataFileName, std::string_view text, std::uint32_t stride);
+
+    // Build an index over CSV text. Throws std::runtime_error if the rows are not ordered by time.
+    static TimeIndex build(std::string_view text, std::uint32_t stride);
+
+    // Byte range [first, last) of the file that contains every row with a timestamp in [start, end).
+    // The range may also contain some rows outside the time range, which callers filter out.
+    std::pair<std::size_t, std::size_t> byteRange(std::int64_t start, std::int64_t end) const;
+
+    // Index entries.
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    // Name of the sidecar file for a data file.
+    static std::string indexFileName(const std::string& dataFileName);
+
+private:
+    // Write the index to the sidecar file, tagged with the data file's size and modification time.
+    void save(const std::string& indexFileName, std::uint64_t dataSize, std::int64_t dataModified) const;
+
+    // Read a sidecar file. Returns false if it is missing, corrupt or describes a different data file.
+    bool load(const std::string& indexFileName, std::uint64_t dataSize, std::int64_t dataModified);
+
+    std::uint32_t stride_ = 0;
+    std::size_t dataBegin_ = 0;  // Offset of the first data row
+    std::size_t dataEnd_ = 0;    // Size of the indexed text
+    std::vector<Entry> entries_;
+};
+
+#endif // TIME_INDEX_H
@@ -1,12 +1,25 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include "config/settings.h"
 
 // Общие типы данных, используемые в проекте
 using DataPoint = std::string;  // Пример типа данных
 
+// Плотный числовой идентификатор инструмента (см. InstrumentRegistry).
+// Состояние по инструментам хранится в массивах, индексируемых этим идентификатором.
+using InstrumentId = std::uint32_t;
+constexpr InstrumentId kInvalidInstrument = UINT32_MAX;  // Инструмент не найден
+
+// Проверка идентификатора перед индексацией массива по инструментам: kInvalidInstrument и идентификаторы
+// не меньше config::MAX_INSTRUMENTS (их справочник не выдаёт) отвергаются.
+inline bool isValidInstrument(InstrumentId id) {
+    return id < config::MAX_INSTRUMENTS;
+}
+
 // Вспомогательные функции
 inline std::string formatData(const std::string& data) {
     return "Formatted: " + data;
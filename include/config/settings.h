@@ -8,9 +8,67 @@ namespace config {
 // Путь к файлу с историческими данными
 const std::string HISTORICAL_DATA_FILE = "data/historical_data.csv";
 
+// Путь к файлу справочных данных по инструментам (symbol,tick_size,lot_size)
+const std::string REFERENCE_DATA_FILE = "data/instruments.csv";
+const unsigned MAX_INSTRUMENTS = 1 << 16;  // Максимум инструментов в справочнике; граница массивов по идентификатору
+
+// Настройки бинарного хранилища тиков
+const unsigned TIME_INDEX_STRIDE = 65536;        // Строк между записями временного индекса (CSV и бинарный формат)
+const bool TICK_STORE_COMPRESSION = true;        // Дельта/varint сжатие колонок
+const unsigned TICK_STORE_BLOCK_ROWS = 4096;     // Строк в независимо декодируемом блоке
+const unsigned TICK_STORE_PRICE_DECIMALS = 6;    // Точность цен при сжатии (знаков после запятой); сжатие цен с потерями
+
+// Настройки приёма рыночных данных
+const int FEED_HANDLER_CPU = -1;                        // Ядро для потока приёма (-1 — без привязки)
+const unsigned FEED_RING_CAPACITY = 65536;              // Ёмкость кольцевого буфера тиков
+const int FEED_SOCKET_BUFFER_SIZE = 8 * 1024 * 1024;    // Размер приёмного буфера сокета (байт)
+const std::string FEED_MULTICAST_INTERFACE = "0.0.0.0"; // Интерфейс для подписки на multicast
+const unsigned FEED_RECEIVE_BATCH = 64;                 // Датаграмм за один вызов recvmmsg
+const unsigned FEED_DATAGRAM_SIZE = 2048;               // Максимальный размер датаграммы в пакетном режиме (байт)
+const int FEED_BUSY_POLL_MICROS = 50;                   // SO_BUSY_POLL для режима активного опроса (мкс)
+const int FEED_RECEIVE_TIMEOUT_MICROS = 1000;           // Таймаут блокирующего приёма (мкс)
+const unsigned FEED_REORDER_WINDOW = 8;                 // Пакетов за пропуском до объявления разрыва последовательности
+const unsigned FEED_MAX_BUFFERED_PACKETS = 65536;       // Максимум буферизованных пакетов на канал
+const unsigned FEED_ARBITRATION_WINDOW = 16384;         // Окно дедупликации A/B линий (сообщений)
+const unsigned CAPTURE_WRITE_BUFFER = 1 << 20;          // Буфер записи файла захвата рыночных данных (байт)
+const unsigned CAPTURE_WRITE_BUFFERS = 4;               // Буферов записи в очереди к потоку записи файла захвата
+const long long CAPTURE_SPIN_NANOS = 50000;             // Активное ожидание перед датаграммой при воспроизведении с таймингом (нс)
+
+// Настройки стакана заявок
+const double DEFAULT_TICK_SIZE = 0.01;     // Шаг цены по умолчанию
+const unsigned L2_BOOK_LEVELS = 1024;      // Ценовых уровней на сторону в окне стакана (кратно 64)
+const unsigned L3_BOOK_MAX_ORDERS = 1 << 20;  // Заявок в пуле L3 стакана
+const unsigned L3_BOOK_MAX_LEVELS = 1 << 16;  // Ценовых уровней в пуле L3 стакана
+
+// Настройки параллельной обработки данных
+const unsigned DATA_PROCESSOR_SHARDS = 4;            // Потоков обработки (инструменты делятся по id)
+const unsigned DATA_PROCESSOR_SHARD_QUEUE = 65536;   // Ёмкость входной очереди шарда (тиков)
+const int DATA_PROCESSOR_FIRST_CPU = -1;             // Ядро первого шарда, остальные на следующих (-1 — без привязки)
+
+// Настройки агрегации баров
+const long long BAR_INTERVAL_NANOS = 60LL * 1000000000LL;  // Длительность временного бара по умолчанию (нс)
+
+// Настройки часов (TSC)
+const bool TSC_CLOCK_ENABLED = true;            // Использовать TSC, если он инвариантный (иначе clock_gettime)
+const int TSC_CALIBRATION_MILLIS = 10;          // Длительность начальной калибровки TSC (мс)
+const int TSC_DRIFT_CORRECTION_MILLIS = 1000;   // Период коррекции дрейфа TSC относительно системных часов (мс)
+
 // Настройки стратегий
-const int SCALPING_STRATEGY_THRESHOLD = 5;
+const unsigned CONFLATION_MAX_INSTRUMENTS = 4096;  // Инструментов в буфере сжатия для медленных стратегий
+const unsigned MULTICAST_RING_CAPACITY = 1024;     // Пакетов тиков в общем кольце стратегий (режим Multicast)
+const unsigned MULTICAST_RING_MAX_CONSUMERS = 64;  // Максимум читателей общего кольца
+const unsigned ORDER_CHANNEL_CAPACITY = 1024;      // Заявок (и исполнений) в канале между стратегией и маршрутизатором
+const unsigned BACKTEST_SLICE_ROWS = 256;          // Строк истории между маршрутизациями заявок в бэктесте
+const bool INDICATORS_USE_AVX2 = true;             // Считать индикаторы ядрами AVX2, если процессор их поддерживает
+const int SCALPING_STRATEGY_THRESHOLD = 5;         // Максимальный спред для входа скальпинга (тиков)
+const int SCALPING_IMBALANCE_PERCENT = 60;         // Перекос объёмов лучших цен для входа ((bid - ask) / (bid + ask), %)
+const int SCALPING_TAKE_PROFIT_TICKS = 2;          // Прибыль, при которой позиция закрывается (тиков)
+const int SCALPING_STOP_LOSS_TICKS = 3;            // Убыток, при котором позиция закрывается (тиков)
+const long long SCALPING_ORDER_QUANTITY = 1;       // Размер позиции скальпинга
 const int MEAN_REVERSION_STRATEGY_PERIOD = 20;
+const double MEAN_REVERSION_ENTRY_ZSCORE = 2.0;    // Отклонение цены от среднего (в σ) для открытия позиции
+const double MEAN_REVERSION_EXIT_ZSCORE = 0.5;     // Отклонение, ниже которого позиция закрывается
+const long long MEAN_REVERSION_ORDER_QUANTITY = 1; // Размер позиции стратегии возврата к среднему
 
 // Другие параметры
 const double MAX_DRAWDOWN_LIMIT = 0.2;  // 20%
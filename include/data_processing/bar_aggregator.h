@@ -0,0 +1,148 @@
+#ifndef BAR_AGGREGATOR_H
+#define BAR_AGGREGATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "tick_batch.h"
+#include "../config/settings.h"
+
+// One OHLCV bar of an instrument.
+struct Bar {
+    InstrumentId instrumentId = 0;
+    std::int64_t openTime = 0;    // Start of the bar (time bars: start of the interval; others: first trade)
+    std::int64_t closeTime = 0;   // End of the bar (time bars: end of the interval; others: last trade)
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    std::int64_t volume = 0;      // Traded quantity
+    double dollarVolume = 0.0;    // Traded notional (price * quantity)
+    std::uint32_t tickCount = 0;  // Number of trades
+
+    // Volume-weighted average price of the bar.
+    double vwap() const { return volume > 0 ? dollarVolume / static_cast<double>(volume) : close; }
+};
+
+// How bars are delimited.
+enum class BarType {
+    Time,    // Fixed, epoch-aligned time intervals; threshold in nanoseconds
+    Tick,    // A fixed number of trades
+    Volume,  // A traded quantity
+    Dollar   // A traded notional
+};
+
+// The BarAggregator class builds OHLCV bars from a stream of trades, for any number of instruments at once.
+// Each instrument has one open bar, stored in a flat array indexed by instrument id, so a trade costs a
+// constant amount of work. A bar is emitted through the callback as soon as it is complete:
+// - count, volume and dollar bars are emitted on the trade that reaches the threshold (trades are not
+//   split across bars);
+// - time bars are emitted on the first trade past the end of their interval, or by closeExpired() when
+//   a timer sees the interval end first. Intervals without trades produce no bar.
+//
+// The callback is a template parameter, `emit(const Bar&)`, so it is inlined into the update loop.
+class BarAggregator {
+public:
+    // Constructor that sets the kind of bar and its threshold (see BarType).
+    explicit BarAggregator(BarType type = BarType::Time, double threshold = static_cast<double>(config::BAR_INTERVAL_NANOS));
+
+    // Add one trade. Trades of an invalid instrument id (see isValidInstrument()) are ignored.
+    template <typename Emit>
+    void addTrade(InstrumentId instrumentId, std::int64_t timestamp, double price, std::int64_t quantity, Emit&& emit) {
+        if (!isValidInstrument(instrumentId)) {
+            return;
+        }
+        Bar& bar = openBar(instrumentId);
+        if (bar.tickCount != 0 && type_ == BarType::Time && timestamp >= bar.closeTime) {
+            emit(static_cast<const Bar&>(bar));
+            bar.tickCount = 0;
+        }
+
+        const double notional = price * static_cast<double>(quantity);
+        if (bar.tickCount == 0) {
+            start(bar, instrumentId, timestamp, price);
+        } else {
+            bar.high = price > bar.high ? price : bar.high;
+            bar.low = price < bar.low ? price : bar.low;
+        }
+        bar.close = price;
+        bar.volume += quantity;
+        bar.dollarVolume += notional;
+        ++bar.tickCount;
+        if (type_ != BarType::Time) {
+            bar.closeTime = timestamp;
+            if (complete(bar)) {
+                emit(static_cast<const Bar&>(bar));
+                bar.tickCount = 0;
+            }
+        }
+    }
+
+    // Add the trades of a processed batch (rows with a positive trade price and quantity).
+    template <typename Emit>
+    void addBatch(const TickBatch& batch, Emit&& emit) {
+        const auto ids = batch.instrumentIds();
+        const auto timestamps = batch.timestamps();
+        const auto prices = batch.tradePrices();
+        const auto quantities = batch.tradeQuantities();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            if (prices[i] > 0.0 && quantities[i] > 0) {
+                addTrade(ids[i], timestamps[i], prices[i], quantities[i], emit);
+            }
+        }
+    }
+
+    // Emit the time bars whose interval ended at or before `now`.
+    template <typename Emit>
+    void closeExpired(std::int64_t now, Emit&& emit) {
+        if (type_ != BarType::Time) {
+            return;
+        }
+        for (Bar& bar : bars_) {
+            if (bar.tickCount != 0 && bar.closeTime <= now) {
+                emit(static_cast<const Bar&>(bar));
+                bar.tickCount = 0;
+            }
+        }
+    }
+
+    // Emit every open bar, complete or not, e.g. at the end of a replay.
+    template <typename Emit>
+    void flush(Emit&& emit) {
+        for (Bar& bar : bars_) {
+            if (bar.tickCount != 0) {
+                emit(static_cast<const Bar&>(bar));
+                bar.tickCount = 0;
+            }
+        }
+    }
+
+    // Bar currently being built for an instrument (nullptr if it has no trade yet).
+    const Bar* current(InstrumentId instrumentId) const;
+
+    // Kind of bar and its threshold.
+    BarType type() const { return type_; }
+    double threshold() const { return threshold_; }
+
+private:
+    // Open bar of an instrument, growing the array the first time the instrument is seen. The id must be valid.
+    Bar& openBar(InstrumentId instrumentId) {
+        if (instrumentId >= bars_.size()) {
+            bars_.resize(instrumentId + 1);
+        }
+        return bars_[instrumentId];
+    }
+
+    // Start a new bar with its first trade.
+    void start(Bar& bar, InstrumentId instrumentId, std::int64_t timestamp, double price) const;
+
+    // Check whether a count, volume or dollar bar has reached the threshold.
+    bool complete(const Bar& bar) const;
+
+    BarType type_;
+    double threshold_;
+    std::int64_t interval_;  // Length of time bars in nanoseconds
+    std::vector<Bar> bars_;  // Open bar per instrument id (tickCount == 0 means none)
+};
+
+#endif // BAR_AGGREGATOR_H
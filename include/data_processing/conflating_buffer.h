@@ -0,0 +1,142 @@
+#ifndef CONFLATING_BUFFER_H
+#define CONFLATING_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include "tick_batch.h"
+#include "../config/settings.h"
+
+// The ConflatingBuffer class hands the latest market state of each instrument from one producer thread
+// to one consumer thread, with bounded memory however far the consumer falls behind.
+// There is one slot per instrument id. A publish overwrites the instrument's slot and sets its bit in a
+// dirty bitmap. A drain visits only the dirty instruments and clears their bits. A consumer that keeps up
+// sees every update, and a slow one sees only the most recent state of each instrument that changed.
+//
+// Slots are written under a sequence lock: the producer never waits, and the consumer retries the
+// rare read that overlaps a write.
+class ConflatingBuffer {
+public:
+    // Constructor that allocates a slot for every instrument id below `maxInstruments`.
+    explicit ConflatingBuffer(std::size_t maxInstruments = config::CONFLATION_MAX_INSTRUMENTS)
+        : words_((maxInstruments + 63) / 64),
+          slots_(std::make_unique<Slot[]>(words_ * 64)),
+          dirty_(std::make_unique<std::atomic<std::uint64_t>[]>(words_)) {
+        for (std::size_t i = 0; i < words_; ++i) {
+            dirty_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ConflatingBuffer(const ConflatingBuffer&) = delete;
+    ConflatingBuffer& operator=(const ConflatingBuffer&) = delete;
+
+    // Producer: replace the state of the tick's instrument. Returns false, and counts the update as
+    // dropped, if the id is out of range.
+    bool publish(const Tick& tick) {
+        const std::size_t id = tick.instrumentId;
+        if (id >= words_ * 64) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Slot& slot = slots_[id];
+        const auto words = std::bit_cast<std::array<std::uint64_t, kWords>>(tick);
+
+        const std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);  // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+
+        const std::uint64_t bit = std::uint64_t{1} << (id % 64);
+        if (dirty_[id / 64].fetch_or(bit, std::memory_order_release) & bit) {
+            conflated_.fetch_add(1, std::memory_order_relaxed);
+        }
+        published_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer: hand the latest state of every instrument updated since the last drain to `consumer`,
+    // as a `const Tick&`, in instrument id order. Returns the number of instruments delivered.
+    template <typename Consumer>
+    std::size_t drain(Consumer&& consumer) {
+        std::size_t delivered = 0;
+        for (std::size_t word = 0; word < words_; ++word) {
+            if (dirty_[word].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            for (std::uint64_t bits = dirty_[word].exchange(0, std::memory_order_acquire); bits != 0; bits &= bits - 1) {
+                consumer(static_cast<const Tick&>(read(slots_[word * 64 + std::countr_zero(bits)])));
+                ++delivered;
+            }
+        }
+        return delivered;
+    }
+
+    // Check whether any instrument has an update that was not drained yet.
+    bool pending() const {
+        for (std::size_t word = 0; word < words_; ++word) {
+            if (dirty_[word].load(std::memory_order_relaxed) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Number of instrument ids the buffer can hold.
+    std::size_t capacity() const { return words_ * 64; }
+
+    // Number of updates published.
+    std::uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+
+    // Number of updates overwritten before the consumer saw them.
+    std::uint64_t conflated() const { return conflated_.load(std::memory_order_relaxed); }
+
+    // Number of updates rejected because their instrument id is beyond the capacity.
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(Tick) + 7) / 8;
+
+    // Ticks are stored as their bit pattern, split into whole words.
+    static_assert(std::is_trivially_copyable_v<Tick>, "Tick must be trivially copyable");
+    static_assert(sizeof(Tick) == kWords * sizeof(std::uint64_t), "Tick must be a whole number of words");
+
+    // State of one instrument: the tick as atomic words, guarded by a sequence number.
+    struct alignas(64) Slot {
+        std::atomic<std::uint32_t> sequence{0};
+        std::array<std::atomic<std::uint64_t>, kWords> words{};
+    };
+
+    // Read a consistent copy of a slot, retrying while a write is in progress or overlapped the read.
+    static Tick read(const Slot& slot) {
+        std::array<std::uint64_t, kWords> words;
+        while (true) {
+            const std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before % 2 == 0) {
+                for (std::size_t i = 0; i < kWords; ++i) {
+                    words[i] = slot.words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+        }
+        return std::bit_cast<Tick>(words);
+    }
+
+    std::size_t words_;                                   // Number of 64-bit words in the dirty bitmap
+    std::unique_ptr<Slot[]> slots_;                       // Indexed by instrument id
+    std::unique_ptr<std::atomic<std::uint64_t>[]> dirty_; // Bit set: the slot changed since the last drain
+    std::atomic<std::uint64_t> published_{0};
+    std::atomic<std::uint64_t> conflated_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+#endif // CONFLATING_BUFFER_H
@@ -1,34 +1,228 @@
 #ifndef DATA_COLLECTOR_H
 #define DATA_COLLECTOR_H
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
+#include "market_capture.h"
+#include "snapshot_source.h"
+#include "spsc_ring.h"
+#include "tick_batch.h"
 
-// The DataCollector class is responsible for collecting data from a specified source.
-// It allows starting and stopping the data collection process and checks if the collection is active.
+// The DataCollector class is the market-data feed handler.
+// It receives UDP datagrams from the source, decodes the binary ITCH-style messages they carry
+// (see itch_protocol.h) on a dedicated receive thread, and publishes quotes and trades as typed ticks
+// into a lock-free single-producer ring.
+// Consumers drain the ring, e.g. with DataProcessor::drain(), and hand the batch to the strategies.
+//
+// The source has the form "udp://<address>:<port>". A multicast group address (224.0.0.0/4) is joined
+// on config::FEED_MULTICAST_INTERFACE; any other address is bound as a unicast listener
+// (e.g. "udp://127.0.0.1:0" for a local publisher, where port 0 picks a free port).
+//
+// Two redundant sources (the A and B legs of the same feed) can be given. They are received on the
+// same thread and merged per channel by a FeedArbitrator: the first copy of each message wins and the
+// copy from the other leg is dropped. Per-leg statistics show which leg tends to be faster.
+//
+// Packets are sequenced per channel. A SequenceTracker per channel drops duplicates and reorders
+// packets that arrive out of order. A hole that outlives the reordering window is a gap. If a snapshot
+// source is set, it is asked for the channel's snapshot on a helper thread while live packets keep
+// being buffered. The snapshot is published once it arrives, and the buffered packets are replayed
+// after it. Without a snapshot source the missing messages are counted as lost and the feed continues.
+//
+// Every published tick carries the time it was received. In the batched modes this is the kernel's
+// software receive timestamp (SO_TIMESTAMPING), so the time a datagram waited in the socket queue
+// is reported separately (kernelQueueTime()) from the time spent in our own code. Times taken in user
+// space come from TscClock, the time base shared by the rest of the pipeline.
+//
+// With a capture recorder set, every received datagram is also appended to a capture file with its receive
+// timestamp and leg. A CaptureReplayer plays such a file back through inject(), so an incident can be
+// reproduced with the same packets, in the same order and, if wanted, with the same timing.
 class DataCollector {
 public:
+    // How datagrams are pulled from the socket.
+    enum class ReceiveMode {
+        Blocking,  // One blocking recv() per datagram; the receive time is taken in user space
+        Batched,   // recvmmsg() waits for the first datagram and returns up to FEED_RECEIVE_BATCH at once
+        BusyPoll   // Non-blocking recvmmsg() in a spin loop with SO_BUSY_POLL; burns a core for the lowest latency
+    };
+
     // Constructor to initialize the data source.
-    // The source parameter represents the origin of the data (e.g., market feed or external API).
-    DataCollector(const std::string& source);
+    // The source parameter is the UDP endpoint of the market feed.
+    DataCollector(const std::string& source, ReceiveMode mode = ReceiveMode::Batched);
+
+    // Constructor for the A and B legs of a redundant feed.
+    DataCollector(const std::string& sourceA, const std::string& sourceB, ReceiveMode mode = ReceiveMode::Batched);
+
+    // Stops the receive thread if it is still running.
+    ~DataCollector();
+
+    DataCollector(const DataCollector&) = delete;
+    DataCollector& operator=(const DataCollector&) = delete;
 
     // Start collecting data from the specified source.
-    // This method activates the data collection process.
+    // Opens the socket and starts the receive thread, pinned to config::FEED_HANDLER_CPU when it is set.
+    // Throws std::runtime_error if the source is malformed or the socket cannot be opened.
     void startCollection();
 
     // Stop collecting data.
-    // This method deactivates the data collection process.
+    // Wakes up and joins the receive thread and closes the socket.
     void stopCollection();
 
     // Check if the data collection is currently active.
     // Returns true if the data collection is in progress, false otherwise.
     bool isCollecting() const;
 
+    // Set the service used to recover channels after a sequence gap. Must be called before startCollection().
+    void setSnapshotSource(std::shared_ptr<SnapshotSource> source);
+
+    // Set the recorder every received datagram is written to (nullptr to stop recording).
+    // Must be called before startCollection(). The recorder is flushed when collection stops.
+    void setCaptureRecorder(std::shared_ptr<CaptureRecorder> recorder);
+
+    // Process a datagram as if it had been received on a leg at the given time, e.g. one replayed from a
+    // capture file. Must not be called while the collector is collecting. A leg the collector does not
+    // have is treated as leg A.
+    void inject(const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp, std::size_t leg = 0);
+
+    // Ring the decoded ticks are published to. Only one thread may consume from it.
+    SpscRing<Tick>& ticks() { return ring_; }
+
+    // Local UDP port a leg is bound to (0 until collection starts).
+    std::uint16_t port(std::size_t leg = 0) const { return legs_[leg].port; }
+
+    // Number of datagrams received.
+    std::uint64_t datagramsReceived() const { return datagrams_.load(std::memory_order_relaxed); }
+
+    // Number of datagrams dropped because they were longer than config::FEED_DATAGRAM_SIZE (batched
+    // receive modes only). They are not counted in datagramsReceived().
+    std::uint64_t truncatedDatagrams() const { return truncated_.load(std::memory_order_relaxed); }
+
+    // Number of messages decoded.
+    std::uint64_t messagesDecoded() const { return messages_.load(std::memory_order_relaxed); }
+
+    // Number of truncated messages or messages of an unknown type.
+    std::uint64_t malformedMessages() const { return malformed_.load(std::memory_order_relaxed); }
+
+    // Number of ticks published to the ring.
+    std::uint64_t ticksPublished() const { return published_.load(std::memory_order_relaxed); }
+
+    // Number of ticks dropped because the ring was full.
+    std::uint64_t ticksDropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Number of receive system calls that returned data. Compare with datagramsReceived() to see the batching.
+    std::uint64_t receiveCalls() const { return receiveCalls_.load(std::memory_order_relaxed); }
+
+    // Number of datagrams that carried a kernel receive timestamp.
+    std::uint64_t timestampedDatagrams() const { return timestamped_.load(std::memory_order_relaxed); }
+
+    // Total time, in nanoseconds, that timestamped datagrams waited in the kernel between arrival
+    // and being returned to the receive thread.
+    std::uint64_t kernelQueueTime() const { return kernelQueueNanos_.load(std::memory_order_relaxed); }
+
+    // Number of sequence gaps detected across all channels.
+    std::uint64_t sequenceGaps() const { return gaps_.load(std::memory_order_relaxed); }
+
+    // Number of completed snapshot recoveries.
+    std::uint64_t recoveries() const { return recoveries_.load(std::memory_order_relaxed); }
+
+    // Number of duplicate packets dropped.
+    std::uint64_t duplicatePackets() const { return duplicates_.load(std::memory_order_relaxed); }
+
+    // Number of messages given up on because a gap could not be recovered.
+    std::uint64_t lostMessages() const { return lost_.load(std::memory_order_relaxed); }
+
+    // Number of packets a leg delivered before the other one (A/B feeds only).
+    std::uint64_t legWins(std::size_t leg) const { return legWins_[leg].load(std::memory_order_relaxed); }
+
+    // Total time, in nanoseconds, by which a leg was ahead of the other one on the packets it won.
+    std::uint64_t legLeadTime(std::size_t leg) const { return legLead_[leg].load(std::memory_order_relaxed); }
+
+    // Number of packets dropped because the other leg had already delivered them.
+    std::uint64_t arbitratedDuplicates() const { return arbitrated_.load(std::memory_order_relaxed); }
+
+    // Receive mode of this collector.
+    ReceiveMode receiveMode() const { return mode_; }
+
 private:
-    // Data source (e.g., a market feed or file).
-    std::string source_;  
+    // One source of the feed and its socket.
+    struct Leg {
+        std::string source;
+        int socket = -1;
+        std::uint16_t port = 0;
+    };
+
+    // Open and bind the socket described by the leg's source, joining the multicast group if needed.
+    void openSocket(Leg& leg);
+
+    // Close the sockets of all legs.
+    void closeSockets();
+
+    // Enable kernel receive timestamps and, in busy-poll mode, SO_BUSY_POLL on the socket.
+    void configureSocket(int socket);
+
+    // Wait until at least one leg has data. Returns a bitmask of the legs worth reading.
+    std::uint32_t waitReadable() const;
+
+    // Body of the receive thread in Blocking mode.
+    void receiveBlocking();
+
+    // Body of the receive thread in Batched and BusyPoll modes.
+    void receiveBatched();
+
+    // Arbitrate and sequence one datagram received on a leg.
+    void onDatagram(const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp, std::size_t leg);
+
+    // Decode framed messages, skipping the first `skip`, and publish the resulting ticks.
+    void publish(const std::uint8_t* data, std::size_t size, std::size_t skip, std::int64_t receiveTimestamp);
+
+    // Sequencing state of one channel.
+    struct ChannelState;
+
+    // State of a channel, created on its first packet.
+    ChannelState& channel(std::uint16_t id);
+
+    // React to a gap: start a snapshot recovery, or skip the missing messages if there is no snapshot source.
+    void handleGap(std::uint16_t id);
+
+    // Apply the snapshots that have arrived and replay the packets buffered behind them.
+    void pollRecoveries();
+
+    // Data sources: a single feed, or the A and B legs of a redundant feed.
+    std::vector<Leg> legs_;
 
     // Flag indicating whether data collection is currently active.
-    bool collecting_;      
+    std::atomic<bool> collecting_;
+
+    ReceiveMode mode_;
+    std::thread receiver_;
+    SpscRing<Tick> ring_;
+    std::shared_ptr<SnapshotSource> snapshots_;
+    std::shared_ptr<CaptureRecorder> recorder_;
+    std::vector<std::unique_ptr<ChannelState>> channels_;  // Indexed by channel id, used by the receive thread only
+    std::vector<std::uint16_t> recovering_;                // Channels waiting for a snapshot
+
+    // Feed statistics, written by the receive thread only.
+    std::atomic<std::uint64_t> datagrams_{0};
+    std::atomic<std::uint64_t> truncated_{0};
+    std::atomic<std::uint64_t> messages_{0};
+    std::atomic<std::uint64_t> malformed_{0};
+    std::atomic<std::uint64_t> published_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> receiveCalls_{0};
+    std::atomic<std::uint64_t> timestamped_{0};
+    std::atomic<std::uint64_t> kernelQueueNanos_{0};
+    std::atomic<std::uint64_t> gaps_{0};
+    std::atomic<std::uint64_t> recoveries_{0};
+    std::atomic<std::uint64_t> duplicates_{0};
+    std::atomic<std::uint64_t> lost_{0};
+    std::atomic<std::uint64_t> arbitrated_{0};
+    std::array<std::atomic<std::uint64_t>, 2> legWins_{};
+    std::array<std::atomic<std::uint64_t>, 2> legLead_{};
 };
 
 #endif // DATA_COLLECTOR_H
@@ -3,23 +3,78 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include "l2_book.h"
+#include "latency_stats.h"
+#include "spsc_ring.h"
+#include "tick_batch.h"
+#include "../config/settings.h"
 
 // The DataProcessor class is responsible for processing raw data collected by the DataCollector.
-// It provides functionality to filter and transform the raw data into a usable format.
+// It turns raw records into a typed TickBatch and then filters and transforms that batch in place.
+// Processed quotes are also applied to the per-instrument L2 books, so the books always reflect
+// the last batch that went through process().
+// Ticks that carry a receive timestamp also feed a receive-to-processed latency measurement, taken with
+// TscClock like the timestamp itself.
 class DataProcessor {
 public:
-    // Process raw data and return processed results.
-    // The input is a vector of raw strings, and the output is a vector of processed strings.
-    std::vector<std::string> process(const std::vector<std::string>& rawData);
+    // Columns process() reads: the filter, the quote forward-fill and the books need the instrument, the
+    // quotes and the trade. Loaders must always load them, whatever the strategies ask for.
+    static constexpr TickColumnMask kRequiredColumns =
+        tickColumnBit(TickColumn::Timestamp) | tickColumnBit(TickColumn::InstrumentId) |
+        tickColumnBit(TickColumn::BidPrice) | tickColumnBit(TickColumn::AskPrice) |
+        tickColumnBit(TickColumn::BidSize) | tickColumnBit(TickColumn::AskSize) |
+        tickColumnBit(TickColumn::TradePrice) | tickColumnBit(TickColumn::TradeQuantity);
+
+    // Parse raw "timestamp,price,volume" text records and append them to the batch.
+    // Header lines and records that cannot be parsed are skipped.
+    // Returns the number of records that were appended.
+    std::size_t fill(const std::vector<std::string>& rawData, TickBatch& batch);
+
+    // Process a batch of ticks in place.
+    // Invalid ticks are removed first, then the remaining ticks are normalized and applied to the books.
+    void process(TickBatch& batch);
+
+    // Move up to `maxTicks` ticks published by the feed handler from the ring into the batch
+    // (which is cleared first) and process them. Must be called from the ring's only consumer thread.
+    // Returns the number of ticks taken from the ring.
+    std::size_t drain(SpscRing<Tick>& ring, TickBatch& batch, std::size_t maxTicks = config::FEED_RING_CAPACITY);
+
+    // Order books of all instruments, as updated by process().
+    const L2BookSet& books() const { return books_; }
+    L2BookSet& books() { return books_; }
+
+    // Time from receipt (Tick::receiveTimestamp) to the end of process(), over every processed tick that
+    // carried a receive timestamp.
+    const LatencyStats& latency() const { return latency_; }
 
 private:
-    // Helper function to filter raw data.
-    // This could include logic such as removing invalid data points.
-    std::string filterData(const std::string& data);
+    // Helper function to filter the batch.
+    // Removes ticks with non-positive or non-finite prices, negative quantities, crossed quotes or an
+    // invalid instrument id (see isValidInstrument()), compacting the surviving rows to the front of every column.
+    void filterData(TickBatch& batch);
+
+    // Helper function to transform the batch.
+    // Forward-fills missing bid/ask quotes from the previous tick of the same instrument,
+    // seeding them from the trade price when the instrument has not been quoted yet.
+    void transformData(TickBatch& batch);
+
+    // Record the receive-to-processed latency of the batch's ticks.
+    void recordLatency(const TickBatch& batch);
+
+    // Parse a single raw record into a tick. Returns false if the record is not valid data.
+    static bool parseRecord(std::string_view record, Tick& tick);
+
+    // Last known quote per instrument, indexed by instrument id.
+    // Carried across batches so forward-filling works on streamed data.
+    std::vector<double> lastBid_;
+    std::vector<double> lastAsk_;
+
+    // L2 book per instrument.
+    L2BookSet books_;
 
-    // Helper function to transform the data.
-    // This could include logic for normalizing, formatting, or converting the data.
-    std::string transformData(const std::string& data);
+    // Receive-to-processed latency.
+    LatencyStats latency_;
 };
 
 #endif // DATA_PROCESSOR_H
@@ -0,0 +1,60 @@
+#ifndef FEED_ARBITRATOR_H
+#define FEED_ARBITRATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../config/settings.h"
+
+// The FeedArbitrator class merges the A and B legs of a redundant feed channel by sequence number.
+// The first copy of every message wins and later copies are dropped. A sliding bitmap remembers
+// which of the last `window` sequence numbers have been seen, so each check is a couple of bit
+// operations. Anything older than the window is treated as already seen.
+//
+// For every message it also records which leg delivered it first and at what time. When the copy on the
+// other leg arrives, the difference is credited to the faster leg. This shows how far ahead each leg
+// runs on average.
+class FeedArbitrator {
+public:
+    // Outcome of offering a packet to the arbitrator.
+    struct Result {
+        bool accepted = false;   // The packet carries at least one message not seen on either leg
+        std::int64_t lead = 0;   // For a late copy: how long the other leg was ahead, in nanoseconds
+    };
+
+    // Constructor that sets the window size in messages (rounded up to a multiple of 64).
+    explicit FeedArbitrator(std::size_t window = config::FEED_ARBITRATION_WINDOW);
+
+    // Offer a packet of `count` messages starting at `sequence`, received on `leg` (0 = A, 1 = B).
+    // Heartbeats (count 0) are always accepted.
+    Result accept(std::size_t leg, std::uint64_t sequence, std::uint16_t count, std::int64_t receiveTimestamp);
+
+    // Number of packets delivered first by a leg.
+    std::uint64_t wins(std::size_t leg) const { return wins_[leg]; }
+
+    // Total time, in nanoseconds, by which a leg was ahead of the other one on the packets it won.
+    std::uint64_t leadTime(std::size_t leg) const { return leadTime_[leg]; }
+
+    // Number of late copies dropped.
+    std::uint64_t duplicates() const { return duplicates_; }
+
+private:
+    // Slide the window forward so that it ends just after `sequence`, forgetting what falls out of it.
+    void advance(std::uint64_t sequence);
+
+    // Check and set the bit of a sequence number inside the window. Returns true if it was already set.
+    bool testAndSet(std::uint64_t sequence);
+
+    std::size_t window_;
+    std::uint64_t end_ = 0;                   // One past the highest sequence number seen
+    std::vector<std::uint64_t> seen_;         // One bit per sequence number, indexed modulo the window
+    std::vector<std::int64_t> arrival_;       // Receive time of the first copy, per sequence number
+    std::vector<std::uint8_t> firstLeg_;      // Leg of the first copy, per sequence number
+
+    std::array<std::uint64_t, 2> wins_{};
+    std::array<std::uint64_t, 2> leadTime_{};
+    std::uint64_t duplicates_ = 0;
+};
+
+#endif // FEED_ARBITRATOR_H
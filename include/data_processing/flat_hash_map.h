@@ -0,0 +1,118 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Default hash of FlatHashMap: Fibonacci hashing of a 64-bit key.
+// The high bits of the product are well mixed, so the map uses them as the slot index.
+struct FlatHash {
+    std::uint64_t operator()(std::uint64_t key) const { return key * 0x9E3779B97F4A7C15ULL; }
+};
+
+// The FlatHashMap class maps keys to 32-bit indices (e.g. into a node pool) with open addressing.
+// All slots are allocated up front for a fixed maximum number of entries, and the table is kept at
+// most half full, so lookups are a short linear probe through one contiguous array. Erasing shifts
+// the following entries back instead of leaving tombstones, so probes do not get longer over time.
+// After construction the map never allocates.
+template <typename Key, typename Hash = FlatHash>
+class FlatHashMap {
+public:
+    // Value returned by find() for a missing key.
+    static constexpr std::uint32_t kMissing = UINT32_MAX;
+
+    // Constructor that allocates room for `maxEntries` entries.
+    explicit FlatHashMap(std::size_t maxEntries)
+        : slots_(std::bit_ceil(maxEntries * 2 < 2 ? std::size_t{2} : maxEntries * 2)),
+          mask_(slots_.size() - 1),
+          shift_(64 - std::countr_zero(slots_.size())),
+          maxEntries_(maxEntries) {}
+
+    // Value stored for a key, or kMissing.
+    std::uint32_t find(const Key& key) const {
+        for (std::size_t slot = home(key);; slot = (slot + 1) & mask_) {
+            if (slots_[slot].value == kMissing) {
+                return kMissing;
+            }
+            if (slots_[slot].key == key) {
+                return slots_[slot].value;
+            }
+        }
+    }
+
+    // Insert a new key. Returns false if the key is already present or the map is full.
+    bool insert(const Key& key, std::uint32_t value) {
+        if (size_ == maxEntries_) {
+            return false;
+        }
+        std::size_t slot = home(key);
+        for (; slots_[slot].value != kMissing; slot = (slot + 1) & mask_) {
+            if (slots_[slot].key == key) {
+                return false;
+            }
+        }
+        slots_[slot] = Slot{key, value};
+        ++size_;
+        return true;
+    }
+
+    // Remove a key. Returns false if it was not present.
+    bool erase(const Key& key) {
+        std::size_t slot = home(key);
+        for (; !(slots_[slot].key == key); slot = (slot + 1) & mask_) {
+            if (slots_[slot].value == kMissing) {
+                return false;
+            }
+        }
+        if (slots_[slot].value == kMissing) {
+            return false;  // An empty slot that happens to hold the key's bytes
+        }
+
+        // Backward-shift deletion: move every later entry of the probe run that may live in the hole.
+        std::size_t hole = slot;
+        for (std::size_t next = (hole + 1) & mask_; slots_[next].value != kMissing; next = (next + 1) & mask_) {
+            const std::size_t wanted = home(slots_[next].key);
+            const bool movable = hole <= next ? (wanted <= hole || wanted > next) : (wanted <= hole && wanted > next);
+            if (movable) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+        }
+        slots_[hole].value = kMissing;
+        --size_;
+        return true;
+    }
+
+    // Remove every entry.
+    void clear() {
+        for (Slot& slot : slots_) {
+            slot.value = kMissing;
+        }
+        size_ = 0;
+    }
+
+    // Number of entries.
+    std::size_t size() const { return size_; }
+
+    // Maximum number of entries.
+    std::size_t capacity() const { return maxEntries_; }
+
+private:
+    struct Slot {
+        Key key{};
+        std::uint32_t value = kMissing;
+    };
+
+    // Preferred slot of a key.
+    std::size_t home(const Key& key) const { return static_cast<std::size_t>(Hash{}(key) >> shift_) & mask_; }
+
+    std::vector<Slot> slots_;
+    std::size_t mask_;
+    int shift_;
+    std::size_t maxEntries_;
+    std::size_t size_ = 0;
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -0,0 +1,72 @@
+#ifndef INSTRUMENT_REGISTRY_H
+#define INSTRUMENT_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../common.h"
+#include "../config/settings.h"
+
+// Reference data of one instrument.
+struct InstrumentInfo {
+    std::string symbol;
+    double tickSize = config::DEFAULT_TICK_SIZE;  // Minimum price increment
+    std::int64_t lotSize = 1;                     // Minimum order quantity increment
+};
+
+// The InstrumentRegistry class maps instrument symbols to dense InstrumentId values (0, 1, 2, ...)
+// and holds the reference data of each instrument.
+// Symbols are resolved once, at the boundary (loading reference data, parsing a request); everything
+// downstream carries the id and keeps its per-instrument state in plain arrays indexed by it.
+//
+// The reference-data file is a CSV file with the columns "symbol,tick_size,lot_size" (the header line
+// is optional and the last two columns may be omitted). It is memory-mapped and parsed in place.
+// Ids are assigned in file order.
+class InstrumentRegistry {
+public:
+    // Constructor for an empty registry.
+    InstrumentRegistry() = default;
+
+    // Constructor that loads a reference-data file.
+    // Throws std::runtime_error if the file cannot be read or contains a malformed or duplicate line.
+    explicit InstrumentRegistry(const std::string& fileName);
+
+    // Load a reference-data file, adding its instruments after the ones already registered.
+    void load(const std::string& fileName);
+
+    // Register an instrument. Throws std::runtime_error if the symbol is already registered or the
+    // registry already holds config::MAX_INSTRUMENTS instruments.
+    InstrumentId add(const InstrumentInfo& info);
+
+    // Id of a symbol, registering it with default reference data if it is new.
+    // Throws std::runtime_error if a new symbol does not fit into the registry.
+    InstrumentId intern(std::string_view symbol);
+
+    // Id of a symbol, or kInvalidInstrument if it is not registered.
+    InstrumentId find(std::string_view symbol) const;
+
+    // Reference data of an instrument. The id must be valid.
+    const InstrumentInfo& info(InstrumentId id) const { return instruments_[id]; }
+
+    // Symbol of an instrument. The id must be valid.
+    const std::string& symbol(InstrumentId id) const { return instruments_[id].symbol; }
+
+    // Number of registered instruments; valid ids are [0, size()).
+    std::size_t size() const { return instruments_.size(); }
+
+private:
+    // Hash that accepts both std::string and std::string_view, so lookups do not build a string.
+    struct SymbolHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view symbol) const { return std::hash<std::string_view>{}(symbol); }
+    };
+
+    std::vector<InstrumentInfo> instruments_;  // Indexed by id
+    std::unordered_map<std::string, InstrumentId, SymbolHash, std::equal_to<>> ids_;
+};
+
+#endif // INSTRUMENT_REGISTRY_H
@@ -0,0 +1,94 @@
+#ifndef ITCH_DECODER_H
+#define ITCH_DECODER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "itch_protocol.h"
+
+// The ItchDecoder class decodes binary ITCH-style messages (see itch_protocol.h) and hands each one,
+// as its packed struct, to the handler.
+//
+// Dispatch by message type goes through a 256-entry table of function pointers generated at compile
+// time from the list of message types, so decoding a message is one bounds check, one indexed call and
+// a fixed-size copy: no virtual calls, no branching on the type and no text parsing.
+// The handler only implements `onMessage(const itch::X&)` for the messages it cares about; the others
+// are still validated and skipped. Unknown message types are counted and skipped.
+template <typename Handler>
+class ItchDecoder {
+public:
+    // Constructor that binds the decoder to a handler.
+    explicit ItchDecoder(Handler& handler) : handler_(handler) {}
+
+    // Decode a single unframed message. Returns false if the type is unknown or the message is truncated.
+    bool decodeMessage(const std::uint8_t* data, std::size_t length) {
+        if (length == 0) {
+            return false;
+        }
+        return kTable[data[0]](handler_, data, length);
+    }
+
+    // Decode a buffer of length-framed messages. Decoding stops at a truncated frame.
+    // Returns the number of messages that were dispatched.
+    std::size_t decode(const std::uint8_t* data, std::size_t size) {
+        std::size_t decoded = 0;
+        std::size_t position = 0;
+        while (position + 2 <= size) {
+            const std::size_t length = (static_cast<std::size_t>(data[position]) << 8) | data[position + 1];
+            position += 2;
+            if (length > size - position) {
+                ++malformed_;
+                break;
+            }
+            if (decodeMessage(data + position, length)) {
+                ++decoded;
+            } else {
+                ++malformed_;
+            }
+            position += length;
+        }
+        return decoded;
+    }
+
+    // Number of frames that were truncated or had an unknown message type.
+    std::uint64_t malformed() const { return malformed_; }
+
+private:
+    using Entry = bool (*)(Handler&, const std::uint8_t*, std::size_t);
+
+    // Copy the message out of the buffer and pass it to the handler, if the handler wants it.
+    template <typename Message>
+    static bool dispatch(Handler& handler, const std::uint8_t* data, std::size_t length) {
+        if (length < sizeof(Message)) {
+            return false;
+        }
+        if constexpr (requires(Handler& h, const Message& m) { h.onMessage(m); }) {
+            Message message;
+            std::memcpy(&message, data, sizeof(Message));
+            handler.onMessage(message);
+        }
+        return true;
+    }
+
+    // Table entry for message types that are not part of the protocol.
+    static bool unknown(Handler&, const std::uint8_t*, std::size_t) { return false; }
+
+    // Build the dispatch table: every slot points at `unknown` except those of the listed messages.
+    template <typename... Messages>
+    static constexpr std::array<Entry, 256> makeTable() {
+        std::array<Entry, 256> table{};
+        table.fill(&unknown);
+        ((table[static_cast<unsigned char>(Messages::kType)] = &dispatch<Messages>), ...);
+        return table;
+    }
+
+    static constexpr std::array<Entry, 256> kTable =
+        makeTable<itch::SystemEvent, itch::Quote, itch::AddOrder, itch::OrderExecuted, itch::OrderCancel,
+                  itch::OrderDelete, itch::OrderReplace, itch::Trade>();
+
+    Handler& handler_;
+    std::uint64_t malformed_ = 0;
+};
+
+#endif // ITCH_DECODER_H
@@ -0,0 +1,202 @@
+#ifndef ITCH_PROTOCOL_H
+#define ITCH_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Binary market-data protocol in the style of NASDAQ ITCH.
+// Every message is a packed struct of big-endian fields starting with a one-byte message type.
+// On the wire, messages are framed by a two-byte big-endian length followed by the message bytes.
+// A datagram (packet) starts with a PacketHeader, in the style of MoldUDP64, followed by
+// `messageCount` framed messages. Every message of a channel consumes one sequence number.
+//
+// Prices are signed fixed-point integers with kPriceScale units per currency unit.
+// Timestamps are nanoseconds since the Unix epoch. The instrument is identified by the numeric
+// locate code of the header, which is used directly as the instrument id.
+namespace itch {
+
+// Fixed-point scale of price fields (4 implied decimal places, as in ITCH).
+constexpr std::int64_t kPriceScale = 10000;
+
+// An unaligned big-endian integer field.
+template <typename T>
+struct BigEndian {
+    static_assert(std::is_integral_v<T>, "BigEndian fields must be integers");
+
+    unsigned char bytes[sizeof(T)];
+
+    // Value of the field in host byte order.
+    T value() const {
+        std::make_unsigned_t<T> raw;
+        std::memcpy(&raw, bytes, sizeof(T));
+        if constexpr (sizeof(T) == 2) {
+            raw = __builtin_bswap16(raw);
+        } else if constexpr (sizeof(T) == 4) {
+            raw = __builtin_bswap32(raw);
+        } else if constexpr (sizeof(T) == 8) {
+            raw = __builtin_bswap64(raw);
+        }
+        return static_cast<T>(raw);
+    }
+
+    // Store a host-order value.
+    void set(T value) {
+        auto raw = static_cast<std::make_unsigned_t<T>>(value);
+        if constexpr (sizeof(T) == 2) {
+            raw = __builtin_bswap16(raw);
+        } else if constexpr (sizeof(T) == 4) {
+            raw = __builtin_bswap32(raw);
+        } else if constexpr (sizeof(T) == 8) {
+            raw = __builtin_bswap64(raw);
+        }
+        std::memcpy(bytes, &raw, sizeof(T));
+    }
+};
+
+#pragma pack(push, 1)
+
+// Header of every packet.
+// A packet with no messages is a heartbeat that announces the next sequence number of the channel.
+struct PacketHeader {
+    BigEndian<std::uint16_t> channel;       // Channel (partition) of the feed
+    BigEndian<std::uint64_t> sequence;      // Sequence number of the first message in the packet
+    BigEndian<std::uint16_t> messageCount;  // Number of messages in the packet
+};
+
+// Fields shared by every message.
+struct Header {
+    char type;                            // Message type
+    BigEndian<std::uint16_t> locate;      // Instrument locate code (instrument id)
+    BigEndian<std::uint16_t> tracking;    // Matching engine tracking number
+    BigEndian<std::int64_t> timestamp;    // Nanoseconds since the Unix epoch
+};
+
+// 'S': start/end of the trading session and similar system events.
+struct SystemEvent {
+    static constexpr char kType = 'S';
+    Header header;
+    char eventCode;  // 'O' start of messages, 'C' end of messages
+};
+
+// 'Q': best bid and offer of an instrument.
+struct Quote {
+    static constexpr char kType = 'Q';
+    Header header;
+    BigEndian<std::int64_t> bidPrice;
+    BigEndian<std::uint32_t> bidSize;
+    BigEndian<std::int64_t> askPrice;
+    BigEndian<std::uint32_t> askSize;
+};
+
+// 'A': a new order was added to the book.
+struct AddOrder {
+    static constexpr char kType = 'A';
+    Header header;
+    BigEndian<std::uint64_t> orderReference;
+    char side;  // 'B' buy, 'S' sell
+    BigEndian<std::uint32_t> shares;
+    BigEndian<std::int64_t> price;
+};
+
+// 'E': part or all of a resting order was executed.
+struct OrderExecuted {
+    static constexpr char kType = 'E';
+    Header header;
+    BigEndian<std::uint64_t> orderReference;
+    BigEndian<std::uint32_t> executedShares;
+    BigEndian<std::uint64_t> matchNumber;
+};
+
+// 'X': part of a resting order was cancelled.
+struct OrderCancel {
+    static constexpr char kType = 'X';
+    Header header;
+    BigEndian<std::uint64_t> orderReference;
+    BigEndian<std::uint32_t> cancelledShares;
+};
+
+// 'D': a resting order was removed from the book.
+struct OrderDelete {
+    static constexpr char kType = 'D';
+    Header header;
+    BigEndian<std::uint64_t> orderReference;
+};
+
+// 'U': a resting order was replaced by a new order with a new reference, size and price.
+struct OrderReplace {
+    static constexpr char kType = 'U';
+    Header header;
+    BigEndian<std::uint64_t> originalOrderReference;
+    BigEndian<std::uint64_t> newOrderReference;
+    BigEndian<std::uint32_t> shares;
+    BigEndian<std::int64_t> price;
+};
+
+// 'P': a trade that did not affect the displayed book (e.g. against a hidden order).
+struct Trade {
+    static constexpr char kType = 'P';
+    Header header;
+    BigEndian<std::uint64_t> orderReference;
+    char side;
+    BigEndian<std::uint32_t> shares;
+    BigEndian<std::int64_t> price;
+    BigEndian<std::uint64_t> matchNumber;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(PacketHeader) == 12, "itch::PacketHeader must stay packed");
+static_assert(sizeof(Header) == 13, "itch::Header must stay packed");
+static_assert(sizeof(Quote) == 37, "itch::Quote must stay packed");
+static_assert(sizeof(AddOrder) == 34, "itch::AddOrder must stay packed");
+
+// Build a message header.
+inline Header makeHeader(char type, std::uint16_t locate, std::int64_t timestamp) {
+    Header header{};
+    header.type = type;
+    header.locate.set(locate);
+    header.timestamp.set(timestamp);
+    return header;
+}
+
+// Append one framed message (length prefix and body) to a datagram buffer.
+template <typename Message>
+void append(std::vector<std::uint8_t>& datagram, const Message& message) {
+    const std::size_t offset = datagram.size();
+    datagram.resize(offset + 2 + sizeof(Message));
+    datagram[offset] = static_cast<std::uint8_t>(sizeof(Message) >> 8);
+    datagram[offset + 1] = static_cast<std::uint8_t>(sizeof(Message) & 0xFF);
+    std::memcpy(datagram.data() + offset + 2, &message, sizeof(Message));
+}
+
+// Build a packet from a channel, the sequence number of its first message and its framed messages.
+inline std::vector<std::uint8_t> makePacket(std::uint16_t channel, std::uint64_t sequence, std::uint16_t messageCount,
+                                            const std::vector<std::uint8_t>& messages) {
+    PacketHeader header{};
+    header.channel.set(channel);
+    header.sequence.set(sequence);
+    header.messageCount.set(messageCount);
+
+    std::vector<std::uint8_t> packet(sizeof(header) + messages.size());
+    std::memcpy(packet.data(), &header, sizeof(header));
+    if (!messages.empty()) {
+        std::memcpy(packet.data() + sizeof(header), messages.data(), messages.size());
+    }
+    return packet;
+}
+
+// Byte offset just past the first `count` framed messages of a buffer (or its size, if it holds fewer).
+inline std::size_t skipMessages(const std::uint8_t* data, std::size_t size, std::size_t count) {
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < count && position + 2 <= size; ++i) {
+        position += 2 + ((static_cast<std::size_t>(data[position]) << 8) | data[position + 1]);
+    }
+    return position < size ? position : size;
+}
+
+} // namespace itch
+
+#endif // ITCH_PROTOCOL_H
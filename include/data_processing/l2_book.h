@@ -0,0 +1,143 @@
+#ifndef L2_BOOK_H
+#define L2_BOOK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "tick_batch.h"
+#include "../config/settings.h"
+
+// Side of the book.
+enum class Side : std::uint8_t {
+    Bid,
+    Ask
+};
+
+// The L2Book class is the price-level (L2) order book of one instrument.
+// Prices are integers in ticks. Each side is a fixed array of kLevels quantities indexed by the tick
+// offset from a shared anchor, plus a bitmap of the non-empty levels. An update is therefore one
+// array store and one bit flip, and the best price is found with a bit scan. Nothing is allocated
+// after construction, and a side fits in a few KB.
+//
+// The window [anchor, anchor + kLevels) follows the market. When an update falls outside it, the
+// anchor is moved so that the window is centred on the touch. Levels that drop out of the window
+// are discarded. An update too far from the touch to fit in the window is ignored and counted.
+class L2Book {
+public:
+    // Number of price levels per side. Must be a multiple of 64.
+    static constexpr std::size_t kLevels = config::L2_BOOK_LEVELS;
+    static_assert(kLevels % 64 == 0, "L2_BOOK_LEVELS must be a multiple of 64");
+
+    // One aggregated price level.
+    struct Level {
+        std::int64_t price = 0;     // Price in ticks
+        std::int64_t quantity = 0;  // Total quantity resting at the price
+    };
+
+    // Set the total quantity of a level. A quantity of zero (or less) removes the level.
+    void setLevel(Side side, std::int64_t price, std::int64_t quantity);
+
+    // Add a (possibly negative) quantity to a level; the level is removed when it reaches zero.
+    void addQuantity(Side side, std::int64_t price, std::int64_t delta);
+
+    // Apply a top-of-book update: the given prices are the new best bid and ask, so every bid above
+    // the bid price and every ask below the ask price is removed, as well as every level of the other
+    // side that the new price crosses. A zero price leaves that side alone.
+    void applyTopOfBook(std::int64_t bidPrice, std::int64_t bidQuantity, std::int64_t askPrice, std::int64_t askQuantity);
+
+    // Remove every level.
+    void clear();
+
+    // Check whether the side has at least one level.
+    bool hasBid() const { return bestBid_ >= 0; }
+    bool hasAsk() const { return bestAsk_ >= 0; }
+
+    // Best prices and their quantities (0 if the side is empty).
+    std::int64_t bestBid() const { return hasBid() ? anchor_ + bestBid_ : 0; }
+    std::int64_t bestAsk() const { return hasAsk() ? anchor_ + bestAsk_ : 0; }
+    std::int64_t bestBidQuantity() const { return hasBid() ? bids_.quantities[bestBid_] : 0; }
+    std::int64_t bestAskQuantity() const { return hasAsk() ? asks_.quantities[bestAsk_] : 0; }
+
+    // Quantity resting at a price (0 if there is none or the price is outside the window).
+    std::int64_t quantityAt(Side side, std::int64_t price) const;
+
+    // Copy up to out.size() levels of a side, best first. Returns the number of levels copied.
+    std::size_t depth(Side side, std::span<Level> out) const;
+
+    // Number of non-empty levels on a side.
+    std::size_t levelCount(Side side) const { return side == Side::Bid ? bids_.count : asks_.count; }
+
+    // Lowest price of the window.
+    std::int64_t anchor() const { return anchor_; }
+
+    // Number of updates ignored because they were too far from the touch.
+    std::uint64_t outOfRange() const { return outOfRange_; }
+
+private:
+    // Quantities and occupancy bitmap of one side, aligned to cache lines.
+    struct alignas(64) SideLevels {
+        std::array<std::int64_t, kLevels> quantities{};
+        std::array<std::uint64_t, kLevels / 64> occupied{};
+        std::size_t count = 0;
+    };
+
+    // Map a price to its index, moving the window if needed. Returns false if the price cannot fit.
+    bool locate(std::int64_t price, std::size_t& index);
+
+    // Move the anchor, carrying over the levels that stay inside the window.
+    void recenter(std::int64_t anchor);
+
+    // Store a quantity at an index and keep the bitmap, count and best index up to date.
+    void store(Side side, std::size_t index, std::int64_t quantity);
+
+    // Highest occupied index at or below `from` (-1 if none).
+    static std::ptrdiff_t highestAtOrBelow(const SideLevels& levels, std::ptrdiff_t from);
+
+    // Lowest occupied index at or above `from` (-1 if none).
+    static std::ptrdiff_t lowestAtOrAbove(const SideLevels& levels, std::ptrdiff_t from);
+
+    SideLevels bids_;
+    SideLevels asks_;
+    std::int64_t anchor_ = 0;
+    bool anchored_ = false;
+    std::ptrdiff_t bestBid_ = -1;  // Index of the best bid (-1 if none)
+    std::ptrdiff_t bestAsk_ = -1;  // Index of the best ask (-1 if none)
+    std::uint64_t outOfRange_ = 0;
+};
+
+// The L2BookSet class holds the L2 book of every instrument, indexed by instrument id,
+// and converts prices between currency units and ticks.
+class L2BookSet {
+public:
+    // Constructor that sets the tick size used to convert prices.
+    explicit L2BookSet(double tickSize = config::DEFAULT_TICK_SIZE);
+
+    // Book of an instrument, created on first use.
+    // Throws std::runtime_error if the id is invalid (see isValidInstrument()).
+    L2Book& book(InstrumentId instrumentId);
+
+    // Book of an instrument, or nullptr if it has never been updated.
+    const L2Book* find(InstrumentId instrumentId) const;
+
+    // Clear every book, keeping it allocated.
+    void clear();
+
+    // Apply the quotes of a batch: every row that carries quote sizes updates the top of its instrument's book.
+    void apply(const TickBatch& batch);
+
+    // Convert a price to ticks (rounded to the nearest tick) and back.
+    std::int64_t toTicks(double price) const;
+    double toPrice(std::int64_t ticks) const { return static_cast<double>(ticks) * tickSize_; }
+
+    // Tick size in currency units.
+    double tickSize() const { return tickSize_; }
+
+private:
+    double tickSize_;
+    std::vector<std::unique_ptr<L2Book>> books_;
+};
+
+#endif // L2_BOOK_H
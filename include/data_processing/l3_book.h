@@ -0,0 +1,169 @@
+#ifndef L3_BOOK_H
+#define L3_BOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "flat_hash_map.h"
+#include "itch_protocol.h"
+#include "l2_book.h"
+#include "../config/settings.h"
+
+// The L3Book class is the order-by-order (L3) book of all instruments of a feed.
+// It tracks every resting order by its exchange order reference, so it can answer questions an
+// aggregated book cannot, such as where one of our own orders sits in its price level's queue.
+//
+// Storage is allocated once, in the constructor:
+// - orders live in a pool of nodes, linked into an intrusive FIFO queue per price level;
+// - price levels live in a second pool;
+// - an open-addressing map finds an order by reference, and another finds a level by
+//   (instrument, side, price).
+// Adding, executing, cancelling and deleting an order are O(1) and never allocate. When a pool is
+// exhausted the message is rejected and counted.
+//
+// The L3Book also maintains an aggregated L2Book per instrument (aggregated()), so top-of-book and
+// depth queries stay O(1). Those books are created the first time an instrument is seen.
+//
+// Prices are in ticks. The L3Book is also an ItchDecoder handler: it applies the order messages of the
+// feed, converting ITCH fixed-point prices to ticks of the given tick size.
+class L3Book {
+public:
+    // A resting order.
+    struct Order {
+        std::uint64_t reference = 0;   // Exchange order reference
+        std::int64_t price = 0;        // Price in ticks
+        std::int64_t quantity = 0;     // Remaining quantity
+        InstrumentId instrumentId = 0;
+        std::uint32_t level = 0;       // Pool index of the price level
+        std::uint32_t previous = 0;    // Pool index of the order ahead in the queue (kNone if first)
+        std::uint32_t next = 0;        // Pool index of the order behind in the queue (kNone if last)
+        Side side = Side::Bid;
+        bool own = false;              // One of our own orders
+    };
+
+    // Position of an order in its price level's queue.
+    struct QueuePosition {
+        std::int64_t quantityAhead = 0;  // Quantity that must trade before the order does
+        std::uint32_t ordersAhead = 0;   // Number of orders ahead of it
+    };
+
+    // Constructor that sizes the pools and sets the tick size used for ITCH prices.
+    explicit L3Book(std::size_t maxOrders = config::L3_BOOK_MAX_ORDERS,
+                    std::size_t maxLevels = config::L3_BOOK_MAX_LEVELS,
+                    double tickSize = config::DEFAULT_TICK_SIZE);
+
+    // Add an order to the back of its price level's queue.
+    // Returns false if the reference is already in use, the instrument id is invalid or a pool is exhausted.
+    bool addOrder(std::uint64_t reference, InstrumentId instrumentId, Side side, std::int64_t price,
+                  std::int64_t quantity, bool own = false);
+
+    // Reduce an order by an executed or cancelled quantity. The order is removed when nothing is left.
+    // Returns false if the order is unknown or the quantity is not positive.
+    bool reduceOrder(std::uint64_t reference, std::int64_t quantity);
+
+    // Remove an order. Returns false if the order is unknown.
+    bool deleteOrder(std::uint64_t reference);
+
+    // Replace an order by a new one with a new reference, quantity and price. The new order goes to the
+    // back of the queue and keeps the instrument, side and ownership of the original one.
+    // Returns false, leaving the original order in place, if it is unknown, the new reference is already
+    // in use, the quantity is not positive or no price level is free for the new price.
+    bool replaceOrder(std::uint64_t reference, std::uint64_t newReference, std::int64_t quantity, std::int64_t price);
+
+    // Mark a resting order as one of our own, e.g. once the exchange has acknowledged it.
+    bool markOwn(std::uint64_t reference);
+
+    // Find an order by reference (nullptr if it is not resting).
+    const Order* find(std::uint64_t reference) const;
+
+    // Queue position of a resting order, by walking its level from the front.
+    std::optional<QueuePosition> queuePosition(std::uint64_t reference) const;
+
+    // Total quantity and number of orders resting at a price.
+    std::int64_t levelQuantity(InstrumentId instrumentId, Side side, std::int64_t price) const;
+    std::uint32_t levelOrders(InstrumentId instrumentId, Side side, std::int64_t price) const;
+
+    // Call `visit(const Order&)` for every order at a price, front of the queue first.
+    template <typename Visit>
+    void forEachOrder(InstrumentId instrumentId, Side side, std::int64_t price, Visit&& visit) const {
+        const std::uint32_t level = levels_.find(LevelKey{instrumentId, side, price});
+        if (level == kNone) {
+            return;
+        }
+        for (std::uint32_t order = levelPool_[level].head; order != kNone; order = orderPool_[order].next) {
+            visit(orderPool_[order]);
+        }
+    }
+
+    // Aggregated books of all instruments.
+    const L2BookSet& aggregated() const { return books_; }
+
+    // Number of resting orders.
+    std::size_t orderCount() const { return orders_.size(); }
+
+    // Number of messages rejected because a pool was full, a reference was reused or an order was unknown.
+    std::uint64_t rejected() const { return rejected_; }
+
+    // Remove every order and level.
+    void clear();
+
+    // ITCH message handlers.
+    void onMessage(const itch::AddOrder& message);
+    void onMessage(const itch::OrderExecuted& message);
+    void onMessage(const itch::OrderCancel& message);
+    void onMessage(const itch::OrderDelete& message);
+    void onMessage(const itch::OrderReplace& message);
+
+private:
+    // Index value for "no node".
+    static constexpr std::uint32_t kNone = UINT32_MAX;
+
+    // Identifies a price level.
+    struct LevelKey {
+        InstrumentId instrumentId = 0;
+        Side side = Side::Bid;
+        std::int64_t price = 0;
+
+        bool operator==(const LevelKey&) const = default;
+    };
+
+    // Hash of a level key: the fields are combined and then Fibonacci-hashed.
+    struct LevelHash {
+        std::uint64_t operator()(const LevelKey& key) const {
+            const std::uint64_t mixed = static_cast<std::uint64_t>(key.price) * 0xFF51AFD7ED558CCDULL ^
+                                        (static_cast<std::uint64_t>(key.instrumentId) << 1 | static_cast<std::uint64_t>(key.side));
+            return FlatHash{}(mixed);
+        }
+    };
+
+    // A price level: the FIFO queue of its orders and their total quantity.
+    struct Level {
+        LevelKey key;
+        std::int64_t quantity = 0;
+        std::uint32_t orders = 0;
+        std::uint32_t head = kNone;
+        std::uint32_t tail = kNone;  // Doubles as the free-list link while the level is unused
+    };
+
+    // Take a level from the pool, or find the existing one. Returns kNone if the pool is exhausted.
+    std::uint32_t acquireLevel(const LevelKey& key);
+
+    // Unlink an order from its level and return both to their pools.
+    void removeOrder(std::uint32_t order);
+
+    // Convert an ITCH fixed-point price to ticks.
+    std::int64_t toTicks(std::int64_t price) const;
+
+    std::vector<Order> orderPool_;
+    std::vector<Level> levelPool_;
+    std::uint32_t freeOrder_ = kNone;  // Head of the free list of order nodes, linked through `next`
+    std::uint32_t freeLevel_ = kNone;  // Head of the free list of levels, linked through `tail`
+    FlatHashMap<std::uint64_t> orders_;
+    FlatHashMap<LevelKey, LevelHash> levels_;
+    L2BookSet books_;
+    std::int64_t priceIncrement_;      // ITCH price units per tick
+    std::uint64_t rejected_ = 0;
+};
+
+#endif // L3_BOOK_H
@@ -0,0 +1,56 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// The MappedFile class maps a file read-only into memory.
+// The contents can be read in place through data()/view() without copying them into the heap;
+// pages are faulted in by the kernel on first access and can be dropped again under memory pressure.
+// The mapping is released when the object is destroyed.
+class MappedFile {
+public:
+    // Expected access pattern, forwarded to the kernel with madvise.
+    enum class AccessHint {
+        Normal,      // No particular pattern
+        Sequential,  // Read front to back once; enables aggressive read-ahead
+        Random       // Point lookups; disables read-ahead
+    };
+
+    // Constructor that maps the given file.
+    // Throws std::runtime_error if the file cannot be opened or mapped.
+    // If `hugePages` is set, the kernel is asked to back the mapping with transparent huge pages
+    // where the filesystem supports it.
+    explicit MappedFile(const std::string& fileName, AccessHint hint = AccessHint::Sequential, bool hugePages = false);
+
+    // Destructor that unmaps the file.
+    ~MappedFile();
+
+    // A mapping owns a unique resource and can be moved but not copied.
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Change the access pattern hint for the whole mapping.
+    void advise(AccessHint hint);
+
+    // Pointer to the first byte of the file (nullptr for an empty file).
+    const char* data() const { return data_; }
+
+    // Size of the file in bytes.
+    std::size_t size() const { return size_; }
+
+    // Contents of the file as a string view over the mapping.
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+private:
+    // Unmap the file if it is mapped.
+    void release();
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+#endif // MAPPED_FILE_H
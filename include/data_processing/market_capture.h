@@ -0,0 +1,203 @@
+#ifndef MARKET_CAPTURE_H
+#define MARKET_CAPTURE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mapped_file.h"
+#include "../config/settings.h"
+
+class DataCollector;
+
+// Binary layout of a market-data capture file.
+// The file starts with a FileHeader and is followed by one record per received datagram: a RecordHeader
+// and then the raw datagram bytes. Fields are in host byte order; captures are meant to be replayed on the
+// same kind of machine that recorded them.
+namespace capture {
+
+// Magic bytes at the start of every capture file.
+constexpr char kMagic[8] = {'H', 'F', 'T', 'C', 'A', 'P', 'T', '1'};
+
+// Header of a capture file.
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+};
+
+// Header of one captured datagram.
+struct RecordHeader {
+    std::int64_t receiveTimestamp;  // Receive time, in nanoseconds since the epoch
+    std::uint32_t size;             // Number of datagram bytes that follow
+    std::uint16_t leg;              // Feed leg the datagram arrived on (0 = A, 1 = B)
+    std::uint16_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 16, "Capture file header must be packed");
+static_assert(sizeof(RecordHeader) == 16, "Capture record header must be packed");
+
+// Current version of the format.
+constexpr std::uint32_t kVersion = 1;
+
+} // namespace capture
+
+// The CaptureRecorder class appends received datagrams to a capture file.
+// Records are gathered in buffers of config::CAPTURE_WRITE_BUFFER bytes. A full buffer is handed to a
+// writer thread, which writes it with one system call, while the receive thread goes on filling the next
+// of config::CAPTURE_WRITE_BUFFERS buffers; the receive thread only pays for a copy per datagram and never
+// waits for the disk. If the writer falls so far behind that every buffer is waiting to be written, new
+// records are dropped and counted as lost. An existing capture file is appended to; a file that is not a
+// capture is refused.
+// A recorder is used by one thread at a time (the receive thread of the DataCollector it is attached to).
+class CaptureRecorder {
+public:
+    // Constructor that opens (or creates) the capture file and starts the writer thread.
+    // Throws std::runtime_error if the file cannot be opened or is not a capture file.
+    explicit CaptureRecorder(const std::string& fileName);
+
+    // Destructor that writes the buffered records, stops the writer thread and closes the file.
+    ~CaptureRecorder();
+
+    CaptureRecorder(const CaptureRecorder&) = delete;
+    CaptureRecorder& operator=(const CaptureRecorder&) = delete;
+
+    // Append one datagram with the time it was received and the leg it arrived on.
+    // Never throws or blocks, since it runs on the receive thread: records that cannot be buffered or
+    // written are counted as lost.
+    void record(const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp, std::size_t leg);
+
+    // Hand the buffered records to the writer thread and wait until everything is written to the file.
+    // Throws std::runtime_error if a write failed since the last flush.
+    void flush();
+
+    // Number of datagrams written to the file.
+    std::uint64_t recorded() const { return recorded_.load(std::memory_order_acquire); }
+
+    // Number of datagrams lost because the file could not be written or the writer fell behind.
+    std::uint64_t lost() const { return lost_.load(std::memory_order_acquire); }
+
+    // Name of the capture file.
+    const std::string& fileName() const { return fileName_; }
+
+private:
+    // A buffer of records on its way to the file.
+    struct Buffer {
+        std::vector<std::uint8_t> data;
+        std::size_t used = 0;
+        std::uint64_t records = 0;
+    };
+
+    // Hand the current buffer to the writer thread, if it holds any records.
+    void handOff();
+
+    // Body of the writer thread: write the buffers in the order they were handed off.
+    void writeBuffers();
+
+    std::string fileName_;
+    int fd_ = -1;
+    std::vector<Buffer> buffers_;               // Used round-robin; buffer i % size() is the i-th handed off
+    std::atomic<std::uint64_t> handedOff_{0};   // Buffers handed to the writer (receive thread only)
+    std::atomic<std::uint64_t> written_{0};     // Buffers the writer is done with
+    std::atomic<std::uint64_t> posted_{0};      // Wake-ups of the writer: hand-offs and the stop
+    std::atomic<bool> running_{true};
+    std::atomic<std::uint64_t> recorded_{0};
+    std::atomic<std::uint64_t> lost_{0};
+    std::atomic<std::uint64_t> failedWrites_{0};
+    std::atomic<int> writeError_{0};            // errno of the last failed write
+    std::uint64_t reportedFailures_ = 0;        // failedWrites_ at the last flush
+    std::thread writer_;
+};
+
+// The CaptureReplayer class plays a capture file back.
+// The file is memory-mapped and every datagram is handed to a sink, in the order it was received, with its
+// original receive timestamp and leg. The replay runs either as fast as possible or at the recorded
+// inter-arrival timing, scaled by a speed multiplier, so bursts reach the pipeline with the same shape they
+// had in production. A record cut short at the end of the file (e.g. by a crash while recording) is ignored.
+class CaptureReplayer {
+public:
+    // Replay as fast as possible.
+    static constexpr double kAsFastAsPossible = 0.0;
+
+    // Constructor that maps the capture file.
+    // Throws std::runtime_error if the file cannot be opened or is not a capture file.
+    explicit CaptureReplayer(const std::string& fileName);
+
+    // Call `sink(const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp, std::size_t leg)`
+    // for every datagram and return the number of datagrams replayed.
+    // With `speed` > 0 each datagram is delivered when its offset from the first one, divided by `speed`,
+    // has elapsed since the replay started (1 = original timing, 2 = twice as fast). The wait sleeps until
+    // config::CAPTURE_SPIN_NANOS before the deadline and spins for the rest.
+    template <typename Sink>
+    std::size_t replay(Sink&& sink, double speed = kAsFastAsPossible) {
+        maxLag_ = 0;
+        const auto start = std::chrono::steady_clock::now();
+        std::int64_t first = 0;
+        std::size_t count = 0;
+        for (std::size_t offset = sizeof(capture::FileHeader); offset + sizeof(capture::RecordHeader) <= file_.size();) {
+            capture::RecordHeader header;
+            std::memcpy(&header, file_.data() + offset, sizeof(header));
+            const std::size_t payload = offset + sizeof(header);
+            if (header.size > file_.size() - payload) {
+                break;  // Truncated last record
+            }
+            if (count == 0) {
+                first = header.receiveTimestamp;
+            }
+            if (speed > 0.0) {
+                const auto due = start + std::chrono::nanoseconds(static_cast<std::int64_t>(
+                                             static_cast<double>(header.receiveTimestamp - first) / speed));
+                waitUntil(due);
+            }
+            sink(reinterpret_cast<const std::uint8_t*>(file_.data() + payload), static_cast<std::size_t>(header.size),
+                 header.receiveTimestamp, static_cast<std::size_t>(header.leg));
+            ++count;
+            offset = payload + header.size;
+        }
+        return count;
+    }
+
+    // Replay into a collector through DataCollector::inject(), so the datagrams go through the same
+    // arbitration, sequencing and decoding as live ones. The collector must not be collecting.
+    std::size_t replay(DataCollector& collector, double speed = kAsFastAsPossible);
+
+    // Number of complete datagrams in the file.
+    std::size_t datagrams() const { return datagrams_; }
+
+    // Receive timestamps of the first and last datagrams (0 for an empty capture).
+    std::int64_t firstTimestamp() const { return firstTimestamp_; }
+    std::int64_t lastTimestamp() const { return lastTimestamp_; }
+
+    // Largest delay, in nanoseconds, by which the last timed replay delivered a datagram after its due time.
+    // A large value means the sink could not keep up with the recorded rate.
+    std::int64_t maxLag() const { return maxLag_; }
+
+private:
+    // Sleep, then spin, until the deadline; record how late the deadline was already.
+    void waitUntil(std::chrono::steady_clock::time_point due) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= due) {
+            maxLag_ = std::max<std::int64_t>(maxLag_, std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count());
+            return;
+        }
+        const auto spin = std::chrono::nanoseconds(config::CAPTURE_SPIN_NANOS);
+        if (due - now > spin) {
+            std::this_thread::sleep_until(due - spin);
+        }
+        while (std::chrono::steady_clock::now() < due) {
+        }
+    }
+
+    MappedFile file_;
+    std::size_t datagrams_ = 0;
+    std::int64_t firstTimestamp_ = 0;
+    std::int64_t lastTimestamp_ = 0;
+    std::int64_t maxLag_ = 0;
+};
+
+#endif // MARKET_CAPTURE_H
@@ -0,0 +1,270 @@
+#ifndef MULTICAST_RING_H
+#define MULTICAST_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../config/settings.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// How a thread waits for the other side of a MulticastRing.
+enum class WaitStrategy {
+    BusySpin,  // Spin on the cursor; lowest latency, burns a core per waiting thread
+    Yield,     // Spin, giving the core away between checks
+    Block      // Sleep on the cursor (futex); cheapest when idle, adds a wake-up on the way
+};
+
+// The MulticastRing class is a bounded ring from one producer thread to several consumer threads, in the
+// style of the LMAX disruptor. Every consumer sees every value, in order, read in place from the same
+// slot: nothing is copied per consumer.
+//
+// Positions are sequence numbers that only grow. The producer claims a range of slots, fills them and
+// publishes the range by moving the published cursor. Each consumer has its own cursor, on its own cache
+// line, telling up to where it has finished reading. The producer only waits when the slowest consumer is
+// a whole ring behind, and it rescans the consumer cursors only when its cached view of them is exhausted.
+// Consumers never write shared state besides their own cursor, so adding a consumer costs the others
+// nothing.
+//
+// addConsumer() and removeConsumer() must be called from the producer thread. A consumer added while
+// values are flowing starts at the next value to be published.
+template <typename T>
+class MulticastRing {
+public:
+    using Sequence = std::size_t;
+
+    // Constructor that allocates the slots (rounded up to a power of two) and room for `maxConsumers` cursors.
+    explicit MulticastRing(std::size_t capacity, WaitStrategy wait = WaitStrategy::Block,
+                           std::size_t maxConsumers = config::MULTICAST_RING_MAX_CONSUMERS)
+        : slots_(roundUp(capacity)),
+          mask_(slots_.size() - 1),
+          wait_(wait),
+          consumers_(std::make_unique<Cursor[]>(maxConsumers)),
+          maxConsumers_(maxConsumers) {}
+
+    MulticastRing(const MulticastRing&) = delete;
+    MulticastRing& operator=(const MulticastRing&) = delete;
+
+    // Register a consumer and return its index. It will read from the next published value on.
+    // Throws std::runtime_error if all cursors are in use.
+    std::size_t addConsumer() {
+        for (std::size_t consumer = 0; consumer < maxConsumers_; ++consumer) {
+            Cursor& cursor = consumers_[consumer];
+            if (!cursor.active.load(std::memory_order_relaxed)) {
+                cursor.sequence.store(producer_.claimed, std::memory_order_relaxed);
+                cursor.active.store(true, std::memory_order_release);
+                consumerCount_ = std::max(consumerCount_, consumer + 1);
+                return consumer;
+            }
+        }
+        throw std::runtime_error("MulticastRing has no free consumer cursor");
+    }
+
+    // Unregister a consumer whose thread has stopped reading, so it no longer holds the producer back.
+    void removeConsumer(std::size_t consumer) {
+        consumers_[consumer].active.store(false, std::memory_order_release);
+    }
+
+    // Producer: claim `count` consecutive slots, waiting while the slowest consumer is still reading them.
+    // Returns the sequence of the first one; fill them through slot() and then publish().
+    Sequence claim(std::size_t count = 1) {
+        const Sequence first = producer_.claimed;
+        while (!hasRoom(first + count)) {
+            pause();
+        }
+        producer_.claimed = first + count;
+        return first;
+    }
+
+    // Producer: claim `count` slots if they are free right now. Returns false instead of waiting.
+    bool tryClaim(std::size_t count, Sequence& first) {
+        if (!hasRoom(producer_.claimed + count)) {
+            return false;
+        }
+        first = producer_.claimed;
+        producer_.claimed += count;
+        return true;
+    }
+
+    // Slot of a sequence. The producer writes claimed slots; consumers read published ones.
+    T& slot(Sequence sequence) { return slots_[sequence & mask_]; }
+    const T& slot(Sequence sequence) const { return slots_[sequence & mask_]; }
+
+    // Producer: make the claimed slots up to `first + count` visible to the consumers, in one store.
+    void publish(Sequence first, std::size_t count) {
+        published_.store(first + count, std::memory_order_release);
+        if (wait_ == WaitStrategy::Block) {
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_all();
+        }
+    }
+
+    // Consumer: wait for values, then call `handler(const T&, Sequence)` on up to `maxCount` of them in
+    // place and release their slots to the producer in one step.
+    // Returns the number of values handled; 0 once the ring is halted and the consumer has caught up.
+    template <typename Handler>
+    std::size_t consume(std::size_t consumer, Handler&& handler,
+                        std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+        Cursor& cursor = consumers_[consumer];
+        const Sequence next = cursor.sequence.load(std::memory_order_relaxed);
+        Sequence available = published_.load(std::memory_order_acquire);
+        for (std::size_t spins = 0; available == next; ++spins) {
+            if (halted_.load(std::memory_order_acquire)) {
+                available = published_.load(std::memory_order_acquire);
+                if (available == next) {
+                    return 0;
+                }
+                break;
+            }
+            if (wait_ == WaitStrategy::Block && spins >= kSpinsBeforeBlocking) {
+                const std::uint32_t seen = signal_.load(std::memory_order_acquire);
+                if (published_.load(std::memory_order_acquire) == next && !halted_.load(std::memory_order_acquire)) {
+                    signal_.wait(seen, std::memory_order_acquire);
+                }
+            } else {
+                pause();
+            }
+            available = published_.load(std::memory_order_acquire);
+        }
+        return handle(cursor, next, available, handler, maxCount);
+    }
+
+    // Consumer: like consume(), but returns 0 at once if nothing is available.
+    template <typename Handler>
+    std::size_t poll(std::size_t consumer, Handler&& handler,
+                     std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+        Cursor& cursor = consumers_[consumer];
+        const Sequence next = cursor.sequence.load(std::memory_order_relaxed);
+        return handle(cursor, next, published_.load(std::memory_order_acquire), handler, maxCount);
+    }
+
+    // Wait until every active consumer has read everything published so far.
+    void waitUntilConsumed() const {
+        const Sequence target = published_.load(std::memory_order_acquire);
+        for (std::size_t consumer = 0; consumer < consumerCount_; ++consumer) {
+            const Cursor& cursor = consumers_[consumer];
+            for (Sequence seen = cursor.sequence.load(std::memory_order_acquire);
+                 seen < target && cursor.active.load(std::memory_order_acquire);
+                 seen = cursor.sequence.load(std::memory_order_acquire)) {
+                if (wait_ == WaitStrategy::Block) {
+                    cursor.sequence.wait(seen, std::memory_order_acquire);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    // Wake up every waiting consumer and make consume() return 0 once a consumer has caught up.
+    void halt() {
+        halted_.store(true, std::memory_order_release);
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_all();
+    }
+
+    // Check whether the ring was halted.
+    bool halted() const { return halted_.load(std::memory_order_acquire); }
+
+    // Sequence following the last published value.
+    Sequence published() const { return published_.load(std::memory_order_acquire); }
+
+    // Sequence of the next value a consumer will read.
+    Sequence cursor(std::size_t consumer) const { return consumers_[consumer].sequence.load(std::memory_order_acquire); }
+
+    // Number of slots.
+    std::size_t capacity() const { return slots_.size(); }
+
+    // How threads wait on this ring.
+    WaitStrategy waitStrategy() const { return wait_; }
+
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+    static constexpr std::size_t kSpinsBeforeBlocking = 64;
+
+    // Round a capacity up to a power of two (at least 2).
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    // Position of one consumer.
+    struct alignas(kCacheLineSize) Cursor {
+        std::atomic<Sequence> sequence{0};  // Next value to read; everything before it is released
+        std::atomic<bool> active{false};
+    };
+
+    // State used by the producer thread only.
+    struct alignas(kCacheLineSize) ProducerState {
+        Sequence claimed = 0;        // Sequence following the last claimed slot
+        Sequence cachedGating = 0;   // Slowest consumer position seen by the producer
+    };
+
+    // Check whether the slots before `end` can be written: the slowest consumer must be less than a ring
+    // behind. The cursors are rescanned only when the cached minimum says no.
+    bool hasRoom(Sequence end) {
+        if (end - producer_.cachedGating <= slots_.size()) {
+            return true;
+        }
+        Sequence slowest = producer_.claimed;
+        for (std::size_t consumer = 0; consumer < consumerCount_; ++consumer) {
+            const Cursor& cursor = consumers_[consumer];
+            if (cursor.active.load(std::memory_order_acquire)) {
+                slowest = std::min(slowest, cursor.sequence.load(std::memory_order_acquire));
+            }
+        }
+        producer_.cachedGating = slowest;
+        return end - slowest <= slots_.size();
+    }
+
+    // Run the handler over the available values and move the consumer's cursor past them.
+    template <typename Handler>
+    std::size_t handle(Cursor& cursor, Sequence next, Sequence available, Handler& handler, std::size_t maxCount) {
+        const std::size_t count = std::min<std::size_t>(available - next, maxCount);
+        for (Sequence sequence = next; sequence != next + count; ++sequence) {
+            handler(static_cast<const T&>(slots_[sequence & mask_]), sequence);
+        }
+        if (count != 0) {
+            cursor.sequence.store(next + count, std::memory_order_release);
+            if (wait_ == WaitStrategy::Block) {
+                cursor.sequence.notify_all();
+            }
+        }
+        return count;
+    }
+
+    // Back off while spinning: a pause instruction when busy-spinning, otherwise give the core away.
+    // (A producer waiting for room never blocks; it yields in the Block strategy too.)
+    void pause() const {
+        if (wait_ == WaitStrategy::BusySpin) {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    std::vector<T> slots_;
+    std::size_t mask_;
+    WaitStrategy wait_;
+    ProducerState producer_;
+    alignas(kCacheLineSize) std::atomic<Sequence> published_{0};
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> signal_{0};  // Bumped on publish and halt (Block only)
+    std::atomic<bool> halted_{false};
+    std::unique_ptr<Cursor[]> consumers_;
+    std::size_t maxConsumers_;
+    std::size_t consumerCount_ = 0;  // Cursors in use are all below this index
+};
+
+#endif // MULTICAST_RING_H
@@ -0,0 +1,144 @@
+#ifndef SEQUENCE_TRACKER_H
+#define SEQUENCE_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "../config/settings.h"
+
+// The SequenceTracker class restores the message order of one feed channel.
+// Packets carry the sequence number of their first message and a message count (see itch_protocol.h).
+// In-order packets are delivered immediately; duplicates, and the already-seen part of overlapping
+// packets, are dropped; packets that arrive ahead of a missing one are buffered and delivered as soon
+// as the hole is filled.
+//
+// When more than `reorderWindow` packets are waiting behind a hole, the hole is treated as a real gap
+// and gapDetected() turns true. The owner then either recovers the channel from a snapshot
+// (beginRecovery() / completeRecovery()), while live packets keep being buffered, or gives up on the
+// missing messages with skipGap().
+//
+// Delivery goes through a callback `deliver(payload, size, skip, receiveTimestamp)`, where `skip` is the
+// number of leading messages of the payload that were already delivered.
+class SequenceTracker {
+public:
+    // Constructor that sets the reordering tolerance and the maximum number of buffered packets.
+    explicit SequenceTracker(std::size_t reorderWindow = config::FEED_REORDER_WINDOW,
+                             std::size_t maxBuffered = config::FEED_MAX_BUFFERED_PACKETS);
+
+    // Handle one packet of the channel.
+    template <typename Deliver>
+    void onPacket(std::uint64_t sequence, std::uint16_t count, const std::uint8_t* payload, std::size_t size,
+                  std::int64_t receiveTimestamp, Deliver&& deliver) {
+        if (!started_) {
+            started_ = true;
+            expected_ = sequence;  // Join the stream wherever it is
+        }
+        if (recovering_ || sequence > expected_) {
+            buffer(sequence, count, payload, size, receiveTimestamp);
+            return;
+        }
+        if (sequence + count <= expected_) {
+            if (count != 0) {
+                ++duplicates_;
+            }
+            return;
+        }
+        deliver(payload, size, static_cast<std::size_t>(expected_ - sequence), receiveTimestamp);
+        expected_ = sequence + count;
+        drainBuffered(deliver);
+    }
+
+    // Check whether a hole has outlived the reordering window.
+    bool gapDetected() const { return gapDetected_; }
+
+    // Check whether a snapshot recovery is in progress.
+    bool recovering() const { return recovering_; }
+
+    // Start a recovery: from now on every packet is buffered until completeRecovery().
+    void beginRecovery();
+
+    // Finish a recovery with a snapshot that covers every message before `nextSequence`,
+    // then replay the buffered packets that follow it.
+    template <typename Deliver>
+    void completeRecovery(std::uint64_t nextSequence, Deliver&& deliver) {
+        recovering_ = false;
+        started_ = true;
+        expected_ = nextSequence;
+        drainBuffered(deliver);
+    }
+
+    // Give up on the missing messages: continue with the first buffered packet. Returns the number of lost messages.
+    template <typename Deliver>
+    std::uint64_t skipGap(Deliver&& deliver) {
+        gapDetected_ = false;
+        if (buffered_.empty()) {
+            return 0;
+        }
+        const std::uint64_t lost = buffered_.begin()->first - expected_;
+        expected_ = buffered_.begin()->first;
+        drainBuffered(deliver);
+        return lost;
+    }
+
+    // Sequence number of the next message expected in order.
+    std::uint64_t expectedSequence() const { return expected_; }
+
+    // Number of packets waiting for a hole to be filled.
+    std::size_t bufferedPackets() const { return buffered_.size(); }
+
+    // Number of duplicate packets dropped.
+    std::uint64_t duplicates() const { return duplicates_; }
+
+    // Number of gaps detected.
+    std::uint64_t gaps() const { return gaps_; }
+
+    // Number of packets dropped because the buffer was full.
+    std::uint64_t overflows() const { return overflows_; }
+
+private:
+    // A packet that arrived ahead of its turn.
+    struct BufferedPacket {
+        std::uint16_t count;
+        std::int64_t receiveTimestamp;
+        std::vector<std::uint8_t> payload;
+    };
+
+    // Keep a copy of an early packet and check whether the hole in front of it is now a gap.
+    void buffer(std::uint64_t sequence, std::uint16_t count, const std::uint8_t* payload, std::size_t size,
+                std::int64_t receiveTimestamp);
+
+    // Deliver the buffered packets that have become contiguous with the delivered stream.
+    template <typename Deliver>
+    void drainBuffered(Deliver& deliver) {
+        while (!buffered_.empty() && buffered_.begin()->first <= expected_) {
+            const auto entry = buffered_.begin();
+            const std::uint64_t end = entry->first + entry->second.count;
+            if (end > expected_) {
+                const BufferedPacket& packet = entry->second;
+                deliver(packet.payload.data(), packet.payload.size(), static_cast<std::size_t>(expected_ - entry->first),
+                        packet.receiveTimestamp);
+                expected_ = end;
+            }
+            buffered_.erase(entry);
+        }
+        updateGap();
+    }
+
+    // Re-evaluate gapDetected() after the buffer changed.
+    void updateGap();
+
+    std::size_t reorderWindow_;
+    std::size_t maxBuffered_;
+    bool started_ = false;
+    bool recovering_ = false;
+    bool gapDetected_ = false;
+    std::uint64_t expected_ = 0;
+    std::map<std::uint64_t, BufferedPacket> buffered_;  // Keyed by the sequence number of the first message
+
+    std::uint64_t duplicates_ = 0;
+    std::uint64_t gaps_ = 0;
+    std::uint64_t overflows_ = 0;
+};
+
+#endif // SEQUENCE_TRACKER_H
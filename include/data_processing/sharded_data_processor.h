@@ -0,0 +1,107 @@
+#ifndef SHARDED_DATA_PROCESSOR_H
+#define SHARDED_DATA_PROCESSOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+#include "bar_aggregator.h"
+#include "data_processor.h"
+#include "spsc_ring.h"
+#include "tick_batch.h"
+#include "../config/settings.h"
+
+// The ShardedDataProcessor class spreads data processing over several worker threads.
+// Instruments are partitioned by id (shard = id % shardCount). Every shard owns a DataProcessor
+// (forward-fill state and L2 books), a BarAggregator and an input ring, and runs on its own thread.
+// Shards share nothing they write to.
+//
+// dispatch() splits a batch into per-shard rings on the caller's thread. Rows of an instrument always
+// go to the same shard in their original order, so order is preserved per instrument, while different
+// instruments are processed in parallel. Each shard then processes what it received and passes the
+// processed batch, and the bars it completed, to the handlers on its own thread. Per-shard consumers
+// such as strategies therefore keep their state per shard without locking.
+class ShardedDataProcessor {
+public:
+    // Called on a shard's thread with each batch the shard has processed.
+    using BatchHandler = std::function<void(std::size_t shard, const TickBatch& batch)>;
+
+    // Called on a shard's thread with the bars completed while processing a batch.
+    using BarHandler = std::function<void(std::size_t shard, std::span<const Bar> bars)>;
+
+    // Constructor that starts `shardCount` worker threads, pinned to consecutive CPUs from
+    // config::DATA_PROCESSOR_FIRST_CPU when it is set. Bars are built with the given type and threshold.
+    explicit ShardedDataProcessor(std::size_t shardCount = config::DATA_PROCESSOR_SHARDS, BarType barType = BarType::Time,
+                                  double barThreshold = static_cast<double>(config::BAR_INTERVAL_NANOS));
+
+    // Stops and joins the worker threads after they have processed everything dispatched.
+    ~ShardedDataProcessor();
+
+    ShardedDataProcessor(const ShardedDataProcessor&) = delete;
+    ShardedDataProcessor& operator=(const ShardedDataProcessor&) = delete;
+
+    // Set the handlers. Must be called before the first dispatch().
+    void setBatchHandler(BatchHandler handler) { batchHandler_ = std::move(handler); }
+    void setBarHandler(BarHandler handler) { barHandler_ = std::move(handler); }
+
+    // Hand the rows of a batch to their shards and return without waiting for them to be processed.
+    // Blocks only while a shard's ring is full.
+    void dispatch(const TickBatch& batch);
+
+    // Dispatch a batch and wait until every shard has processed it.
+    void process(const TickBatch& batch);
+
+    // Wait until every shard has processed everything dispatched so far.
+    void waitUntilIdle();
+
+    // Number of shards.
+    std::size_t shardCount() const { return shards_.size(); }
+
+    // Shard that owns an instrument.
+    std::size_t shardOf(InstrumentId instrumentId) const { return instrumentId % shards_.size(); }
+
+    // Processor of a shard. Only safe to read while the shards are idle (see waitUntilIdle()).
+    const DataProcessor& processor(std::size_t shard) const { return shards_[shard]->processor; }
+
+    // L2 book of an instrument (nullptr if it has not been quoted). Only safe to read while the shards are idle.
+    const L2Book* book(InstrumentId instrumentId) const;
+
+    // Number of ticks a shard has processed.
+    std::uint64_t ticksProcessed(std::size_t shard) const {
+        return shards_[shard]->ticks.load(std::memory_order_relaxed);
+    }
+
+private:
+    // State owned by one shard.
+    struct Shard {
+        Shard(BarType barType, double barThreshold)
+            : ring(config::DATA_PROCESSOR_SHARD_QUEUE), bars(barType, barThreshold) {}
+
+        SpscRing<Tick> ring;                     // Rows dispatched to the shard
+        DataProcessor processor;
+        BarAggregator bars;
+        TickBatch batch;
+        std::vector<Bar> completed;
+        std::atomic<std::uint64_t> posted{0};    // Incremented by the dispatcher after pushing rows
+        std::atomic<std::uint64_t> processed{0}; // Last `posted` value whose rows were processed
+        std::atomic<std::uint64_t> ticks{0};
+        std::thread thread;
+    };
+
+    // Wake a shard's thread after rows were pushed to its ring.
+    static void post(Shard& shard);
+
+    // Body of a shard's thread.
+    void run(Shard& shard, std::size_t index);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    BatchHandler batchHandler_;
+    BarHandler barHandler_;
+    std::atomic<bool> running_{true};
+};
+
+#endif // SHARDED_DATA_PROCESSOR_H
@@ -0,0 +1,48 @@
+#ifndef SNAPSHOT_SOURCE_H
+#define SNAPSHOT_SOURCE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// State of one feed channel at a point in its sequence.
+// `messages` are framed ITCH-style messages (see itch_protocol.h) that rebuild the state from scratch,
+// and `nextSequence` is the sequence number of the first live message not covered by them.
+struct Snapshot {
+    std::uint64_t nextSequence = 0;
+    std::vector<std::uint8_t> messages;
+};
+
+// The SnapshotSource class is the interface of a snapshot (recovery) service.
+// The DataCollector calls requestSnapshot() on a helper thread when a channel has a sequence gap,
+// so an implementation may block for as long as the request takes.
+class SnapshotSource {
+public:
+    virtual ~SnapshotSource() = default;
+
+    // Fetch the current snapshot of a channel. Throws std::runtime_error if no snapshot is available.
+    virtual Snapshot requestSnapshot(std::uint16_t channel) = 0;
+};
+
+// The FileSnapshotSource class serves snapshots from files written by a local snapshot service.
+// The snapshot of channel N is read from "<directory>/channel-N.snapshot", which holds the next
+// sequence number as a big-endian uint64 followed by the framed messages.
+class FileSnapshotSource : public SnapshotSource {
+public:
+    // Constructor that sets the directory the snapshot files are read from.
+    explicit FileSnapshotSource(const std::string& directory);
+
+    // Read the latest snapshot file of the channel.
+    Snapshot requestSnapshot(std::uint16_t channel) override;
+
+    // Write a snapshot file in the format read by requestSnapshot().
+    static void write(const std::string& fileName, const Snapshot& snapshot);
+
+    // Name of the snapshot file of a channel.
+    std::string fileName(std::uint16_t channel) const;
+
+private:
+    std::string directory_;
+};
+
+#endif // SNAPSHOT_SOURCE_H
@@ -0,0 +1,109 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// The SpscRing class is a bounded lock-free queue for exactly one producer thread and one consumer thread.
+// The capacity is rounded up to a power of two so that slots are addressed with a mask.
+// The producer and consumer indices live on separate cache lines, and each side keeps a cached copy
+// of the other side's index, so the shared cache lines are only touched when the cached view is exhausted.
+template <typename T>
+class SpscRing {
+public:
+    // Constructor that allocates the slots. The capacity is rounded up to the next power of two.
+    explicit SpscRing(std::size_t capacity) : slots_(roundUp(capacity)), mask_(slots_.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: append a value. Returns false if the ring is full.
+    bool tryPush(const T& value) {
+        const std::size_t head = producer_.head.load(std::memory_order_relaxed);
+        if (head - producer_.cachedTail == slots_.size()) {
+            producer_.cachedTail = consumer_.tail.load(std::memory_order_acquire);
+            if (head - producer_.cachedTail == slots_.size()) {
+                return false;
+            }
+        }
+        slots_[head & mask_] = value;
+        producer_.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: remove the oldest value. Returns false if the ring is empty.
+    bool tryPop(T& value) {
+        const std::size_t tail = consumer_.tail.load(std::memory_order_relaxed);
+        if (tail == consumer_.cachedHead) {
+            consumer_.cachedHead = producer_.head.load(std::memory_order_acquire);
+            if (tail == consumer_.cachedHead) {
+                return false;
+            }
+        }
+        value = slots_[tail & mask_];
+        consumer_.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: hand up to `maxCount` available values to `consumer` and release their slots in one step.
+    // Returns the number of values consumed.
+    template <typename Consumer>
+    std::size_t drain(Consumer&& consumer, std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+        const std::size_t tail = consumer_.tail.load(std::memory_order_relaxed);
+        consumer_.cachedHead = producer_.head.load(std::memory_order_acquire);
+
+        std::size_t count = consumer_.cachedHead - tail;
+        if (count > maxCount) {
+            count = maxCount;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            consumer(slots_[(tail + i) & mask_]);
+        }
+        consumer_.tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Number of values currently queued. Exact only when called from the producer or consumer thread.
+    std::size_t size() const {
+        return producer_.head.load(std::memory_order_acquire) - consumer_.tail.load(std::memory_order_acquire);
+    }
+
+    // Check whether the ring is empty.
+    bool empty() const { return size() == 0; }
+
+    // Maximum number of queued values.
+    std::size_t capacity() const { return slots_.size(); }
+
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    // Round a capacity up to a power of two (at least 2).
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    // State written by the producer.
+    struct alignas(kCacheLineSize) ProducerState {
+        std::atomic<std::size_t> head{0};  // Next slot to write
+        std::size_t cachedTail = 0;        // Last consumer position seen by the producer
+    };
+
+    // State written by the consumer.
+    struct alignas(kCacheLineSize) ConsumerState {
+        std::atomic<std::size_t> tail{0};  // Next slot to read
+        std::size_t cachedHead = 0;        // Last producer position seen by the consumer
+    };
+
+    std::vector<T> slots_;
+    std::size_t mask_;
+    ProducerState producer_;
+    ConsumerState consumer_;
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,120 @@
+#ifndef TICK_BATCH_H
+#define TICK_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "../common.h"
+
+// A single market data event in row form.
+// Used where one event at a time is handed around (feeds, rings, tests); bulk data lives in TickBatch.
+// Prices and sizes that are not present in the source are left at zero.
+struct Tick {
+    std::int64_t timestamp = 0;      // Event time in nanoseconds since the Unix epoch
+    InstrumentId instrumentId = 0;   // Dense numeric instrument identifier
+    double bidPrice = 0.0;           // Best bid price
+    double askPrice = 0.0;           // Best ask price
+    std::int64_t bidSize = 0;        // Quantity available at the best bid
+    std::int64_t askSize = 0;        // Quantity available at the best ask
+    double tradePrice = 0.0;         // Last trade price (zero for quote-only events)
+    std::int64_t tradeQuantity = 0;  // Last trade quantity (zero for quote-only events)
+    std::int64_t receiveTimestamp = 0;  // Local receive time in nanoseconds since the Unix epoch (zero for historical data)
+};
+
+// Identifiers of the TickBatch columns, used to select a subset of columns (e.g. when loading).
+enum class TickColumn : std::uint32_t {
+    Timestamp,
+    InstrumentId,
+    BidPrice,
+    AskPrice,
+    BidSize,
+    AskSize,
+    TradePrice,
+    TradeQuantity,
+    ReceiveTimestamp,
+    Count  // Number of columns
+};
+
+// Bitmask of TickColumn values.
+using TickColumnMask = std::uint32_t;
+
+// Mask bit of a single column.
+constexpr TickColumnMask tickColumnBit(TickColumn column) {
+    return TickColumnMask{1} << static_cast<std::uint32_t>(column);
+}
+
+// Mask that selects every column.
+constexpr TickColumnMask kAllTickColumns = (TickColumnMask{1} << static_cast<std::uint32_t>(TickColumn::Count)) - 1;
+
+// The TickBatch class stores market data as a struct of arrays.
+// Each field of Tick lives in its own contiguous column, so processing code can walk a single
+// column without touching the others and without allocating per event.
+// All columns always have the same length.
+class TickBatch {
+public:
+    // Number of ticks in the batch.
+    std::size_t size() const { return timestamps_.size(); }
+
+    // Check whether the batch holds no ticks.
+    bool empty() const { return timestamps_.empty(); }
+
+    // Reserve capacity in every column so that appending up to `capacity` ticks does not reallocate.
+    void reserve(std::size_t capacity);
+
+    // Resize every column. New rows are zero-initialized.
+    void resize(std::size_t size);
+
+    // Remove all ticks while keeping the allocated capacity for reuse.
+    void clear();
+
+    // Append one tick to the end of the batch.
+    void append(const Tick& tick);
+
+    // Assemble the tick stored at the given row.
+    Tick at(std::size_t row) const;
+
+    // Overwrite the row `to` with the contents of row `from`.
+    // Used by in-place filters to compact the batch.
+    void moveRow(std::size_t from, std::size_t to);
+
+    // Column accessors.
+    std::span<std::int64_t> timestamps() { return timestamps_; }
+    std::span<InstrumentId> instrumentIds() { return instrumentIds_; }
+    std::span<double> bidPrices() { return bidPrices_; }
+    std::span<double> askPrices() { return askPrices_; }
+    std::span<std::int64_t> bidSizes() { return bidSizes_; }
+    std::span<std::int64_t> askSizes() { return askSizes_; }
+    std::span<double> tradePrices() { return tradePrices_; }
+    std::span<std::int64_t> tradeQuantities() { return tradeQuantities_; }
+    std::span<std::int64_t> receiveTimestamps() { return receiveTimestamps_; }
+
+    std::span<const std::int64_t> timestamps() const { return timestamps_; }
+    std::span<const InstrumentId> instrumentIds() const { return instrumentIds_; }
+    std::span<const double> bidPrices() const { return bidPrices_; }
+    std::span<const double> askPrices() const { return askPrices_; }
+    std::span<const std::int64_t> bidSizes() const { return bidSizes_; }
+    std::span<const std::int64_t> askSizes() const { return askSizes_; }
+    std::span<const double> tradePrices() const { return tradePrices_; }
+    std::span<const std::int64_t> tradeQuantities() const { return tradeQuantities_; }
+    std::span<const std::int64_t> receiveTimestamps() const { return receiveTimestamps_; }
+
+private:
+    std::vector<std::int64_t> timestamps_;
+    std::vector<InstrumentId> instrumentIds_;
+    std::vector<double> bidPrices_;
+    std::vector<double> askPrices_;
+    std::vector<std::int64_t> bidSizes_;
+    std::vector<std::int64_t> askSizes_;
+    std::vector<double> tradePrices_;
+    std::vector<std::int64_t> tradeQuantities_;
+    std::vector<std::int64_t> receiveTimestamps_;
+};
+
+// Parse a textual timestamp into nanoseconds since the Unix epoch (UTC).
+// Accepts "YYYY-MM-DD", "YYYY-MM-DD HH:MM:SS[.fraction]" (a 'T' separator is also accepted)
+// and plain integer nanosecond values. Returns false if the text is not a timestamp.
+bool parseTimestamp(std::string_view text, std::int64_t& nanos);
+
+#endif // TICK_BATCH_H
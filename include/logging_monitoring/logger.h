@@ -12,7 +12,8 @@ public:
     Logger(const std::string& logFile);
 
     // Method to log a message to the file.
-    // The message is appended to the log file with each call.
+    // The message is appended to the log file with each call, prefixed with the time it was logged
+    // (nanoseconds since the epoch, from TscClock) so log lines line up with the pipeline's event timestamps.
     void log(const std::string& message);
 
     // Destructor to ensure the log file is properly closed.
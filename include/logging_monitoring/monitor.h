@@ -1,9 +1,21 @@
 #ifndef MONITOR_H
 #define MONITOR_H
 
+#include <array>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <utility>  // For std::pair
+#include "../common.h"
+
+// Metrics kept for every instrument.
+enum class InstrumentMetric {
+    Position,
+    Exposure,
+    Pnl,
+    Orders,
+    Count
+};
 
 // The Monitor class is responsible for tracking system metrics.
 // Metrics are stored as name-value pairs and can be reported for monitoring system performance.
@@ -13,14 +25,34 @@ public:
     // Takes the name of the metric and its value and stores it for later reporting.
     void addMetric(const std::string& name, double value);
 
+    // Set a metric of an instrument.
+    // Instrument metrics are stored in an array indexed by instrument id, so recording one is a plain store.
+    // An invalid instrument id (see isValidInstrument()) is reported and ignored, here and in addInstrumentMetric().
+    void setInstrumentMetric(InstrumentId instrument, InstrumentMetric metric, double value);
+
+    // Add to a metric of an instrument (e.g. count an order).
+    void addInstrumentMetric(InstrumentId instrument, InstrumentMetric metric, double delta);
+
+    // Get a metric of an instrument (0 if it was never recorded).
+    double instrumentMetric(InstrumentId instrument, InstrumentMetric metric) const;
+
     // Report all stored metrics.
-    // This method outputs all metrics and their values to the console.
+    // This method outputs all metrics and their values to the console, followed by the metrics of
+    // every instrument that has any.
     void reportMetrics() const;
 
 private:
     // Store metrics as a vector of name-value pairs.
     // Each metric is represented by a string (name) and a double (value).
     std::vector<std::pair<std::string, double>> metrics_;
+
+    // Metrics per instrument, indexed by instrument id.
+    using InstrumentMetrics = std::array<double, static_cast<std::size_t>(InstrumentMetric::Count)>;
+    std::vector<InstrumentMetrics> instrumentMetrics_;
+
+    // Metrics of an instrument, growing the array the first time the instrument is seen.
+    // Returns nullptr for an invalid instrument id (see isValidInstrument()).
+    InstrumentMetrics* metricsOf(InstrumentId instrument);
 };
 
 #endif // MONITOR_H
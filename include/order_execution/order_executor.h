@@ -1,8 +1,12 @@
 #ifndef ORDER_EXECUTOR_H
 #define ORDER_EXECUTOR_H
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "exchange_connector.h"
+#include "latency_stats.h"
+#include "../common.h"
 
 // The OrderExecutor class is responsible for managing the process of sending orders to the exchange
 // and checking their status. It uses the ExchangeConnector class to interact with the exchange API.
@@ -16,6 +20,20 @@ public:
     // It takes the order details as a string and sends the order if the connection to the exchange is active.
     void sendOrder(const std::string& orderDetails);
 
+    // Method to send an order for an instrument identified by its dense id (see InstrumentRegistry).
+    // A positive quantity buys and a negative one sells. Returns true if the order was sent; an invalid
+    // instrument id (see isValidInstrument()) is refused.
+    // Orders are treated as filled once sent, as checkOrderStatus() reports, and update the position.
+    // `triggerTimestamp` is the receive timestamp (Tick::receiveTimestamp) of the market data that triggered
+    // the order; when it is given, the tick-to-trade latency is measured with TscClock once the order is out.
+    bool sendOrder(InstrumentId instrument, std::int64_t quantity, double price, std::int64_t triggerTimestamp = 0);
+
+    // Tick-to-trade latency of the orders sent with a trigger timestamp.
+    const LatencyStats& tickToTrade() const { return tickToTrade_; }
+
+    // Method to get the net position of an instrument (0 if it has never been traded).
+    std::int64_t position(InstrumentId instrument) const;
+
     // Method to check the status of an order.
     // Takes an order ID and returns true if the order is complete.
     bool checkOrderStatus(int orderId) const;
@@ -26,6 +44,15 @@ private:
 
     // Helper method to generate a unique order ID for each order.
     int generateOrderId() const;
+
+    // Helper method to sign and send the order details. Returns true if the order was sent.
+    bool submit(const std::string& orderDetails);
+
+    // Net position per instrument, indexed by instrument id.
+    std::vector<std::int64_t> positions_;
+
+    // Time from receipt of the triggering market data to the order leaving the executor.
+    LatencyStats tickToTrade_;
 };
 
 #endif // ORDER_EXECUTOR_H
@@ -1,7 +1,9 @@
 #ifndef EXPOSURE_LIMIT_RISK_STRATEGY_H
 #define EXPOSURE_LIMIT_RISK_STRATEGY_H
 
+#include <vector>
 #include "risk_strategy.h"
+#include "../common.h"
 
 // Strategy to monitor exposure limits.
 // This strategy triggers a risk signal if the current exposure exceeds the maximum allowable exposure.
@@ -17,9 +19,23 @@ public:
     // Method to update the current exposure level.
     void updateExposure(double currentExposure);
 
+    // Method to update the exposure of one instrument.
+    // The sum of the absolute exposures of all instruments is kept as a running total, so an update does
+    // not iterate over the instruments. It is checked against the limit separately from the exposure
+    // set by updateExposure(double).
+    void updateExposure(InstrumentId instrument, double exposure);
+
+    // Method to get the last exposure reported for an instrument.
+    double exposure(InstrumentId instrument) const;
+
+    // Method to get the sum of the absolute exposures of all instruments.
+    double instrumentTotal() const { return instrumentTotal_; }
+
 private:
     double maxAllowedExposure_;  // Maximum allowable exposure before triggering risk.
     double currentExposure_;     // Current exposure of the system.
+    std::vector<double> instrumentExposures_;  // Exposure per instrument, indexed by instrument id.
+    double instrumentTotal_ = 0.0;             // Sum of the absolute instrument exposures.
 };
 
 #endif // EXPOSURE_LIMIT_RISK_STRATEGY_H
@@ -1,7 +1,10 @@
 #ifndef MAX_DRAWDOWN_RISK_STRATEGY_H
 #define MAX_DRAWDOWN_RISK_STRATEGY_H
 
+#include <cstddef>
+#include <vector>
 #include "risk_strategy.h"
+#include "../common.h"
 
 // Strategy to monitor and manage drawdown risk.
 // This strategy triggers a risk signal if the current drawdown exceeds the maximum allowable drawdown.
@@ -17,9 +20,19 @@ public:
     // Method to update the current drawdown value.
     void updateDrawdown(double currentDrawdown);
 
+    // Method to update the drawdown of one instrument.
+    // The risk is too high as soon as any instrument exceeds the maximum allowed drawdown.
+    // An invalid instrument id (see isValidInstrument()) is reported and ignored.
+    void updateDrawdown(InstrumentId instrument, double drawdown);
+
+    // Method to get the last drawdown reported for an instrument.
+    double drawdown(InstrumentId instrument) const;
+
 private:
     double maxAllowedDrawdown_;  // Maximum allowable drawdown before triggering risk.
     double currentDrawdown_;     // Current drawdown of the system.
+    std::vector<double> instrumentDrawdowns_;  // Drawdown per instrument, indexed by instrument id.
+    std::size_t instrumentsInBreach_ = 0;      // Number of instruments above the maximum drawdown.
 };
 
 #endif // MAX_DRAWDOWN_RISK_STRATEGY_H
@@ -1,11 +1,23 @@
 #ifndef BASE_STRATEGY_H
 #define BASE_STRATEGY_H
 
+#include <cstdint>
 #include <string>
+#include <vector>
+#include "bar_aggregator.h"
+#include "instrument_registry.h"
+#include "order_channel.h"
+#include "strategy_events.h"
+#include "tick_batch.h"
 
 // Base class for all trading strategies
 // This class serves as an abstract interface for all trading strategies.
 // Derived classes must implement the methods to execute, configure, and analyze their specific strategies.
+//
+// Strategies react to the market through typed event callbacks (onBookUpdate, onTrade, onFill, onTimer).
+// The events are filled in place by the caller and passed by const reference, and orders leave through
+// the strategy's OrderChannel (submitOrder), so nothing on the callback path allocates. All callbacks of
+// a strategy are made from one thread at a time.
 class BaseStrategy {
 public:
     // Virtual destructor to ensure proper cleanup for derived classes
@@ -18,6 +30,39 @@ public:
     // It is expected that this method will contain the core logic of the trading strategy.
     virtual void execute() = 0;
 
+    // Method to run the strategy over a batch of processed market data
+    // The batch is passed by const reference and read directly from its columns, without copying.
+    // The default implementation turns every row into a BookUpdate, followed by a Trade if the row has a
+    // trade quantity, with prices converted to ticks of the instrument. Strategies that prefer to walk the
+    // columns themselves override it.
+    virtual void onBatch(const TickBatch& batch);
+
+    // Method to receive a new top of book.
+    // The default implementation calls `execute`, so strategies that do not look at the data yet keep
+    // running once per tick.
+    virtual void onBookUpdate(const BookUpdate& update) {
+        (void)update;
+        execute();
+    }
+
+    // Method to receive a trade printed on the market. The default implementation ignores it.
+    virtual void onTrade(const Trade& trade) { (void)trade; }
+
+    // Method to receive the execution of one of the strategy's orders. The default implementation ignores it.
+    virtual void onFill(const Fill& fill) { (void)fill; }
+
+    // Method to receive a timer event. The default implementation ignores it.
+    virtual void onTimer(const TimerEvent& timer) { (void)timer; }
+
+    // Method to receive a completed OHLCV bar
+    // Bars are built once, by a shared BarAggregator, and handed to every strategy, so strategies that
+    // work on bars do not each rebuild them from the ticks. The default implementation ignores them.
+    virtual void onBar(const Bar& bar) { (void)bar; }
+
+    // Columns of the market data batch that the strategy reads
+    // Loaders use this to skip columns no strategy needs. By default every column is requested.
+    virtual TickColumnMask requiredColumns() const { return kAllTickColumns; }
+
     // Optional: Method to configure the strategy with necessary parameters
     // This method allows the strategy to be configured dynamically using a configuration string.
     // Derived classes should implement how they parse and apply the configuration.
@@ -27,6 +72,29 @@ public:
     // After the strategy has been run, this method can be used to analyze the results, 
     // such as calculating performance metrics. It returns a summary of the analysis as a string.
     virtual std::string analyzeResults() const = 0;
+
+    // Connect the strategy to the channel its orders are written to (nullptr disconnects it).
+    // The StrategyManager does this when the strategy is added.
+    void setOrderChannel(OrderChannel* channel) { orders_ = channel; }
+
+    // Channel the strategy's orders are written to, or nullptr.
+    OrderChannel* orderChannel() const { return orders_; }
+
+    // Use the tick sizes of the registry's instruments to convert prices to ticks.
+    // Instruments the registry does not know use config::DEFAULT_TICK_SIZE.
+    void setInstruments(const InstrumentRegistry& registry);
+
+    // Tick size of an instrument.
+    double tickSize(InstrumentId instrumentId) const { return tickSizeOf(tickSizes_, instrumentId); }
+
+protected:
+    // Send an order through the strategy's channel. The id it gets is written to `intent.orderId`.
+    // Returns false if the strategy has no channel or the channel is full.
+    bool submitOrder(OrderIntent& intent) { return orders_ != nullptr && orders_->submit(intent); }
+
+private:
+    OrderChannel* orders_ = nullptr;  // Owned by the StrategyManager
+    std::vector<double> tickSizes_;   // Indexed by instrument id
 };
 
 #endif // BASE_STRATEGY_H
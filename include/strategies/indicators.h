@@ -0,0 +1,276 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "rolling_stats.h"
+
+// Technical indicators over price series: SMA, EMA, VWAP, Bollinger bands, RSI and rolling min/max.
+//
+// Each indicator comes in two forms that compute the same values:
+// - a batch function over whole columns (e.g. the TickBatch price columns), for backtests and research.
+//   It writes one output per input row; rows before the first full window are NaN. The work is done
+//   in blocks of a few thousand rows with AVX2 kernels when the CPU has them (checked once at runtime),
+//   and with scalar loops otherwise;
+// - an incremental class fed one value at a time, for live trading. Updates are O(1) and do not allocate.
+//
+// The windowed sums of the batch functions are computed as prefix sums of the values entering minus the
+// values leaving the window. Each block starts again from a sum computed directly, so the rounding error
+// of the running sums cannot build up over a long series.
+namespace indicators {
+
+// Instruction set used by the batch functions.
+enum class SimdLevel {
+    Scalar,  // Plain loops
+    Avx2     // 256-bit AVX2/FMA kernels, four rows at a time
+};
+
+// Instruction set the batch functions currently use.
+SimdLevel simdLevel();
+
+// Select the instruction set of the batch functions, e.g. to compare the two in a test or a benchmark.
+// A level the CPU does not support falls back to Scalar. Returns the level actually selected.
+SimdLevel setSimdLevel(SimdLevel level);
+
+// Batch functions. `out` (and every output span) must have at least as many elements as the input.
+// They throw std::runtime_error on a zero window or a short output.
+
+// Simple moving average over `window` rows.
+void sma(std::span<const double> values, std::size_t window, std::span<double> out);
+
+// Exponential moving average with weight `alpha` (0 < alpha <= 1), starting at the first value.
+void ema(std::span<const double> values, double alpha, std::span<double> out);
+
+// Volume-weighted average price over `window` rows. Rows with no quantity (quotes) add nothing; a window
+// without any quantity is NaN. Quantities must be below 2^51 in magnitude.
+void vwap(std::span<const double> prices, std::span<const std::int64_t> quantities, std::size_t window,
+          std::span<double> out);
+
+// Bollinger bands over `window` rows: the moving average, and the average plus and minus `width` sample
+// standard deviations.
+void bollinger(std::span<const double> values, std::size_t window, double width, std::span<double> middle,
+               std::span<double> upper, std::span<double> lower);
+
+// Relative strength index with Wilder's smoothing over `period` changes (0 to 100). The averages start
+// as the plain mean of the first `period` changes, so the first value is at row `period`.
+void rsi(std::span<const double> values, std::size_t period, std::span<double> out);
+
+// Smallest and largest value of the last `window` rows (van Herk / Gil-Werman: three comparisons per
+// row whatever the window).
+void rollingMin(std::span<const double> values, std::size_t window, std::span<double> out);
+void rollingMax(std::span<const double> values, std::size_t window, std::span<double> out);
+
+// Weight of an EMA with the same center of mass as a `period` row SMA.
+inline double emaAlpha(std::size_t period) { return 2.0 / (static_cast<double>(period) + 1.0); }
+
+// Incremental simple moving average.
+class Sma {
+public:
+    explicit Sma(std::size_t window) : stats_(window) {}
+
+    // Add a value and return the average (NaN until the window is full).
+    double update(double value) {
+        stats_.add(value);
+        return this->value();
+    }
+
+    double value() const { return ready() ? stats_.mean() : std::numeric_limits<double>::quiet_NaN(); }
+    bool ready() const { return stats_.full(); }
+
+private:
+    RollingStats stats_;
+};
+
+// Incremental exponential moving average.
+class Ema {
+public:
+    explicit Ema(double alpha) : alpha_(alpha) {}
+
+    // Add a value and return the average.
+    double update(double value) {
+        value_ = ready_ ? value_ + alpha_ * (value - value_) : value;
+        ready_ = true;
+        return value_;
+    }
+
+    double value() const { return ready_ ? value_ : std::numeric_limits<double>::quiet_NaN(); }
+    bool ready() const { return ready_; }
+
+private:
+    double alpha_;
+    double value_ = 0.0;
+    bool ready_ = false;
+};
+
+// Incremental volume-weighted average price over the last `window` rows.
+class Vwap {
+public:
+    // Throws std::runtime_error if the window is empty.
+    explicit Vwap(std::size_t window);
+
+    // Add a row and return the VWAP (NaN until the window is full or while it has no quantity).
+    double update(double price, std::int64_t quantity) {
+        const double notional = price * static_cast<double>(quantity);
+        const double volume = static_cast<double>(quantity);
+        if (count_ == rows_.size()) {
+            notional_ -= rows_[next_].notional;
+            volume_ -= rows_[next_].volume;
+        } else {
+            ++count_;
+        }
+        rows_[next_] = Row{notional, volume};
+        notional_ += notional;
+        volume_ += volume;
+        if (++next_ == rows_.size()) {
+            next_ = 0;
+            refresh();
+        }
+        return value();
+    }
+
+    double value() const {
+        return ready() && volume_ != 0.0 ? notional_ / volume_ : std::numeric_limits<double>::quiet_NaN();
+    }
+    bool ready() const { return count_ == rows_.size(); }
+
+private:
+    struct Row {
+        double notional = 0.0;
+        double volume = 0.0;
+    };
+
+    // Recompute the sums of the full window, dropping the rounding error of the running updates.
+    void refresh();
+
+    std::vector<Row> rows_;  // Ring buffer of the window
+    std::size_t next_ = 0;
+    std::size_t count_ = 0;
+    double notional_ = 0.0;
+    double volume_ = 0.0;
+};
+
+// Incremental Bollinger bands.
+class Bollinger {
+public:
+    Bollinger(std::size_t window, double width) : stats_(window), width_(width) {}
+
+    // Add a value and return the middle band.
+    double update(double value) {
+        stats_.add(value);
+        return middle();
+    }
+
+    // Bands (NaN until the window is full).
+    double middle() const { return ready() ? stats_.mean() : std::numeric_limits<double>::quiet_NaN(); }
+    double upper() const { return middle() + width_ * stats_.stddev(); }
+    double lower() const { return middle() - width_ * stats_.stddev(); }
+
+    // Number of standard deviations between a value and the middle band (0 until the window is full).
+    double zScore(double value) const { return ready() ? stats_.zScore(value) : 0.0; }
+
+    bool ready() const { return stats_.full(); }
+
+private:
+    RollingStats stats_;
+    double width_;
+};
+
+// Incremental relative strength index.
+class Rsi {
+public:
+    // Throws std::runtime_error if the period is 0.
+    explicit Rsi(std::size_t period);
+
+    // Add a value and return the RSI (NaN until `period` changes have been seen).
+    double update(double value) {
+        if (values_++ == 0) {
+            previous_ = value;
+            return this->value();
+        }
+        const double change = value - previous_;
+        previous_ = value;
+        const double gain = change > 0.0 ? change : 0.0;
+        const double loss = change < 0.0 ? -change : 0.0;
+        if (values_ <= period_ + 1) {
+            averageGain_ += gain / static_cast<double>(period_);  // Plain mean of the first changes
+            averageLoss_ += loss / static_cast<double>(period_);
+        } else {
+            averageGain_ += (gain - averageGain_) / static_cast<double>(period_);
+            averageLoss_ += (loss - averageLoss_) / static_cast<double>(period_);
+        }
+        return this->value();
+    }
+
+    double value() const {
+        if (!ready()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const double total = averageGain_ + averageLoss_;
+        return total > 0.0 ? 100.0 * averageGain_ / total : 50.0;
+    }
+    bool ready() const { return values_ > period_; }
+
+private:
+    std::size_t period_;
+    std::size_t values_ = 0;
+    double previous_ = 0.0;
+    double averageGain_ = 0.0;
+    double averageLoss_ = 0.0;
+};
+
+// Incremental minimum (Compare = std::less) or maximum (std::greater) of the last `window` values.
+// A ring buffer holds the candidates in monotonic order; each value enters and leaves it once.
+template <typename Compare>
+class RollingExtremum {
+public:
+    // Throws std::runtime_error if the window is empty.
+    explicit RollingExtremum(std::size_t window) : slots_(window), window_(window) {
+        if (window == 0) {
+            throw std::runtime_error("Rolling extremum window must not be empty");
+        }
+    }
+
+    // Add a value and return the extremum (NaN until the window is full).
+    double update(double value) {
+        while (size_ != 0 && !Compare{}(back().value, value)) {
+            --size_;  // Dominated by the new value for as long as it stays in the window
+        }
+        if (size_ != 0 && front().index + window_ <= index_) {
+            head_ = (head_ + 1) % window_;
+            --size_;
+        }
+        slots_[(head_ + size_) % window_] = Candidate{index_++, value};
+        ++size_;
+        return this->value();
+    }
+
+    double value() const { return ready() ? front().value : std::numeric_limits<double>::quiet_NaN(); }
+    bool ready() const { return index_ >= window_; }
+
+private:
+    struct Candidate {
+        std::uint64_t index = 0;
+        double value = 0.0;
+    };
+
+    const Candidate& front() const { return slots_[head_]; }
+    const Candidate& back() const { return slots_[(head_ + size_ - 1) % window_]; }
+
+    std::vector<Candidate> slots_;
+    std::size_t window_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    std::uint64_t index_ = 0;  // Index of the next value
+};
+
+using RollingMin = RollingExtremum<std::less<double>>;
+using RollingMax = RollingExtremum<std::greater<double>>;
+
+} // namespace indicators
+
+#endif // INDICATORS_H
@@ -2,12 +2,22 @@
 #define MEAN_REVERSION_STRATEGY_H
 
 #include "base_strategy.h"
+#include "indicators.h"
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
+#include "../config/settings.h"
 
 // MeanReversionStrategy is a derived class from BaseStrategy.
-// This class implements a simple mean reversion trading strategy, where trades are executed
-// based on a reversion to a mean price level. It provides methods to configure, execute, and analyze the strategy.
+// This class implements a mean reversion trading strategy: it expects the price of an instrument to
+// revert to its recent mean, and takes the opposite side when the price strays too far from it.
+//
+// The mean and standard deviation of each instrument come from the closes of its last
+// `config::MEAN_REVERSION_STRATEGY_PERIOD` bars, kept in incremental Bollinger bands. Every book update then measures the
+// mid price against them as a z-score, in constant time. Beyond `config::MEAN_REVERSION_ENTRY_ZSCORE` the
+// strategy sells (price above the mean) or buys (below) `config::MEAN_REVERSION_ORDER_QUANTITY`, crossing
+// the spread; back within `config::MEAN_REVERSION_EXIT_ZSCORE` it closes the position.
 class MeanReversionStrategy : public BaseStrategy {
 public:
     // Configure the mean reversion strategy with necessary parameters.
@@ -16,11 +26,32 @@ public:
     void configure(const std::string& config) override;
 
     // Execute the mean reversion strategy.
-    // This method contains the core logic for executing the mean reversion strategy. In this simplified
-    // version, it simply increments the number of trades executed, but in a full implementation,
-    // it would involve analyzing price data and making trade decisions based on the difference from the mean price.
+    // This method records a manual trade execution by incrementing the number of trades executed.
     void execute() override;
 
+    // Add the bar's close to the rolling statistics of its instrument.
+    void onBar(const Bar& bar) override;
+
+    // Compare the mid price with the instrument's mean and move the position towards the target the
+    // z-score calls for.
+    void onBookUpdate(const BookUpdate& update) override;
+
+    // Update the position of the instrument with the fill.
+    void onFill(const Fill& fill) override;
+
+    // Current mean price of an instrument.
+    // Until a full period of bars has been seen, the configured default mean price is returned.
+    double meanPrice(InstrumentId instrumentId) const;
+
+    // Number of standard deviations between a price and the mean of an instrument
+    // (0 until a full period of bars has been seen).
+    double zScore(InstrumentId instrumentId, double price) const;
+
+    // Filled position of an instrument.
+    std::int64_t position(InstrumentId instrumentId) const {
+        return instrumentId < positions_.size() ? positions_[instrumentId] : 0;
+    }
+
     // Analyze the results of the mean reversion strategy.
     // After the strategy has been run, this method provides a summary of the number of trades executed.
     std::string analyzeResults() const override;
@@ -30,6 +61,16 @@ private:
     // This value represents the price level around which the strategy expects prices to revert.
     double meanPrice_ = 100.0;
 
+    // Bollinger bands of the bar closes, per instrument, indexed by instrument id.
+    // Their width is the entry z-score, so a mid price outside the bands opens a position.
+    std::vector<indicators::Bollinger> bands_;
+
+    // Position the strategy has sent orders for, per instrument.
+    std::vector<std::int64_t> targets_;
+
+    // Position filled so far, per instrument.
+    std::vector<std::int64_t> positions_;
+
     // Counter for the number of trades executed.
     int tradesExecuted_ = 0;
 };
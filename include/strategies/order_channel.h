@@ -0,0 +1,96 @@
+#ifndef ORDER_CHANNEL_H
+#define ORDER_CHANNEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "spsc_ring.h"
+#include "strategy_events.h"
+#include "tsc_clock.h"
+#include "../config/settings.h"
+
+// The OrderChannel class carries the orders of one strategy to the order router, and their fills back.
+// It is a pair of preallocated SpscRings: the strategy's thread writes order intents and reads fills, the
+// router's thread reads intents and writes fills. Neither side allocates, locks or waits: a strategy
+// that submits into a full channel gets false back and the order is counted as rejected.
+class OrderChannel {
+public:
+    // Constructor that allocates room for `capacity` pending intents and as many pending fills.
+    explicit OrderChannel(std::size_t capacity = config::ORDER_CHANNEL_CAPACITY)
+        : intents_(capacity), fills_(capacity) {}
+
+    OrderChannel(const OrderChannel&) = delete;
+    OrderChannel& operator=(const OrderChannel&) = delete;
+
+    // Strategy: queue an order. Its id is assigned here and returned through `intent.orderId`.
+    // Returns false if the channel is full.
+    bool submit(OrderIntent& intent) {
+        intent.orderId = nextOrderId_ + 1;
+        if (!intents_.tryPush(intent)) {
+            rejected_.store(rejected_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        ++nextOrderId_;
+        return true;
+    }
+
+    // Router: hand up to `maxCount` queued intents to `handler(const OrderIntent&)`.
+    // Returns the number of intents handled.
+    template <typename Handler>
+    std::size_t drainIntents(Handler&& handler, std::size_t maxCount = std::numeric_limits<std::size_t>::max()) {
+        return intents_.drain(handler, maxCount);
+    }
+
+    // Router: report a fill to the strategy. Returns false, and counts the fill as lost, if the strategy
+    // has too many unread fills.
+    bool reportFill(const Fill& fill) {
+        if (!fills_.tryPush(fill)) {
+            lostFills_.store(lostFills_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    // Router: send the queued intents through `router(const OrderIntent&)`, which returns true if the order
+    // was executed, and report the executed ones as fills at the order's price, stamped with TscClock.
+    // Returns the number of intents routed.
+    template <typename Router>
+    std::size_t route(Router&& router) {
+        return intents_.drain([this, &router](const OrderIntent& intent) {
+            if (!router(intent)) {
+                return;
+            }
+            Fill fill;
+            fill.timestamp = TscClock::now();
+            fill.triggerTimestamp = intent.triggerTimestamp;
+            fill.instrumentId = intent.instrumentId;
+            fill.orderId = intent.orderId;
+            fill.quantity = intent.quantity;
+            fill.price = intent.price;
+            fill.tickSize = intent.tickSize;
+            reportFill(fill);
+        });
+    }
+
+    // Strategy: hand the fills reported so far to `handler(const Fill&)`. Returns the number of fills.
+    template <typename Handler>
+    std::size_t deliverFills(Handler&& handler) {
+        return fills_.drain(handler);
+    }
+
+    // Number of orders that did not fit into the channel.
+    std::uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+    // Number of fills that did not fit into the channel.
+    std::uint64_t lostFills() const { return lostFills_.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<OrderIntent> intents_;
+    SpscRing<Fill> fills_;
+    std::uint64_t nextOrderId_ = 0;            // Written by the strategy's thread only
+    std::atomic<std::uint64_t> rejected_{0};   // Written by the strategy's thread
+    std::atomic<std::uint64_t> lostFills_{0};  // Written by the router's thread
+};
+
+#endif // ORDER_CHANNEL_H
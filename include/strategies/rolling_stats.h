@@ -0,0 +1,88 @@
+#ifndef ROLLING_STATS_H
+#define ROLLING_STATS_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../config/settings.h"
+
+// The RollingStats class keeps the mean and variance of the last `window` values of a series, and an
+// exponentially weighted moving average of all of them.
+// The values live in a ring buffer. Adding one updates the mean and the sum of squared deviations with
+// Welford's method, adapted to a sliding window: the new value enters and the oldest one leaves in a
+// constant number of operations, whatever the window length. Every time the ring wraps around, the two
+// sums are recomputed from the stored values, so the rounding error of the sliding updates cannot build
+// up over a long series (one extra pass per `window` values).
+class RollingStats {
+public:
+    // Constructor for a window of `window` values. The EWMA weight defaults to 2 / (window + 1), which
+    // gives it the same center of mass as the window. Throws std::runtime_error if the window is empty.
+    explicit RollingStats(std::size_t window = config::MEAN_REVERSION_STRATEGY_PERIOD, double ewmaAlpha = 0.0);
+
+    // Add a value, pushing the oldest one out once the window is full.
+    void add(double value) {
+        if (count_ < values_.size()) {
+            ++count_;
+            const double delta = value - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            m2_ += delta * (value - mean_);
+        } else {
+            const double oldest = values_[next_];
+            const double oldMean = mean_;
+            mean_ += (value - oldest) / static_cast<double>(count_);
+            m2_ += (value - oldest) * (value - mean_ + oldest - oldMean);
+        }
+        values_[next_] = value;
+        if (++next_ == values_.size()) {
+            next_ = 0;
+            refresh();
+        }
+        ewma_ = added_++ == 0 ? value : ewma_ + alpha_ * (value - ewma_);
+    }
+
+    // Length of the window.
+    std::size_t window() const { return values_.size(); }
+
+    // Number of values in the window.
+    std::size_t count() const { return count_; }
+
+    // Check whether the window is full.
+    bool full() const { return count_ == values_.size(); }
+
+    // Mean of the values in the window (0 if there are none).
+    double mean() const { return mean_; }
+
+    // Sample variance of the values in the window (0 with fewer than two values).
+    double variance() const { return count_ > 1 && m2_ > 0.0 ? m2_ / static_cast<double>(count_ - 1) : 0.0; }
+
+    // Sample standard deviation of the values in the window.
+    double stddev() const { return std::sqrt(variance()); }
+
+    // Number of standard deviations between a value and the mean (0 if the values do not vary).
+    double zScore(double value) const {
+        const double deviation = stddev();
+        return deviation > 0.0 ? (value - mean_) / deviation : 0.0;
+    }
+
+    // Exponentially weighted moving average of every value added (0 before the first one).
+    double ewma() const { return ewma_; }
+
+    // Forget all values.
+    void reset();
+
+private:
+    // Recompute the mean and the squared deviations of the full window.
+    void refresh();
+
+    std::vector<double> values_;  // Ring buffer of the window
+    std::size_t next_ = 0;        // Slot of the next value (the oldest one once full)
+    std::size_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;             // Sum of squared deviations from the mean
+    double alpha_;
+    double ewma_ = 0.0;
+    std::uint64_t added_ = 0;     // Values added since the last reset
+};
+
+#endif // ROLLING_STATS_H
@@ -2,35 +2,71 @@
 #define SCALPING_STRATEGY_H
 
 #include "base_strategy.h"
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <atomic>  // Добавлено для атомарных операций
+#include "../config/settings.h"
 
 // ScalpingStrategy is a derived class from BaseStrategy.
-// This class implements a simple scalping strategy where trades are triggered
-// based on a predefined threshold. It provides methods to configure, execute, and analyze the strategy.
+// This class implements a top-of-book scalping strategy. When the market is tight (spread at most
+// `maxSpreadTicks`) and the quantity at the best prices leans to one side by at least `imbalancePercent`,
+// it trades in the direction of the heavier side, crossing the spread. The position is closed once it
+// gains `takeProfitTicks`, loses `stopLossTicks`, or the imbalance turns against it.
+//
+// Every price is an integer number of ticks, as delivered in BookUpdate, and the imbalance test is
+// done with cross-multiplied integers. The decision path has no floating point, so a backtest and a
+// live run that see the same book make the same decisions, bit for bit.
 class ScalpingStrategy : public BaseStrategy {
 public:
     // Configure the scalping strategy with necessary parameters.
-    // This method allows the strategy to be configured via a string (e.g., JSON or CSV format).
-    // For now, this is a placeholder and can be extended to parse and apply actual configuration settings.
+    // The configuration is a list of "key=value" pairs separated by spaces, commas or semicolons, with
+    // the keys spread, imbalance, take_profit, stop_loss and quantity (prices in ticks, imbalance in
+    // percent). Words without '=' are ignored. Throws std::runtime_error on an unknown key or a value
+    // that is not a non-negative integer.
     void configure(const std::string& config) override;
 
     // Execute the scalping strategy.
-    // This method contains the core logic for the scalping strategy. In this example, it simply increments
-    // the number of executed trades, but in a real-world scenario, it would analyze market data
-    // and execute trades based on predefined rules.
+    // This method records a manual trade execution by incrementing the number of trades executed.
     void execute() override;
 
+    // Decide on a new top of book: enter, exit or do nothing.
+    void onBookUpdate(const BookUpdate& update) override;
+
+    // Update the position of the instrument with the fill.
+    void onFill(const Fill& fill) override;
+
+    // Filled position of an instrument.
+    std::int64_t position(InstrumentId instrumentId) const {
+        return instrumentId < instruments_.size() ? instruments_[instrumentId].position : 0;
+    }
+
     // Analyze the results of the scalping strategy.
     // This method provides a summary of the trades executed by the scalping strategy,
     // returning a string that describes the results.
     std::string analyzeResults() const override;
 
 private:
-    // Example threshold for triggering trades.
-    // This value would normally be used in the logic that decides whether a trade should be executed.
-    double threshold_ = 0.01;
+    // State of the strategy in one instrument.
+    struct InstrumentState {
+        std::int64_t target = 0;    // Position the strategy has sent orders for
+        PriceTicks entryPrice = 0;  // Price of the order that opened the target position
+        std::int64_t position = 0;  // Filled position
+    };
+
+    // Send an order moving the target position of an instrument to `wanted`, crossing the spread.
+    void trade(const BookUpdate& update, InstrumentState& state, std::int64_t wanted);
+
+    // Entry and exit parameters, in ticks (imbalance in percent).
+    std::int64_t maxSpreadTicks_ = config::SCALPING_STRATEGY_THRESHOLD;
+    std::int64_t imbalancePercent_ = config::SCALPING_IMBALANCE_PERCENT;
+    std::int64_t takeProfitTicks_ = config::SCALPING_TAKE_PROFIT_TICKS;
+    std::int64_t stopLossTicks_ = config::SCALPING_STOP_LOSS_TICKS;
+    std::int64_t quantity_ = config::SCALPING_ORDER_QUANTITY;
+
+    // State per instrument, indexed by instrument id. It grows the first time an instrument is seen.
+    std::vector<InstrumentState> instruments_;
 
     // Counter for the number of trades executed.
     std::atomic<int> tradesExecuted_{0};  // Используем атомарную переменную
@@ -0,0 +1,195 @@
+#ifndef STATIC_STRATEGY_MANAGER_H
+#define STATIC_STRATEGY_MANAGER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "base_strategy.h"
+#include "latency_stats.h"
+#include "order_channel.h"
+#include "tsc_clock.h"
+
+// The StaticStrategyManager class runs a set of strategies fixed at compile time.
+// It is the counterpart of StrategyManager for production configurations, where the strategies are
+// known when the system is built. The strategies are stored by value in a tuple instead of behind
+// shared pointers, and every call goes through a fold expression over the pack to a member of the
+// concrete type, so there is no virtual call, no reference counting and nothing stops the compiler from
+// inlining the strategies into the hot loop. Declare the strategies `final` so that the calls they make
+// to their own virtual methods are resolved statically as well.
+//
+// Market data batches are decoded into events once and each event goes to every strategy, row by row.
+// A strategy that overrides onBatch() still receives the whole batch instead.
+//
+// All strategies run serially on the caller's thread. Each strategy gets its own OrderChannel, routed
+// by routeOrders() as in StrategyManager.
+template <typename... Strategies>
+class StaticStrategyManager {
+    static_assert(sizeof...(Strategies) > 0, "StaticStrategyManager needs at least one strategy");
+    static_assert((std::is_base_of_v<BaseStrategy, Strategies> && ...),
+                  "StaticStrategyManager strategies must derive from BaseStrategy");
+
+public:
+    // Number of strategies in the set.
+    static constexpr std::size_t kSize = sizeof...(Strategies);
+
+    // Constructor that default-constructs every strategy.
+    StaticStrategyManager() { connect(kIndices); }
+
+    // Constructor that takes the strategies, already configured, by value.
+    explicit StaticStrategyManager(Strategies... strategies) : strategies_(std::move(strategies)...) {
+        connect(kIndices);
+    }
+
+    // The strategies point to the manager's order channels, so the manager stays where it was built.
+    StaticStrategyManager(const StaticStrategyManager&) = delete;
+    StaticStrategyManager& operator=(const StaticStrategyManager&) = delete;
+
+    // Strategy at a position of the pack.
+    template <std::size_t I>
+    auto& strategy() { return std::get<I>(strategies_); }
+
+    // Strategy of a type (the type must appear once in the pack).
+    template <typename S>
+    S& strategy() { return std::get<S>(strategies_); }
+
+    // Execute all strategies once, in pack order.
+    void executeStrategies() {
+        std::apply([](auto&... strategies) { (strategies.execute(), ...); }, strategies_);
+    }
+
+    // Execute all strategies over a batch of processed market data.
+    // Pending fills are delivered first. Strategies with their own onBatch() get the batch; the events of
+    // the others are decoded once and passed to each of them in turn. The whole call is timed (batchTime()).
+    void executeStrategies(const TickBatch& batch) {
+        const std::uint64_t start = TscClock::cycles();
+        deliverFills(kIndices);
+        std::apply([&batch](auto&... strategies) { (runBatch(strategies, batch), ...); }, strategies_);
+        if constexpr ((!overridesOnBatch<Strategies>() || ...)) {
+            decodeEvents(
+                batch, tickSizes_,
+                [this](const BookUpdate& update) {
+                    std::apply([&update](auto&... strategies) { (bookUpdate(strategies, update), ...); },
+                               strategies_);
+                },
+                [this](const Trade& trade) {
+                    std::apply([&trade](auto&... strategies) { (tradeUpdate(strategies, trade), ...); },
+                               strategies_);
+                });
+        }
+        batchTime_.add(TscClock::toNanos(TscClock::cycles() - start));
+    }
+
+    // Deliver completed bars to all strategies, one bar at a time.
+    void executeStrategies(std::span<const Bar> bars) {
+        for (const Bar& bar : bars) {
+            std::apply([&bar](auto&... strategies) { (callOnBar(strategies, bar), ...); }, strategies_);
+        }
+    }
+
+    // Deliver a timer event to all strategies, after their pending fills.
+    void executeTimers(const TimerEvent& timer) {
+        deliverFills(kIndices);
+        std::apply([&timer](auto&... strategies) { (callOnTimer(strategies, timer), ...); }, strategies_);
+    }
+
+    // Send the orders the strategies submitted through `router(const OrderIntent&)`, which returns true
+    // if the order was executed, and hand the executed ones back to their strategy as fills.
+    // Returns the number of orders routed.
+    template <typename Router>
+    std::size_t routeOrders(Router&& router) {
+        std::size_t routed = 0;
+        for (OrderChannel& channel : channels_) {
+            routed += channel.route(router);
+        }
+        deliverFills(kIndices);
+        return routed;
+    }
+
+    // Order channel of the strategy at a position of the pack.
+    OrderChannel& orderChannel(std::size_t strategy) { return channels_[strategy]; }
+
+    // Use the tick sizes of the registry's instruments to express prices in ticks.
+    void setInstruments(const InstrumentRegistry& registry) {
+        tickSizes_.resize(registry.size());
+        for (InstrumentId id = 0; id < registry.size(); ++id) {
+            tickSizes_[id] = registry.info(id).tickSize;
+        }
+        std::apply([&registry](auto&... strategies) { (strategies.setInstruments(registry), ...); }, strategies_);
+    }
+
+    // Union of the market data columns required by the strategies.
+    TickColumnMask requiredColumns() const {
+        return std::apply([](const auto&... strategies) { return (strategies.requiredColumns() | ...); },
+                          strategies_);
+    }
+
+    // Time spent in executeStrategies(batch), one sample per batch.
+    const LatencyStats& batchTime() const { return batchTime_; }
+
+private:
+    static constexpr auto kIndices = std::index_sequence_for<Strategies...>{};
+
+    // Check whether a strategy type provides its own onBatch(). If it does not, `&S::onBatch` names the
+    // member of BaseStrategy.
+    template <typename S>
+    static constexpr bool overridesOnBatch() {
+        return !std::is_same_v<decltype(&S::onBatch), void (BaseStrategy::*)(const TickBatch&)>;
+    }
+
+    // The calls below name the member of the concrete type, which turns off virtual dispatch.
+
+    template <typename S>
+    static void runBatch(S& strategy, const TickBatch& batch) {
+        if constexpr (overridesOnBatch<S>()) {
+            strategy.S::onBatch(batch);
+        }
+    }
+
+    template <typename S>
+    static void bookUpdate(S& strategy, const BookUpdate& update) {
+        if constexpr (!overridesOnBatch<S>()) {
+            strategy.S::onBookUpdate(update);
+        }
+    }
+
+    template <typename S>
+    static void tradeUpdate(S& strategy, const Trade& trade) {
+        if constexpr (!overridesOnBatch<S>()) {
+            strategy.S::onTrade(trade);
+        }
+    }
+
+    template <typename S>
+    static void callOnBar(S& strategy, const Bar& bar) { strategy.S::onBar(bar); }
+
+    template <typename S>
+    static void callOnTimer(S& strategy, const TimerEvent& timer) { strategy.S::onTimer(timer); }
+
+    // Connect every strategy to its order channel.
+    template <std::size_t... Is>
+    void connect(std::index_sequence<Is...>) {
+        (std::get<Is>(strategies_).setOrderChannel(&channels_[Is]), ...);
+    }
+
+    // Hand every strategy the fills waiting in its channel.
+    template <std::size_t... Is>
+    void deliverFills(std::index_sequence<Is...>) {
+        (channels_[Is].deliverFills([this](const Fill& fill) {
+            auto& strategy = std::get<Is>(strategies_);
+            using S = std::remove_reference_t<decltype(strategy)>;
+            strategy.S::onFill(fill);
+        }), ...);
+    }
+
+    std::tuple<Strategies...> strategies_;
+    std::array<OrderChannel, kSize> channels_;  // Parallel to the pack
+    std::vector<double> tickSizes_;             // Indexed by instrument id
+    LatencyStats batchTime_;
+};
+
+#endif // STATIC_STRATEGY_MANAGER_H
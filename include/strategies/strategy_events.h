@@ -0,0 +1,127 @@
+#ifndef STRATEGY_EVENTS_H
+#define STRATEGY_EVENTS_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "tick_batch.h"
+#include "../common.h"
+#include "../config/settings.h"
+
+// Typed events exchanged between the trading system and the strategies.
+// Events are plain structs, filled in place by the caller (on the stack or in a preallocated slot) and
+// handed to the strategy callbacks by const reference, so delivering them never allocates.
+// Prices are fixed-point: a whole number of ticks of the instrument (price / tick size). Each event carries
+// the tick size it was expressed with, so a strategy can convert back with toPrice() when it needs to.
+
+// Price expressed as a number of instrument ticks.
+using PriceTicks = std::int64_t;
+
+// Convert a price to ticks, rounding to the nearest tick.
+inline PriceTicks toTicks(double price, double tickSize) {
+    return static_cast<PriceTicks>(std::llround(price / tickSize));
+}
+
+// Convert a number of ticks back to a price.
+inline double toPrice(PriceTicks ticks, double tickSize) {
+    return static_cast<double>(ticks) * tickSize;
+}
+
+// New top of book of an instrument.
+struct BookUpdate {
+    std::int64_t timestamp = 0;         // Event time in nanoseconds since the Unix epoch
+    std::int64_t receiveTimestamp = 0;  // Local receive time (zero for historical data)
+    InstrumentId instrumentId = 0;
+    PriceTicks bidPrice = 0;            // Best bid, in ticks
+    PriceTicks askPrice = 0;            // Best ask, in ticks
+    std::int64_t bidSize = 0;           // Quantity at the best bid
+    std::int64_t askSize = 0;           // Quantity at the best ask
+    double tickSize = 0.0;              // Tick size the prices are expressed in
+};
+
+// Trade printed on the market.
+struct Trade {
+    std::int64_t timestamp = 0;
+    std::int64_t receiveTimestamp = 0;
+    InstrumentId instrumentId = 0;
+    PriceTicks price = 0;               // Trade price, in ticks
+    std::int64_t quantity = 0;          // Traded quantity
+    double tickSize = 0.0;
+};
+
+// Order the strategy wants to send, written into its OrderChannel.
+struct OrderIntent {
+    InstrumentId instrumentId = 0;
+    std::int64_t quantity = 0;          // Positive buys, negative sells
+    PriceTicks price = 0;               // Limit price, in ticks
+    double tickSize = 0.0;              // Tick size the price is expressed in
+    std::int64_t triggerTimestamp = 0;  // Receive timestamp of the data that triggered the order (0 if none)
+    std::uint64_t orderId = 0;          // Assigned by the channel, unique per strategy
+};
+
+// Execution of one of the strategy's orders.
+struct Fill {
+    std::int64_t timestamp = 0;         // Time of the fill (TscClock::now())
+    std::int64_t triggerTimestamp = 0;  // Copied from the order
+    InstrumentId instrumentId = 0;
+    std::uint64_t orderId = 0;          // Id of the filled order
+    std::int64_t quantity = 0;          // Filled quantity, positive for a buy
+    PriceTicks price = 0;               // Fill price, in ticks
+    double tickSize = 0.0;
+};
+
+// Periodic wake-up, delivered whether or not market data arrived.
+struct TimerEvent {
+    std::int64_t timestamp = 0;         // Time the timer fired, in nanoseconds since the Unix epoch
+};
+
+// Tick size of an instrument in a table indexed by instrument id.
+// Instruments past the end of the table use config::DEFAULT_TICK_SIZE.
+inline double tickSizeOf(std::span<const double> tickSizes, InstrumentId instrumentId) {
+    return instrumentId < tickSizes.size() ? tickSizes[instrumentId] : config::DEFAULT_TICK_SIZE;
+}
+
+// Turn every row of a batch into a BookUpdate passed to `onBookUpdate`, followed by a Trade passed to
+// `onTrade` if the row has a trade quantity. Prices are converted to ticks with `tickSizes`.
+// The two events live on the stack and are refilled for each row, so the loop does not allocate.
+template <typename OnBookUpdate, typename OnTrade>
+void decodeEvents(const TickBatch& batch, std::span<const double> tickSizes, OnBookUpdate&& onBookUpdate,
+                  OnTrade&& onTrade) {
+    const auto timestamps = batch.timestamps();
+    const auto receiveTimestamps = batch.receiveTimestamps();
+    const auto instrumentIds = batch.instrumentIds();
+    const auto bidPrices = batch.bidPrices();
+    const auto askPrices = batch.askPrices();
+    const auto bidSizes = batch.bidSizes();
+    const auto askSizes = batch.askSizes();
+    const auto tradePrices = batch.tradePrices();
+    const auto tradeQuantities = batch.tradeQuantities();
+
+    BookUpdate update;
+    Trade trade;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const double tickSize = tickSizeOf(tickSizes, instrumentIds[i]);
+        update.timestamp = timestamps[i];
+        update.receiveTimestamp = receiveTimestamps[i];
+        update.instrumentId = instrumentIds[i];
+        update.bidPrice = toTicks(bidPrices[i], tickSize);
+        update.askPrice = toTicks(askPrices[i], tickSize);
+        update.bidSize = bidSizes[i];
+        update.askSize = askSizes[i];
+        update.tickSize = tickSize;
+        onBookUpdate(static_cast<const BookUpdate&>(update));
+
+        if (tradeQuantities[i] != 0) {
+            trade.timestamp = timestamps[i];
+            trade.receiveTimestamp = receiveTimestamps[i];
+            trade.instrumentId = instrumentIds[i];
+            trade.price = toTicks(tradePrices[i], tickSize);
+            trade.quantity = tradeQuantities[i];
+            trade.tickSize = tickSize;
+            onTrade(static_cast<const Trade&>(trade));
+        }
+    }
+}
+
+#endif // STRATEGY_EVENTS_H
@@ -1,25 +1,137 @@
 #ifndef STRATEGY_MANAGER_H
 #define STRATEGY_MANAGER_H
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <span>
+#include <thread>
 #include "base_strategy.h"
+#include "conflating_buffer.h"
+#include "latency_stats.h"
+#include "multicast_ring.h"
+#include "order_channel.h"
 
 // Class that manages a collection of trading strategies.
 // This class allows adding, executing, and clearing a group of trading strategies.
 // It acts as a central controller to manage multiple strategy instances.
+//
+// By default market data batches are delivered serially: every strategy sees every tick, and a slow
+// strategy delays all the others. In conflated mode each strategy runs on its own thread and reads from
+// its own ConflatingBuffer. executeStrategies() only publishes the latest state of each instrument and
+// returns. A strategy that keeps up sees every update; one that falls behind gets the most recent state
+// of each instrument that changed, instead of an ever-growing queue. The others are not affected.
+//
+// In multicast mode each strategy also runs on its own thread, and batches reach them through a
+// MulticastRing: executeStrategies() copies the batch into one slot and every strategy reads that slot in
+// place, with its own cursor. Every strategy sees every batch, and adding a strategy adds a consumer
+// without touching the threads already running. The caller only waits if the slowest strategy falls a
+// whole ring (config::MULTICAST_RING_CAPACITY batches) behind. This is the mode for live trading; the
+// serial mode stays the deterministic one for backtests.
+//
+// The time every strategy spends in onBatch() is measured with TscClock in every mode (strategyTime()).
+//
+// Every strategy gets its own OrderChannel when it is added. routeOrders() collects the orders the
+// strategies submitted and reports the ones the router accepted back as fills. A strategy always receives
+// its fills on the thread that runs it: at once in serial mode, before its next batch in the threaded modes.
 class StrategyManager {
 public:
+    // How market data batches reach the strategies.
+    enum class DeliveryMode {
+        Serial,    // Every strategy runs over every batch on the caller's thread
+        Conflated, // Every strategy runs on its own thread over the latest state per instrument
+        Multicast  // Every strategy runs on its own thread over every batch, read in place from a shared ring
+    };
+
+    StrategyManager() = default;
+
+    // Stops the strategy threads of the threaded modes.
+    ~StrategyManager();
+
+    StrategyManager(const StrategyManager&) = delete;
+    StrategyManager& operator=(const StrategyManager&) = delete;
+
+    // Switch the delivery mode. Entering the conflated or multicast mode starts one thread per strategy;
+    // leaving it delivers what is still pending and stops them.
+    // Throws std::runtime_error, and stays in serial mode, if the multicast ring has no cursor left for
+    // every strategy (config::MULTICAST_RING_MAX_CONSUMERS).
+    void setDeliveryMode(DeliveryMode mode);
+
+    // Current delivery mode.
+    DeliveryMode deliveryMode() const { return mode_; }
+
+    // Set how strategy threads wait for batches in multicast mode. Takes effect the next time the
+    // multicast mode is entered.
+    void setWaitStrategy(WaitStrategy wait) { waitStrategy_ = wait; }
+
+    // Wait strategy of the multicast mode.
+    WaitStrategy waitStrategy() const { return waitStrategy_; }
+
+    // Wait until every strategy thread has processed everything published so far (threaded modes only).
+    void waitUntilIdle();
+
+    // Number of updates a strategy skipped because newer ones replaced them (conflated mode only).
+    std::uint64_t conflatedUpdates(std::size_t strategy) const;
+
+    // Number of updates a strategy never received because their instrument id did not fit into its
+    // buffer (conflated mode only). The buffers hold config::CONFLATION_MAX_INSTRUMENTS instruments, or
+    // every instrument of the registry given to setInstruments() if there are more.
+    std::uint64_t droppedUpdates(std::size_t strategy) const;
+
+    // Time spent by a strategy in onBatch(), one sample per batch. In the threaded modes call waitUntilIdle()
+    // first.
+    LatencyStats strategyTime(std::size_t strategy) const;
+
     // Add a new strategy to the manager.
     // The strategy is passed as a shared pointer, allowing for efficient memory management.
     // Strategies can be dynamically added and managed without worrying about manual memory cleanup.
+    // In multicast mode this throws std::runtime_error, without adding the strategy, once the ring has no
+    // cursor left for it.
     void addStrategy(std::shared_ptr<BaseStrategy> strategy);
 
     // Execute all registered strategies.
     // This function iterates through all stored strategies and calls their `execute` method.
     // This allows multiple strategies to be run in sequence.
+    // In the threaded modes this first waits until the strategy threads are idle.
     void executeStrategies();
 
+    // Execute all registered strategies over a batch of processed market data.
+    // Each strategy receives the same batch by const reference through its `onBatch` method.
+    // In the threaded modes the batch is published to the strategy threads instead, and the call does not
+    // wait for them.
+    void executeStrategies(const TickBatch& batch);
+
+    // Deliver completed bars to all registered strategies.
+    // Each bar goes to every strategy through its `onBar` method, in the order the bars were completed.
+    // In the threaded modes this first waits until the strategy threads are idle.
+    void executeStrategies(std::span<const Bar> bars);
+
+    // Deliver a timer event to all registered strategies through their `onTimer` method.
+    // In the threaded modes this first waits until the strategy threads are idle, and then calls the
+    // strategies from the caller's thread.
+    void executeTimers(const TimerEvent& timer);
+
+    // Send the orders the strategies submitted through `router(const OrderIntent&)`, which returns true
+    // if the order was executed. Executed orders are reported back to their strategy as fills, at the
+    // order's price. May be called from any one thread, concurrently with the strategy threads.
+    // Returns the number of orders routed.
+    template <typename Router>
+    std::size_t routeOrders(Router&& router);
+
+    // Order channel of a strategy.
+    OrderChannel& orderChannel(std::size_t strategy) { return *channels_[strategy]; }
+
+    // Number of orders the strategies submitted into a full order channel.
+    std::uint64_t rejectedOrders() const;
+
+    // Use the tick sizes of the registry's instruments for every strategy, including the ones added
+    // later. The registry must outlive the manager. Call it while the strategies are not running.
+    void setInstruments(const InstrumentRegistry& registry);
+
+    // Union of the market data columns required by the registered strategies.
+    TickColumnMask requiredColumns() const;
+
     // Remove all strategies from the manager.
     // This clears the internal vector, removing all registered strategies and freeing the associated resources.
     void clearStrategies();
@@ -29,6 +141,70 @@ private:
     // The vector holds shared pointers to BaseStrategy objects, allowing multiple strategies
     // to coexist and be managed dynamically.
     std::vector<std::shared_ptr<BaseStrategy>> strategies_;
+
+    // Order channel of each strategy, parallel to strategies_.
+    std::vector<std::unique_ptr<OrderChannel>> channels_;
+
+    // Reference data used to express prices in ticks (may be null).
+    const InstrumentRegistry* instruments_ = nullptr;
+
+    // Time spent in onBatch() by each strategy on the caller's thread, parallel to strategies_.
+    std::vector<LatencyStats> strategyTimes_;
+
+    // A strategy's thread and what it reads from: its own buffer in conflated mode, its cursor on the
+    // shared ring in multicast mode.
+    struct Worker {
+        std::shared_ptr<BaseStrategy> strategy;
+        OrderChannel* orders = nullptr;            // Fills are delivered from it before every batch
+        std::unique_ptr<ConflatingBuffer> buffer;  // Conflated mode only
+        std::size_t consumer = 0;                  // Ring cursor, multicast mode only
+        std::atomic<std::uint64_t> processed{0};  // Last publication generation fully delivered
+        LatencyStats time;                         // Time spent in onBatch(), written by the worker thread
+        std::thread thread;
+
+        Worker(std::shared_ptr<BaseStrategy> s, OrderChannel* o) : strategy(std::move(s)), orders(o) {}
+    };
+
+    // Start the threads of the current mode (and its ring in multicast mode) for every strategy.
+    void startWorkers();
+
+    // Start the thread of a strategy in the current threaded mode.
+    void startWorker(const std::shared_ptr<BaseStrategy>& strategy, OrderChannel* orders);
+
+    // Hand the fills waiting in a strategy's channel to the strategy.
+    static void deliverFills(BaseStrategy& strategy, OrderChannel& orders) {
+        orders.deliverFills([&strategy](const Fill& fill) { strategy.onFill(fill); });
+    }
+
+    // Stop and join every strategy thread.
+    void stopWorkers();
+
+    // Body of a strategy thread in conflated mode: wait for new publications and run the strategy over the
+    // dirty instruments.
+    void runWorker(Worker& worker);
+
+    // Body of a strategy thread in multicast mode: run the strategy over every batch of the ring.
+    void runMulticastWorker(Worker& worker, MulticastRing<TickBatch>& ring);
+
+    DeliveryMode mode_ = DeliveryMode::Serial;
+    WaitStrategy waitStrategy_ = WaitStrategy::Block;
+    std::unique_ptr<MulticastRing<TickBatch>> ring_;  // Multicast mode only
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::uint64_t> generation_{0};  // Incremented after every published batch
+    std::atomic<bool> running_{false};
 };
 
+// In serial mode the fills are handed to the strategy right away, otherwise its thread picks them up.
+template <typename Router>
+std::size_t StrategyManager::routeOrders(Router&& router) {
+    std::size_t routed = 0;
+    for (std::size_t i = 0; i < channels_.size(); ++i) {
+        routed += channels_[i]->route(router);
+        if (mode_ == DeliveryMode::Serial) {
+            deliverFills(*strategies_[i], *channels_[i]);
+        }
+    }
+    return routed;
+}
+
 #endif // STRATEGY_MANAGER_H
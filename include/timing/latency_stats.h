@@ -0,0 +1,37 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <algorithm>
+#include <cstdint>
+
+// The LatencyStats struct accumulates latency samples, in nanoseconds, taken with TscClock.
+// Recording a sample is a few additions, so a pipeline stage can keep one on its hot path. A LatencyStats
+// is owned by the thread of the stage that records into it.
+struct LatencyStats {
+    std::uint64_t count = 0;  // Number of samples
+    std::int64_t total = 0;   // Sum of the samples
+    std::int64_t max = 0;     // Largest sample
+
+    // Record one sample. Negative samples (clock skew between the stamping threads) count as 0.
+    void add(std::int64_t nanos) {
+        nanos = std::max<std::int64_t>(nanos, 0);
+        ++count;
+        total += nanos;
+        max = std::max(max, nanos);
+    }
+
+    // Add the samples of another measurement.
+    void merge(const LatencyStats& other) {
+        count += other.count;
+        total += other.total;
+        max = std::max(max, other.max);
+    }
+
+    // Average of the samples (0 if there are none).
+    double mean() const { return count == 0 ? 0.0 : static_cast<double>(total) / static_cast<double>(count); }
+
+    // Forget all samples.
+    void reset() { *this = LatencyStats{}; }
+};
+
+#endif // LATENCY_STATS_H
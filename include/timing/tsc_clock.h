@@ -0,0 +1,157 @@
+#ifndef TSC_CLOCK_H
+#define TSC_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include "../config/settings.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// The TscClock class is the time base of the whole pipeline.
+// Reading the CPU's time-stamp counter (rdtsc) takes a few nanoseconds, against tens of nanoseconds for
+// clock_gettime(), so every stage stamps its events with TscClock::now() and tick-to-trade latencies are
+// measured against one consistent clock.
+//
+// The counter is calibrated against CLOCK_MONOTONIC and CLOCK_REALTIME by calibrate(): the frequency is
+// measured over config::TSC_CALIBRATION_MILLIS, and the counter is anchored to both clocks. Programs call
+// it at the start of main(); otherwise the first reading of the clock does, and waits for it.
+// Cycles are then turned into nanoseconds with one multiplication and one shift. recalibrate() measures
+// the frequency again over the whole time since the first calibration and slews the clock towards
+// CLOCK_MONOTONIC: the remaining error is absorbed over the next config::TSC_DRIFT_CORRECTION_MILLIS by a
+// rate change of at most 500 ppm, so monotonicNow() never steps backwards. now() follows CLOCK_REALTIME,
+// steps included. startDriftCorrection() calls recalibrate() periodically on a background thread. The
+// conversion parameters are published under a sequence lock, so readers never block and never see a
+// torn update.
+//
+// The TSC is used only when the CPU reports an invariant TSC (constant rate, not stopped in deep sleep
+// states). Otherwise, or with config::TSC_CLOCK_ENABLED off, every call falls back to clock_gettime().
+class TscClock {
+public:
+    // Cycle counter for measuring durations: the TSC, or CLOCK_MONOTONIC nanoseconds when the TSC is not
+    // used. Only differences between two readings are meaningful; see toNanos().
+    static std::uint64_t cycles() {
+        return usesTsc() ? readTsc() : static_cast<std::uint64_t>(systemNanos(CLOCK_MONOTONIC));
+    }
+
+    // Raw time-stamp counter, whether or not the clock uses it (CLOCK_MONOTONIC on other architectures).
+    static std::uint64_t readTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(systemNanos(CLOCK_MONOTONIC));
+#endif
+    }
+
+    // Wall-clock time in nanoseconds since the epoch, on the CLOCK_REALTIME scale.
+    static std::int64_t now() {
+        return usesTsc() ? convert(readTsc(), true) : systemNanos(CLOCK_REALTIME);
+    }
+
+    // Monotonic time in nanoseconds, on the CLOCK_MONOTONIC scale.
+    static std::int64_t monotonicNow() {
+        return usesTsc() ? convert(readTsc(), false) : systemNanos(CLOCK_MONOTONIC);
+    }
+
+    // Duration in nanoseconds of a number of cycles (a difference between two cycles() readings taken
+    // while the clock stayed in the same mode).
+    static std::int64_t toNanos(std::uint64_t elapsedCycles) {
+        if (!usesTsc()) {
+            return static_cast<std::int64_t>(elapsedCycles);
+        }
+        return static_cast<std::int64_t>(scale(elapsedCycles, state_.multiplier.load(std::memory_order_relaxed)));
+    }
+
+    // Measure the TSC frequency over `window` and anchor the counter to the system clocks.
+    // Call it once at startup; calling it again restarts the long-term frequency measurement.
+    static void calibrate(std::chrono::milliseconds window = std::chrono::milliseconds(config::TSC_CALIBRATION_MILLIS));
+
+    // Correct the drift: refine the frequency over the time since calibrate() and slew towards the
+    // system clocks. Cheap enough to run every second.
+    static void recalibrate();
+
+    // Start a background thread that calls recalibrate() every `period`. Does nothing if it is running.
+    static void startDriftCorrection(
+        std::chrono::milliseconds period = std::chrono::milliseconds(config::TSC_DRIFT_CORRECTION_MILLIS));
+
+    // Stop the drift correction thread.
+    static void stopDriftCorrection();
+
+    // Stop using the TSC: every reading falls back to clock_gettime() until the next calibrate().
+    static void disable() { state_.enabled.store(false, std::memory_order_relaxed); }
+
+    // True if time is read from the TSC, false if it falls back to clock_gettime().
+    // Calibrates the clock if that has not been done yet.
+    static bool usesTsc() {
+        if (!state_.calibrated.load(std::memory_order_acquire)) [[unlikely]] {
+            calibrateOnce();
+        }
+        return state_.enabled.load(std::memory_order_relaxed);
+    }
+
+    // Measured TSC frequency in cycles per nanosecond (GHz), 0 if the TSC is not used.
+    static double cyclesPerNanosecond();
+
+    // Read a system clock in nanoseconds with clock_gettime().
+    static std::int64_t systemNanos(clockid_t clock) {
+        timespec time{};
+        ::clock_gettime(clock, &time);
+        return static_cast<std::int64_t>(time.tv_sec) * 1000000000LL + time.tv_nsec;
+    }
+
+private:
+    // Fixed-point shift of the cycles-to-nanoseconds multiplier.
+    static constexpr int kShift = 32;
+
+    // Conversion parameters, guarded by a sequence number that is odd while they are being updated.
+    struct State {
+        std::atomic<bool> calibrated{false};  // Set once calibrate() has run
+        std::atomic<bool> enabled{false};
+        std::atomic<std::uint32_t> sequence{0};
+        std::atomic<std::uint64_t> baseCycles{0};
+        std::atomic<std::int64_t> baseRealtime{0};
+        std::atomic<std::int64_t> baseMonotonic{0};
+        std::atomic<std::uint64_t> multiplier{0};  // Nanoseconds per cycle, scaled by 2^kShift
+    };
+
+    // Publish new conversion parameters: the counter value `cycles` corresponds to the given clock readings.
+    static void anchor(std::uint64_t cycles, std::int64_t realtime, std::int64_t monotonic, double nanosPerCycle);
+
+    // Calibrate on the first reading, unless the program did it already.
+    static void calibrateOnce();
+
+    // Multiply a cycle count by the fixed-point multiplier without overflowing 64 bits.
+    static std::uint64_t scale(std::uint64_t value, std::uint64_t multiplier) {
+        __extension__ using Wide = unsigned __int128;
+        return static_cast<std::uint64_t>(static_cast<Wide>(value) * multiplier >> kShift);
+    }
+
+    // Convert a counter reading to realtime or monotonic nanoseconds, retrying while an update is in progress.
+    static std::int64_t convert(std::uint64_t tsc, bool realtime) {
+        while (true) {
+            const std::uint32_t before = state_.sequence.load(std::memory_order_acquire);
+            if (before % 2 == 0) {
+                const std::uint64_t baseCycles = state_.baseCycles.load(std::memory_order_relaxed);
+                const std::int64_t base = realtime ? state_.baseRealtime.load(std::memory_order_relaxed)
+                                                   : state_.baseMonotonic.load(std::memory_order_relaxed);
+                const std::uint64_t multiplier = state_.multiplier.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (state_.sequence.load(std::memory_order_relaxed) == before) {
+                    // A reading taken on another core can be slightly older than the anchor.
+                    return tsc >= baseCycles ? base + static_cast<std::int64_t>(scale(tsc - baseCycles, multiplier))
+                                             : base - static_cast<std::int64_t>(scale(baseCycles - tsc, multiplier));
+                }
+            }
+        }
+    }
+
+    static State state_;
+};
+
+// Defined after the class, once State is complete.
+inline TscClock::State TscClock::state_;
+
+#endif // TSC_CLOCK_H
@@ -1,46 +1,88 @@
 #include "backtester.h"
 #include "historical_data_loader.h"
 #include <iostream>
-#include <future>  // Для асинхронного выполнения
 
 // Constructor that initializes the Backtester with the strategy manager and data processor.
 Backtester::Backtester(std::shared_ptr<StrategyManager> strategyManager, std::shared_ptr<DataProcessor> dataProcessor)
     : strategyManager_(strategyManager), dataProcessor_(dataProcessor) {}
 
 // Runs the backtest by loading historical data from the file and processing it.
-// The processed data is then used to execute the strategies.
+// The file is tokenized straight into a typed batch, which is filtered and transformed in place
+// and then handed to the strategies by reference. The columns the data processor reads are always
+// loaded, even if no strategy asks for them.
 void Backtester::runBacktest(const std::string& historicalDataFile) {
     HistoricalDataLoader loader(historicalDataFile);
 
-    // Асинхронная загрузка данных
-    auto futureRawData = std::async(std::launch::async, [&loader]() {
-        return loader.loadData();
-    });
+    TickBatch batch;
+    loader.loadBatch(batch, strategyManager_->requiredColumns() | DataProcessor::kRequiredColumns);
+    replay(batch, historicalDataFile);
+}
 
-    // Ждём загрузки данных
-    auto rawData = futureRawData.get();
+// Runs the backtest over a time range. The loader uses the file's time index to skip straight to
+// the range instead of reading the whole history.
+void Backtester::runBacktest(const std::string& historicalDataFile, std::int64_t start, std::int64_t end,
+                             const std::vector<InstrumentId>& instruments) {
+    HistoricalDataLoader loader(historicalDataFile);
 
-    // Асинхронная обработка данных
-    auto futureProcessedData = std::async(std::launch::async, [this, &rawData]() {
-        return dataProcessor_->process(rawData);
-    });
+    TickBatch batch;
+    loader.loadRange(batch, start, end, instruments,
+                     strategyManager_->requiredColumns() | DataProcessor::kRequiredColumns);
+    replay(batch, historicalDataFile);
+}
 
-    auto processedData = futureProcessedData.get();
+// Filters and transforms the batch in place and hands it to the strategies in slices of
+// config::BACKTEST_SLICE_ROWS rows. The trades go to the bar aggregator as the rows are replayed, and a
+// bar reaches the strategies as soon as it is complete: a time bar before the row whose trade closed its
+// interval, any other bar after the row that completed it. The bars still open at the end of the data are
+// flushed last, since no later trade will close them.
+// After each slice the orders the strategies submitted are filled at their limit price and reported back
+// as fills, so the order channels never fill up and the strategies see their executions as they go.
+void Backtester::replay(TickBatch& batch, const std::string& historicalDataFile) {
+    dataProcessor_->process(batch);
 
     std::cout << "Running backtest on data from file: " << historicalDataFile << std::endl;
 
-    // Параллельное выполнение стратегий на каждом наборе данных
-    std::vector<std::future<void>> futures;
-    for (const auto& data : processedData) {
-        futures.push_back(std::async(std::launch::async, [this]() {
-            strategyManager_->executeStrategies();
-        }));
-    }
+    auto fillAll = [](const OrderIntent&) { return true; };
+    std::size_t orders = 0;
+    TickBatch slice;
+    slice.reserve(config::BACKTEST_SLICE_ROWS);
+    std::vector<Bar> bars;
+    auto collect = [&bars](const Bar& bar) { bars.push_back(bar); };
+    // Run the strategies over the pending rows, then the pending bars, and route their orders.
+    auto deliver = [&]() {
+        if (!slice.empty()) {
+            strategyManager_->executeStrategies(slice);
+            slice.clear();
+        }
+        if (!bars.empty()) {
+            strategyManager_->executeStrategies(bars);
+            bars.clear();
+        }
+        orders += strategyManager_->routeOrders(fillAll);
+    };
 
-    // Ожидаем завершения всех стратегий
-    for (auto& future : futures) {
-        future.get();
+    const auto ids = batch.instrumentIds();
+    const auto timestamps = batch.timestamps();
+    const auto prices = batch.tradePrices();
+    const auto quantities = batch.tradeQuantities();
+    const bool barsCloseBeforeRow = bars_.type() == BarType::Time;
+    for (std::size_t row = 0; row < batch.size(); ++row) {
+        if (prices[row] > 0.0 && quantities[row] > 0) {
+            bars_.addTrade(ids[row], timestamps[row], prices[row], quantities[row], collect);
+        }
+        if (!bars.empty() && barsCloseBeforeRow) {
+            deliver();
+        }
+        slice.append(batch.at(row));
+        if (!bars.empty() || slice.size() == config::BACKTEST_SLICE_ROWS) {
+            deliver();
+        }
     }
+    bars_.flush(collect);
+    deliver();
+
+    std::cout << "Orders filled: " << orders << std::endl;
+    std::cout << "Orders rejected: " << strategyManager_->rejectedOrders() << std::endl;
 
     std::cout << "Backtest completed." << std::endl;
 }
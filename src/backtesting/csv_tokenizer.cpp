@@ -0,0 +1,333 @@
+#include "csv_tokenizer.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>  // For SSE2 and AVX2 intrinsics
+#define CSV_TOKENIZER_X86 1
+#endif
+
+namespace {
+
+constexpr std::size_t kBlockSize = 64;
+
+// Portable fallback: build the structural mask one byte at a time.
+std::uint64_t structuralMaskScalar(const char* block) {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < kBlockSize; ++i) {
+        if (block[i] == ',' || block[i] == '\n') {
+            mask |= std::uint64_t{1} << i;
+        }
+    }
+    return mask;
+}
+
+#ifdef CSV_TOKENIZER_X86
+// SSE2: compare four 16-byte lanes against ',' and '\n' and gather the byte masks.
+__attribute__((target("sse2")))
+std::uint64_t structuralMaskSse2(const char* block) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    std::uint64_t mask = 0;
+    for (int lane = 0; lane < 4; ++lane) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + lane * 16));
+        const __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, newline));
+        mask |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(hits))) << (lane * 16);
+    }
+    return mask;
+}
+
+// AVX2: two 32-byte compares cover the whole 64-byte block.
+__attribute__((target("avx2")))
+std::uint64_t structuralMaskAvx2(const char* block) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    const __m256i lowHits = _mm256_or_si256(_mm256_cmpeq_epi8(low, comma), _mm256_cmpeq_epi8(low, newline));
+    const __m256i highHits = _mm256_or_si256(_mm256_cmpeq_epi8(high, comma), _mm256_cmpeq_epi8(high, newline));
+    const auto lowMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(lowHits));
+    const auto highMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(highHits));
+    return static_cast<std::uint64_t>(lowMask) | (static_cast<std::uint64_t>(highMask) << 32);
+}
+#endif
+
+// Exact powers of ten used to scale parsed decimal mantissas.
+constexpr double kPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                   1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+// Parse a plain decimal number ("123", "-0.25", "105.125").
+// Mantissas that fit in 53 bits divided by an exact power of ten are correctly rounded;
+// anything else (exponents, very long values) falls back to std::from_chars.
+bool parseDecimal(std::string_view text, double& value) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    const bool negative = p != end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int fractionDigits = 0;
+    bool seenPoint = false;
+    for (; p != end; ++p) {
+        const char c = *p;
+        if (c >= '0' && c <= '9') {
+            mantissa = mantissa * 10 + static_cast<unsigned>(c - '0');
+            ++digits;
+            fractionDigits += seenPoint ? 1 : 0;
+        } else if (c == '.' && !seenPoint) {
+            seenPoint = true;
+        } else {
+            break;
+        }
+    }
+
+    if (p != end || digits == 0 || digits > 15) {
+        const auto result = std::from_chars(text.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+
+    value = static_cast<double>(mantissa) / kPowersOfTen[fractionDigits];
+    if (negative) {
+        value = -value;
+    }
+    return true;
+}
+
+// Parse a signed integer. A fractional part is truncated ("250.0" -> 250).
+template <typename Integer>
+bool parseInteger(std::string_view text, Integer& value) {
+    const char* end = text.data() + text.size();
+    const auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && (result.ptr == end || *result.ptr == '.');
+}
+
+// Lower-case a header name and trim surrounding spaces and quotes.
+std::string normalizeName(std::string_view name) {
+    while (!name.empty() && (name.front() == ' ' || name.front() == '"')) {
+        name.remove_prefix(1);
+    }
+    while (!name.empty() && (name.back() == ' ' || name.back() == '"' || name.back() == '\r')) {
+        name.remove_suffix(1);
+    }
+    std::string result(name);
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+} // namespace
+
+// Constructor that binds the requested kernel, falling back to scalar if the CPU cannot run it.
+CsvTokenizer::CsvTokenizer(Kernel kernel)
+    : kernel_(isSupported(kernel) ? kernel : Kernel::Scalar), mask_(structuralMaskScalar) {
+#ifdef CSV_TOKENIZER_X86
+    if (kernel_ == Kernel::Avx2) {
+        mask_ = structuralMaskAvx2;
+    } else if (kernel_ == Kernel::Sse2) {
+        mask_ = structuralMaskSse2;
+    }
+#endif
+}
+
+// Pick the widest kernel the CPU supports.
+CsvTokenizer::Kernel CsvTokenizer::detectKernel() {
+    if (isSupported(Kernel::Avx2)) {
+        return Kernel::Avx2;
+    }
+    if (isSupported(Kernel::Sse2)) {
+        return Kernel::Sse2;
+    }
+    return Kernel::Scalar;
+}
+
+// Query the CPU for the instruction set a kernel needs.
+bool CsvTokenizer::isSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#ifdef CSV_TOKENIZER_X86
+        case Kernel::Sse2:
+            return __builtin_cpu_supports("sse2");
+        case Kernel::Avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+// Split the document into its header line and data rows.
+std::size_t CsvTokenizer::parse(std::string_view text, TickBatch& batch) const {
+    const std::size_t headerEnd = std::min(text.find('\n'), text.size());
+    return parseRows(text.substr(0, headerEnd), text.substr(dataOffset(text)), batch);
+}
+
+// A document starts with data rather than a header if its first field is already a timestamp.
+std::size_t CsvTokenizer::dataOffset(std::string_view text) {
+    std::vector<Field> fields;
+    const std::size_t headerEnd = std::min(text.find('\n'), text.size());
+    return parseHeader(text.substr(0, headerEnd), fields) ? std::min(headerEnd + 1, text.size()) : 0;
+}
+
+// Position of the timestamp column in the header (0 if there is none).
+std::size_t CsvTokenizer::timestampColumn(std::string_view headerLine) {
+    std::vector<Field> fields;
+    parseHeader(headerLine, fields);
+    const auto it = std::find(fields.begin(), fields.end(), Field::Timestamp);
+    return it == fields.end() ? 0 : static_cast<std::size_t>(it - fields.begin());
+}
+
+// Tokenize the rows block by block. Every set bit in the structural mask terminates a field;
+// a newline additionally terminates the row.
+std::size_t CsvTokenizer::parseRows(std::string_view headerLine, std::string_view text, TickBatch& batch) const {
+    std::vector<Field> fields;
+    parseHeader(headerLine, fields);
+
+    // Size the batch from the length of the first data line so that appends rarely reallocate.
+    const std::size_t firstLineEnd = std::min(text.find('\n'), text.size());
+    const std::size_t lineLength = std::max<std::size_t>(firstLineEnd + 1, 8);
+    batch.reserve(batch.size() + text.size() / lineLength + 1);
+
+    const std::size_t initialSize = batch.size();
+    const char* data = text.data();
+    const std::size_t size = text.size();
+
+    Tick tick;
+    bool rowValid = true;
+    bool hasTimestamp = false;
+    std::size_t column = 0;
+    std::size_t fieldStart = 0;
+
+    auto endField = [&](std::size_t end) {
+        std::string_view value(data + fieldStart, end - fieldStart);
+        if (!value.empty() && value.back() == '\r') {
+            value.remove_suffix(1);
+        }
+        const Field field = column < fields.size() ? fields[column] : Field::Ignored;
+        if (field != Field::Ignored) {
+            rowValid &= parseField(field, value, tick);
+            hasTimestamp |= field == Field::Timestamp;
+        }
+        ++column;
+        fieldStart = end + 1;
+    };
+
+    auto endRow = [&]() {
+        if (rowValid && hasTimestamp) {
+            batch.append(tick);
+        }
+        tick = Tick{};
+        rowValid = true;
+        hasTimestamp = false;
+        column = 0;
+    };
+
+    // Scan whole blocks in place, then copy the tail into a zero-padded block
+    // so the kernels never read past the end of the text.
+    std::size_t base = 0;
+    char tail[kBlockSize];
+    while (base < size) {
+        std::uint64_t mask;
+        if (size - base >= kBlockSize) {
+            mask = mask_(data + base);
+        } else {
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, data + base, size - base);
+            mask = mask_(tail);
+        }
+
+        while (mask != 0) {
+            const std::size_t position = base + static_cast<std::size_t>(__builtin_ctzll(mask));
+            mask &= mask - 1;
+            endField(position);
+            if (data[position] == '\n') {
+                endRow();
+            }
+        }
+        base += kBlockSize;
+    }
+
+    // A final line without a trailing newline.
+    if (fieldStart < size) {
+        endField(size);
+        endRow();
+    }
+
+    return batch.size() - initialSize;
+}
+
+// Map header names to column roles.
+bool CsvTokenizer::parseHeader(std::string_view line, std::vector<Field>& fields) {
+    fields.clear();
+
+    // A line that starts with a timestamp is data; use the "Date,Price,Volume" layout.
+    std::int64_t timestamp = 0;
+    const std::size_t firstComma = std::min(line.find(','), line.size());
+    std::string_view first = line.substr(0, firstComma);
+    if (!first.empty() && first.back() == '\r') {
+        first.remove_suffix(1);
+    }
+    if (parseTimestamp(first, timestamp)) {
+        fields = {Field::Timestamp, Field::TradePrice, Field::TradeQuantity};
+        return false;
+    }
+
+    std::size_t pos = 0;
+    while (pos <= line.size()) {
+        const std::size_t comma = std::min(line.find(',', pos), line.size());
+        const std::string name = normalizeName(line.substr(pos, comma - pos));
+
+        Field field = Field::Ignored;
+        if (name == "date" || name == "time" || name == "timestamp" || name == "datetime") {
+            field = Field::Timestamp;
+        } else if (name == "instrument" || name == "instrument_id" || name == "symbol_id") {
+            field = Field::Instrument;
+        } else if (name == "bid" || name == "bid_price") {
+            field = Field::BidPrice;
+        } else if (name == "ask" || name == "ask_price") {
+            field = Field::AskPrice;
+        } else if (name == "bid_size" || name == "bid_qty") {
+            field = Field::BidSize;
+        } else if (name == "ask_size" || name == "ask_qty") {
+            field = Field::AskSize;
+        } else if (name == "price" || name == "trade_price" || name == "last") {
+            field = Field::TradePrice;
+        } else if (name == "volume" || name == "qty" || name == "quantity" || name == "size") {
+            field = Field::TradeQuantity;
+        }
+        fields.push_back(field);
+        pos = comma + 1;
+    }
+    return true;
+}
+
+// Parse one field into the matching Tick member.
+bool CsvTokenizer::parseField(Field field, std::string_view text, Tick& tick) {
+    switch (field) {
+        case Field::Timestamp:
+            return parseTimestamp(text, tick.timestamp);
+        case Field::Instrument:
+            return parseInteger(text, tick.instrumentId);
+        case Field::BidPrice:
+            return text.empty() || parseDecimal(text, tick.bidPrice);
+        case Field::AskPrice:
+            return text.empty() || parseDecimal(text, tick.askPrice);
+        case Field::BidSize:
+            return text.empty() || parseInteger(text, tick.bidSize);
+        case Field::AskSize:
+            return text.empty() || parseInteger(text, tick.askSize);
+        case Field::TradePrice:
+            return text.empty() || parseDecimal(text, tick.tradePrice);
+        case Field::TradeQuantity:
+            return text.empty() || parseInteger(text, tick.tradeQuantity);
+        case Field::Ignored:
+            break;
+    }
+    return true;
+}
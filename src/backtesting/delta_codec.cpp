@@ -0,0 +1,77 @@
+#include "delta_codec.h"
+#include <cstring>
+
+namespace {
+
+// Map signed deltas to unsigned values: 0, -1, 1, -2, 2 ... -> 0, 1, 2, 3, 4 ...
+inline std::uint64_t zigZagEncode(std::uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+inline std::uint64_t zigZagDecode(std::uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+constexpr std::uint64_t kContinuationBits = 0x8080808080808080ULL;
+
+} // namespace
+
+// Encode deltas as zig-zag varints. Unsigned arithmetic keeps wrap-around well defined.
+void encodeDeltaBlock(const std::int64_t* values, std::size_t count, std::vector<std::uint8_t>& out) {
+    std::uint64_t previous = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto current = static_cast<std::uint64_t>(values[i]);
+        std::uint64_t encoded = zigZagEncode(current - previous);
+        previous = current;
+
+        while (encoded >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(encoded | 0x80));
+            encoded >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(encoded));
+    }
+}
+
+// Decode a block in two passes: unpack varints, then undo zig-zag and prefix-sum.
+const std::uint8_t* decodeDeltaBlock(const std::uint8_t* in, const std::uint8_t* end, std::size_t count,
+                                     std::int64_t* out) {
+    auto* values = reinterpret_cast<std::uint64_t*>(out);
+
+    std::size_t i = 0;
+    while (i < count) {
+        // Fast path: eight one-byte varints in a row need no shifting or branching per value.
+        if (count - i >= 8 && end - in >= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, in, sizeof(word));
+            if ((word & kContinuationBits) == 0) {
+                for (int k = 0; k < 8; ++k) {
+                    values[i + k] = (word >> (8 * k)) & 0xFF;
+                }
+                in += 8;
+                i += 8;
+                continue;
+            }
+        }
+
+        std::uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            if (in == end || shift > 63) {
+                return nullptr;
+            }
+            const std::uint8_t byte = *in++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+        values[i++] = value;
+    }
+
+    for (std::size_t k = 0; k < count; ++k) {
+        values[k] = zigZagDecode(values[k]);
+    }
+    for (std::size_t k = 1; k < count; ++k) {
+        values[k] += values[k - 1];
+    }
+    return in;
+}
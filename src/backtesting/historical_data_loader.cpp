@@ -1,28 +1,155 @@
 #include "historical_data_loader.h"
+#include "csv_tokenizer.h"
+#include "tick_store.h"
+#include "time_index.h"
+#include "../config/settings.h"
 #include <fstream>
 #include <stdexcept>
 #include <iostream>
 
-// Constructor that initializes the HistoricalDataLoader with the given file name.
-HistoricalDataLoader::HistoricalDataLoader(const std::string& fileName)
-    : fileName_(fileName) {}
+// Constructor that initializes the HistoricalDataLoader with the given file name and load mode.
+HistoricalDataLoader::HistoricalDataLoader(const std::string& fileName, LoadMode mode, bool hugePages)
+    : fileName_(fileName), mode_(mode), hugePages_(hugePages) {}
 
 // Loads the data from the file.
 // Reads each line from the file and stores it in a vector, which is returned.
+// In mapped mode the lines are taken from the mapping instead of going through a stream.
 std::vector<std::string> HistoricalDataLoader::loadData() {
-    std::ifstream file(fileName_);
-    if (!file.is_open()) {
-        throw std::runtime_error("Unable to open file: " + fileName_);
-    }
-
     std::vector<std::string> data;
-    std::string line;
-    while (std::getline(file, line)) {
-        data.push_back(line);  // Store each line in the vector
+
+    if (mode_ == LoadMode::Mapped) {
+        for (std::string_view line : lines()) {
+            data.emplace_back(line);
+        }
+    } else {
+        std::ifstream file(fileName_);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open file: " + fileName_);
+        }
+
+        std::string line;
+        while (std::getline(file, line)) {
+            data.push_back(line);  // Store each line in the vector
+        }
+        file.close();
     }
 
-    file.close();
     std::cout << "Loaded " << data.size() << " data points from file: " << fileName_ << std::endl;
 
     return data;
 }
+
+// Loads the file into typed columns.
+// A tick store is copied column by column from its mapping, skipping unselected columns.
+// For CSV, in mapped mode the tokenizer runs directly over the mapping; in buffered mode the whole
+// file is read with a single call first. Either way no per-line strings are created.
+std::size_t HistoricalDataLoader::loadBatch(TickBatch& batch, TickColumnMask columns) {
+    CsvTokenizer tokenizer;
+    std::size_t loaded = 0;
+
+    if (isTickStore()) {
+        TickStoreReader reader(fileName_);
+        loaded = reader.read(batch, columns | tickColumnBit(TickColumn::Timestamp));
+    } else if (mode_ == LoadMode::Mapped) {
+        loaded = tokenizer.parse(mapping().view(), batch);
+    } else {
+        std::ifstream file(fileName_, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open file: " + fileName_);
+        }
+
+        std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        file.read(text.data(), static_cast<std::streamsize>(text.size()));
+        file.close();
+
+        loaded = tokenizer.parse(text, batch);
+    }
+
+    std::cout << "Loaded " << loaded << " ticks from file: " << fileName_ << std::endl;
+
+    return loaded;
+}
+
+// Loads a time range. Only the rows around the range are read: the index narrows the search to
+// a row range (tick store) or a byte range (CSV), and the remaining rows are filtered exactly.
+std::size_t HistoricalDataLoader::loadRange(TickBatch& batch, std::int64_t start, std::int64_t end,
+                                            const std::vector<InstrumentId>& instruments, TickColumnMask columns) {
+    const std::size_t first = batch.size();
+    columns |= tickColumnBit(TickColumn::Timestamp) | tickColumnBit(TickColumn::InstrumentId);
+
+    if (isTickStore()) {
+        TickStoreReader reader(fileName_);
+        reader.read(batch, columns, reader.lowerBound(start), reader.lowerBound(end));
+    } else {
+        const std::string_view text = mapping().view();
+        const TimeIndex index = TimeIndex::loadOrBuild(fileName_, text, config::TIME_INDEX_STRIDE);
+        const auto [begin, finish] = index.byteRange(start, end);
+
+        CsvTokenizer tokenizer;
+        tokenizer.parseRows(text.substr(0, std::min(text.find('\n'), text.size())),
+                            text.substr(begin, finish - begin), batch);
+    }
+
+    filterRange(batch, first, start, end, instruments);
+    std::cout << "Loaded " << batch.size() - first << " ticks in range from file: " << fileName_ << std::endl;
+
+    return batch.size() - first;
+}
+
+// Compacts the newly appended rows in place. The instrument set is turned into a lookup table
+// indexed by instrument id, so the check per row is a single load. Invalid ids in the set (e.g.
+// kInvalidInstrument for an unknown symbol) select nothing.
+void HistoricalDataLoader::filterRange(TickBatch& batch, std::size_t first, std::int64_t start, std::int64_t end,
+                                       const std::vector<InstrumentId>& instruments) {
+    std::vector<std::uint8_t> selected;
+    for (InstrumentId id : instruments) {
+        if (!isValidInstrument(id)) {
+            continue;
+        }
+        if (id >= selected.size()) {
+            selected.resize(id + 1, 0);
+        }
+        selected[id] = 1;
+    }
+
+    const auto timestamps = batch.timestamps();
+    const auto ids = batch.instrumentIds();
+    std::size_t kept = first;
+    for (std::size_t row = first; row < batch.size(); ++row) {
+        const bool inRange = timestamps[row] >= start && timestamps[row] < end;
+        const bool inSet = instruments.empty() || (ids[row] < selected.size() && selected[ids[row]] != 0);
+        if (inRange && inSet) {
+            if (kept != row) {
+                batch.moveRow(row, kept);
+            }
+            ++kept;
+        }
+    }
+    batch.resize(kept);
+}
+
+// Peeks at the first bytes of the file and compares them with the tick store magic.
+bool HistoricalDataLoader::isTickStore() const {
+    std::ifstream file(fileName_, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName_);
+    }
+    char magic[kTickStoreMagic.size()] = {};
+    file.read(magic, sizeof(magic));
+    return TickStoreReader::isTickStore(std::string_view(magic, static_cast<std::size_t>(file.gcount())));
+}
+
+// Returns the lines of the mapped file without copying them.
+LineRange HistoricalDataLoader::lines() {
+    return LineRange(mapping().view());
+}
+
+// Maps the file the first time it is needed. The mapping is kept for the lifetime of the loader
+// so that views handed out by lines() stay valid.
+const MappedFile& HistoricalDataLoader::mapping() {
+    if (!mapping_) {
+        mapping_ = std::make_unique<MappedFile>(fileName_, MappedFile::AccessHint::Sequential, hugePages_);
+    }
+    return *mapping_;
+}
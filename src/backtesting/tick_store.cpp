@@ -0,0 +1,397 @@
+#include "tick_store.h"
+#include "delta_codec.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+static_assert(std::endian::native == std::endian::little, "The tick store format is little endian");
+
+namespace {
+
+constexpr std::size_t kAlignment = 64;
+constexpr std::size_t kColumnCount = static_cast<std::size_t>(TickColumn::Count);
+
+// Round a file offset up to the section alignment.
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + kAlignment - 1) & ~static_cast<std::uint64_t>(kAlignment - 1);
+}
+
+// Size in bytes of one value of the given column.
+std::size_t elementSize(TickColumn column) {
+    return column == TickColumn::InstrumentId ? sizeof(std::uint32_t) : sizeof(std::int64_t);
+}
+
+// Raw bytes of one batch column.
+std::span<const std::byte> columnBytes(const TickBatch& batch, TickColumn column) {
+    switch (column) {
+        case TickColumn::Timestamp: return std::as_bytes(batch.timestamps());
+        case TickColumn::InstrumentId: return std::as_bytes(batch.instrumentIds());
+        case TickColumn::BidPrice: return std::as_bytes(batch.bidPrices());
+        case TickColumn::AskPrice: return std::as_bytes(batch.askPrices());
+        case TickColumn::BidSize: return std::as_bytes(batch.bidSizes());
+        case TickColumn::AskSize: return std::as_bytes(batch.askSizes());
+        case TickColumn::TradePrice: return std::as_bytes(batch.tradePrices());
+        case TickColumn::TradeQuantity: return std::as_bytes(batch.tradeQuantities());
+        case TickColumn::ReceiveTimestamp: return std::as_bytes(batch.receiveTimestamps());
+        case TickColumn::Count: break;
+    }
+    return {};
+}
+
+// Writable bytes of one batch column.
+std::span<std::byte> columnBytes(TickBatch& batch, TickColumn column) {
+    switch (column) {
+        case TickColumn::Timestamp: return std::as_writable_bytes(batch.timestamps());
+        case TickColumn::InstrumentId: return std::as_writable_bytes(batch.instrumentIds());
+        case TickColumn::BidPrice: return std::as_writable_bytes(batch.bidPrices());
+        case TickColumn::AskPrice: return std::as_writable_bytes(batch.askPrices());
+        case TickColumn::BidSize: return std::as_writable_bytes(batch.bidSizes());
+        case TickColumn::AskSize: return std::as_writable_bytes(batch.askSizes());
+        case TickColumn::TradePrice: return std::as_writable_bytes(batch.tradePrices());
+        case TickColumn::TradeQuantity: return std::as_writable_bytes(batch.tradeQuantities());
+        case TickColumn::ReceiveTimestamp: return std::as_writable_bytes(batch.receiveTimestamps());
+        case TickColumn::Count: break;
+    }
+    return {};
+}
+
+// Check whether a column holds prices (stored as doubles in the batch).
+bool isPriceColumn(TickColumn column) {
+    return column == TickColumn::BidPrice || column == TickColumn::AskPrice || column == TickColumn::TradePrice;
+}
+
+// Integer representation of one batch column, as stored in a compressed block.
+// Prices are scaled by 10^decimals and rounded to the nearest integer.
+std::vector<std::int64_t> columnIntegers(const TickBatch& batch, TickColumn column, double scale) {
+    std::vector<std::int64_t> values(batch.size());
+    const auto bytes = columnBytes(batch, column);
+    if (isPriceColumn(column)) {
+        const auto* prices = reinterpret_cast<const double*>(bytes.data());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = std::llround(prices[i] * scale);
+        }
+    } else if (column == TickColumn::InstrumentId) {
+        const auto ids = batch.instrumentIds();
+        std::copy(ids.begin(), ids.end(), values.begin());
+    } else {
+        std::memcpy(values.data(), bytes.data(), bytes.size());
+    }
+    return values;
+}
+
+// Check whether every price of a column survives scaling: finite and within the int64 range, with
+// headroom so that the delta between any two scaled prices fits as well.
+bool pricesFitScale(const TickBatch& batch, TickColumn column, double scale) {
+    constexpr double kLimit = 0x1p62;
+    const auto bytes = columnBytes(batch, column);
+    const auto* prices = reinterpret_cast<const double*>(bytes.data());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const double scaled = prices[i] * scale;
+        if (!std::isfinite(scaled) || std::abs(scaled) >= kLimit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Encode a column as a block directory followed by independently decodable blocks.
+std::vector<std::uint8_t> compressColumn(const std::vector<std::int64_t>& values, std::uint32_t blockRows) {
+    const std::size_t blockCount = (values.size() + blockRows - 1) / blockRows;
+    const std::size_t directoryBytes = (blockCount + 1) * sizeof(std::uint64_t);
+
+    std::vector<std::uint8_t> encoded(directoryBytes);
+    std::vector<std::uint64_t> directory(blockCount + 1);
+    for (std::size_t block = 0; block < blockCount; ++block) {
+        directory[block] = encoded.size();
+        const std::size_t first = block * blockRows;
+        encodeDeltaBlock(values.data() + first, std::min<std::size_t>(blockRows, values.size() - first), encoded);
+    }
+    directory[blockCount] = encoded.size();
+    std::memcpy(encoded.data(), directory.data(), directoryBytes);
+    return encoded;
+}
+
+// Pad the stream with zero bytes up to the given offset.
+void padTo(std::ofstream& out, std::uint64_t offset) {
+    static const char zeros[kAlignment] = {};
+    const auto position = static_cast<std::uint64_t>(out.tellp());
+    out.write(zeros, static_cast<std::streamsize>(offset - position));
+}
+
+} // namespace
+
+// Write the header, the column descriptors, every column block and the time index.
+// Compressed columns are encoded in memory first so that their sizes are known for the directory.
+void TickStoreWriter::write(const std::string& fileName, const TickBatch& batch, const TickStoreOptions& options) {
+    const auto timestamps = batch.timestamps();
+    if (!std::is_sorted(timestamps.begin(), timestamps.end())) {
+        throw std::runtime_error("Tick store rows must be ordered by timestamp: " + fileName);
+    }
+    const std::uint32_t indexStride = std::max<std::uint32_t>(options.indexStride, 1);
+    const std::uint32_t blockRows = std::max<std::uint32_t>(options.blockRows, 1);
+    const std::uint32_t priceDecimals = std::min<std::uint32_t>(options.priceDecimals, 15);
+
+    TickStoreHeader header{};
+    header.magic = kTickStoreMagic;
+    header.version = kTickStoreVersion;
+    header.columnCount = static_cast<std::uint32_t>(kColumnCount);
+    header.rowCount = batch.size();
+    header.indexStride = indexStride;
+    header.firstTimestamp = batch.empty() ? 0 : timestamps.front();
+    header.lastTimestamp = batch.empty() ? 0 : timestamps.back();
+
+    // Encode compressed columns up front. A price column with NaN, infinite or out of range values
+    // cannot be scaled to integers and is stored raw instead.
+    std::array<bool, kColumnCount> compress{};
+    std::array<std::vector<std::uint8_t>, kColumnCount> compressed;
+    if (options.compressed) {
+        const double scale = std::pow(10.0, priceDecimals);
+        for (std::size_t i = 0; i < kColumnCount; ++i) {
+            const auto column = static_cast<TickColumn>(i);
+            compress[i] = !isPriceColumn(column) || pricesFitScale(batch, column, scale);
+            if (compress[i]) {
+                compressed[i] = compressColumn(columnIntegers(batch, column, scale), blockRows);
+            }
+        }
+    }
+
+    // Lay out the column blocks after the descriptors.
+    std::array<TickStoreColumn, kColumnCount> descriptors{};
+    std::uint64_t offset = alignUp(sizeof(TickStoreHeader) + sizeof(descriptors));
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        const auto column = static_cast<TickColumn>(i);
+        descriptors[i].column = static_cast<std::uint32_t>(i);
+        descriptors[i].offset = offset;
+        if (compress[i]) {
+            descriptors[i].encoding = static_cast<std::uint32_t>(TickStoreEncoding::DeltaVarint);
+            descriptors[i].bytes = compressed[i].size();
+            descriptors[i].blockRows = blockRows;
+            descriptors[i].priceDecimals = isPriceColumn(column) ? priceDecimals : 0;
+        } else {
+            descriptors[i].bytes = batch.size() * elementSize(column);
+        }
+        offset = alignUp(offset + descriptors[i].bytes);
+    }
+
+    // One index entry every `indexStride` rows, starting with the first row.
+    std::vector<TickStoreIndexEntry> index;
+    for (std::size_t row = 0; row < batch.size(); row += indexStride) {
+        index.push_back({timestamps[row], row});
+    }
+    header.indexOffset = offset;
+    header.indexCount = index.size();
+
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Unable to create file: " + fileName);
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(descriptors.data()), sizeof(descriptors));
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        padTo(out, descriptors[i].offset);
+        if (compress[i]) {
+            out.write(reinterpret_cast<const char*>(compressed[i].data()),
+                      static_cast<std::streamsize>(compressed[i].size()));
+        } else {
+            const auto bytes = columnBytes(batch, static_cast<TickColumn>(i));
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+    }
+    padTo(out, header.indexOffset);
+    out.write(reinterpret_cast<const char*>(index.data()),
+              static_cast<std::streamsize>(index.size() * sizeof(TickStoreIndexEntry)));
+
+    if (!out) {
+        throw std::runtime_error("Failed to write tick store: " + fileName);
+    }
+}
+
+// Map the file and validate every section against the file size before exposing it. Sizes come from the
+// file, so the checks subtract from the file size instead of adding or multiplying them, which could wrap.
+TickStoreReader::TickStoreReader(const std::string& fileName)
+    : file_(fileName, MappedFile::AccessHint::Sequential) {
+    auto invalid = [&fileName](const std::string& reason) {
+        return std::runtime_error("Invalid tick store " + fileName + ": " + reason);
+    };
+
+    if (!isTickStore(file_.view()) || file_.size() < sizeof(TickStoreHeader)) {
+        throw invalid("bad magic");
+    }
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+    if (header_.version != kTickStoreVersion) {
+        throw invalid("unsupported version " + std::to_string(header_.version));
+    }
+
+    const std::uint64_t descriptorsEnd = sizeof(TickStoreHeader) + header_.columnCount * sizeof(TickStoreColumn);
+    if (header_.columnCount > kColumnCount || descriptorsEnd > file_.size()) {
+        throw invalid("bad column directory");
+    }
+
+    for (std::uint32_t i = 0; i < header_.columnCount; ++i) {
+        TickStoreColumn descriptor;
+        std::memcpy(&descriptor, file_.data() + sizeof(TickStoreHeader) + i * sizeof(TickStoreColumn),
+                    sizeof(descriptor));
+        if (descriptor.column >= kColumnCount || descriptor.offset % kAlignment != 0 ||
+            descriptor.offset > file_.size() || descriptor.bytes > file_.size() - descriptor.offset) {
+            throw invalid("bad column descriptor");
+        }
+
+        const auto column = static_cast<TickColumn>(descriptor.column);
+        const auto encoding = static_cast<TickStoreEncoding>(descriptor.encoding);
+        const char* data = file_.data() + descriptor.offset;
+        if (encoding == TickStoreEncoding::Raw) {
+            const std::size_t size = elementSize(column);
+            if (descriptor.bytes % size != 0 || descriptor.bytes / size != header_.rowCount) {
+                throw invalid("column size does not match row count");
+            }
+        } else if (encoding == TickStoreEncoding::DeltaVarint) {
+            // Every block offset must stay inside the column so decoding never leaves the mapping.
+            if (descriptor.blockRows == 0 || descriptor.priceDecimals > 15) {
+                throw invalid("bad compressed column parameters");
+            }
+            const std::uint64_t blockCount = header_.rowCount / descriptor.blockRows +
+                                             (header_.rowCount % descriptor.blockRows != 0 ? 1 : 0);
+            if (blockCount >= descriptor.bytes / sizeof(std::uint64_t)) {
+                throw invalid("truncated block directory");
+            }
+            const std::uint64_t directoryBytes = (blockCount + 1) * sizeof(std::uint64_t);
+            std::uint64_t previous = directoryBytes;
+            for (std::uint64_t block = 0; block <= blockCount; ++block) {
+                std::uint64_t blockOffset;
+                std::memcpy(&blockOffset, data + block * sizeof(std::uint64_t), sizeof(blockOffset));
+                if (blockOffset < previous || blockOffset > descriptor.bytes) {
+                    throw invalid("bad block directory");
+                }
+                previous = blockOffset;
+            }
+        } else {
+            throw invalid("unknown column encoding " + std::to_string(descriptor.encoding));
+        }
+
+        columns_[descriptor.column] = {data, descriptor.bytes, encoding, descriptor.blockRows,
+                                       descriptor.priceDecimals};
+    }
+
+    if (header_.indexOffset % alignof(TickStoreIndexEntry) != 0 || header_.indexOffset > file_.size() ||
+        header_.indexCount > (file_.size() - header_.indexOffset) / sizeof(TickStoreIndexEntry)) {
+        throw invalid("bad time index");
+    }
+    index_ = std::span<const TickStoreIndexEntry>(
+        reinterpret_cast<const TickStoreIndexEntry*>(file_.data() + header_.indexOffset), header_.indexCount);
+}
+
+// Compare the first bytes with the magic value.
+bool TickStoreReader::isTickStore(std::string_view contents) {
+    return contents.size() >= kTickStoreMagic.size() &&
+           std::memcmp(contents.data(), kTickStoreMagic.data(), kTickStoreMagic.size()) == 0;
+}
+
+// Binary search the sparse index for the last entry before `timestamp`,
+// then search the timestamps between that entry and the next one.
+std::size_t TickStoreReader::lowerBound(std::int64_t timestamp) const {
+    auto entry = std::lower_bound(index_.begin(), index_.end(), timestamp,
+                                  [](const TickStoreIndexEntry& e, std::int64_t t) { return e.timestamp < t; });
+    const std::size_t first = entry == index_.begin() ? 0 : static_cast<std::size_t>(std::prev(entry)->row);
+    const std::size_t limit = entry == index_.end() ? rowCount() : static_cast<std::size_t>(entry->row);
+
+    std::vector<std::int64_t> scratch;
+    const auto range = timestamps(first, limit, scratch);
+    return first + static_cast<std::size_t>(std::lower_bound(range.begin(), range.end(), timestamp) - range.begin());
+}
+
+// Copy the selected columns of a row range into the batch.
+// Raw columns are copied straight from the mapping; compressed columns are decoded block by block.
+std::size_t TickStoreReader::read(TickBatch& batch, TickColumnMask columns, std::size_t begin, std::size_t end) const {
+    end = std::min(end, rowCount());
+    if (begin >= end) {
+        return 0;
+    }
+
+    const std::size_t first = batch.size();
+    const std::size_t rows = end - begin;
+    batch.resize(first + rows);
+
+    std::vector<std::int64_t> scratch;
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        const auto column = static_cast<TickColumn>(i);
+        const ColumnBlock& block = columns_[i];
+        if ((columns & tickColumnBit(column)) == 0 || block.data == nullptr) {
+            continue;
+        }
+
+        const std::size_t size = elementSize(column);
+        std::byte* target = columnBytes(batch, column).data() + first * size;
+        if (block.encoding == TickStoreEncoding::Raw) {
+            std::memcpy(target, block.data + begin * size, rows * size);
+        } else if (isPriceColumn(column)) {
+            scratch.resize(rows);
+            decode(block, begin, end, scratch.data());
+            const double scale = std::pow(10.0, block.priceDecimals);
+            auto* prices = reinterpret_cast<double*>(target);
+            for (std::size_t row = 0; row < rows; ++row) {
+                prices[row] = static_cast<double>(scratch[row]) / scale;
+            }
+        } else if (column == TickColumn::InstrumentId) {
+            scratch.resize(rows);
+            decode(block, begin, end, scratch.data());
+            auto* ids = reinterpret_cast<std::uint32_t*>(target);
+            for (std::size_t row = 0; row < rows; ++row) {
+                ids[row] = static_cast<std::uint32_t>(scratch[row]);
+            }
+        } else {
+            decode(block, begin, end, reinterpret_cast<std::int64_t*>(target));
+        }
+    }
+    return rows;
+}
+
+// Decode every block overlapping [begin, end) and keep the requested rows.
+// Blocks that lie completely inside the range are decoded straight into the output.
+void TickStoreReader::decode(const ColumnBlock& block, std::size_t begin, std::size_t end, std::int64_t* out) const {
+    const auto* base = reinterpret_cast<const std::uint8_t*>(block.data);
+    std::vector<std::int64_t> partial;
+
+    for (std::size_t index = begin / block.blockRows; index * block.blockRows < end; ++index) {
+        const std::size_t blockFirst = index * block.blockRows;
+        const std::size_t blockSize = std::min<std::size_t>(block.blockRows, rowCount() - blockFirst);
+        const std::size_t copyFirst = std::max(begin, blockFirst);
+        const std::size_t copyEnd = std::min(end, blockFirst + blockSize);
+
+        std::uint64_t offsets[2];
+        std::memcpy(offsets, base + index * sizeof(std::uint64_t), sizeof(offsets));
+
+        std::int64_t* target = out + (copyFirst - begin);
+        const bool whole = copyFirst == blockFirst && copyEnd == blockFirst + blockSize;
+        if (!whole) {
+            partial.resize(blockSize);
+            target = partial.data();
+        }
+        if (decodeDeltaBlock(base + offsets[0], base + offsets[1], blockSize, target) == nullptr) {
+            throw std::runtime_error("Corrupt compressed block in tick store");
+        }
+        if (!whole) {
+            std::copy(partial.begin() + (copyFirst - blockFirst), partial.begin() + (copyEnd - blockFirst),
+                      out + (copyFirst - begin));
+        }
+    }
+}
+
+// Return timestamps for a row range, viewing them in place when the column is raw.
+std::span<const std::int64_t> TickStoreReader::timestamps(std::size_t begin, std::size_t end,
+                                                          std::vector<std::int64_t>& scratch) const {
+    const ColumnBlock& block = columns_[static_cast<std::size_t>(TickColumn::Timestamp)];
+    if (block.data == nullptr || begin >= end) {
+        return {};
+    }
+    if (block.encoding == TickStoreEncoding::Raw) {
+        return column<std::int64_t>(TickColumn::Timestamp).subspan(begin, end - begin);
+    }
+    scratch.resize(end - begin);
+    decode(block, begin, end, scratch.data());
+    return scratch;
+}
@@ -0,0 +1,165 @@
+#include "time_index.h"
+#include "csv_tokenizer.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr std::array<char, 8> kIndexMagic = {'H', 'F', 'T', 'T', 'I', 'D', 'X', '1'};
+
+// Header of the sidecar index file.
+struct IndexFileHeader {
+    std::array<char, 8> magic;
+    std::uint64_t dataSize;      // Size of the data file when the index was built
+    std::int64_t dataModified;   // Modification time of the data file (nanoseconds)
+    std::uint32_t stride;
+    std::uint32_t reserved;
+    std::uint64_t dataBegin;
+    std::uint64_t entryCount;
+};
+
+// Return the field at the given column of a CSV line.
+std::string_view fieldAt(std::string_view line, std::size_t column) {
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < column; ++i) {
+        begin = line.find(',', begin);
+        if (begin == std::string_view::npos) {
+            return {};
+        }
+        ++begin;
+    }
+    const std::size_t end = std::min(line.find(',', begin), line.size());
+    std::string_view field = line.substr(begin, end - begin);
+    if (!field.empty() && field.back() == '\r') {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+} // namespace
+
+// Reuse the sidecar file when it matches the data file; otherwise build a new index and save it.
+TimeIndex TimeIndex::loadOrBuild(const std::string& dataFileName, std::string_view text, std::uint32_t stride) {
+    struct stat info {};
+    const bool haveInfo = ::stat(dataFileName.c_str(), &info) == 0;
+    const auto dataSize = static_cast<std::uint64_t>(text.size());
+    const std::int64_t dataModified =
+        haveInfo ? static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1'000'000'000 + info.st_mtim.tv_nsec : 0;
+
+    TimeIndex index;
+    const std::string indexFile = indexFileName(dataFileName);
+    if (haveInfo && index.load(indexFile, dataSize, dataModified) && index.stride_ == stride) {
+        return index;
+    }
+
+    index = build(text, stride);
+    if (haveInfo) {
+        index.save(indexFile, dataSize, dataModified);
+    }
+    return index;
+}
+
+// Walk the rows once, sampling the timestamp of every `stride`-th row.
+TimeIndex TimeIndex::build(std::string_view text, std::uint32_t stride) {
+    TimeIndex index;
+    index.stride_ = std::max<std::uint32_t>(stride, 1);
+    index.dataBegin_ = CsvTokenizer::dataOffset(text);
+    index.dataEnd_ = text.size();
+
+    const std::size_t column = CsvTokenizer::timestampColumn(text.substr(0, std::min(text.find('\n'), text.size())));
+
+    std::size_t position = index.dataBegin_;
+    std::size_t row = 0;
+    std::size_t nextSample = 0;
+    while (position < text.size()) {
+        const std::size_t lineEnd = std::min(text.find('\n', position), text.size());
+        if (row >= nextSample) {
+            std::int64_t timestamp = 0;
+            if (parseTimestamp(fieldAt(text.substr(position, lineEnd - position), column), timestamp)) {
+                if (!index.entries_.empty() && timestamp < index.entries_.back().timestamp) {
+                    throw std::runtime_error("Historical data rows are not ordered by timestamp");
+                }
+                index.entries_.push_back({timestamp, position});
+                nextSample = row + index.stride_;
+            }
+        }
+        position = lineEnd + 1;
+        ++row;
+    }
+    return index;
+}
+
+// Start at the last indexed row before `start` and stop at the first indexed row at or after `end`.
+std::pair<std::size_t, std::size_t> TimeIndex::byteRange(std::int64_t start, std::int64_t end) const {
+    auto before = [](const Entry& entry, std::int64_t timestamp) { return entry.timestamp < timestamp; };
+
+    const auto first = std::lower_bound(entries_.begin(), entries_.end(), start, before);
+    const std::size_t begin = first == entries_.begin() ? dataBegin_ : static_cast<std::size_t>(std::prev(first)->offset);
+
+    const auto last = std::lower_bound(entries_.begin(), entries_.end(), end, before);
+    const std::size_t finish = last == entries_.end() ? dataEnd_ : static_cast<std::size_t>(last->offset);
+
+    return {begin, std::max(begin, finish)};
+}
+
+// The sidecar lives next to the data file.
+std::string TimeIndex::indexFileName(const std::string& dataFileName) {
+    return dataFileName + ".idx";
+}
+
+// Write the header followed by the raw entries. Failing to save only costs a rebuild next time.
+void TimeIndex::save(const std::string& indexFileName, std::uint64_t dataSize, std::int64_t dataModified) const {
+    IndexFileHeader header{};
+    header.magic = kIndexMagic;
+    header.dataSize = dataSize;
+    header.dataModified = dataModified;
+    header.stride = stride_;
+    header.dataBegin = dataBegin_;
+    header.entryCount = entries_.size();
+
+    std::ofstream out(indexFileName, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries_.data()),
+              static_cast<std::streamsize>(entries_.size() * sizeof(Entry)));
+    if (!out) {
+        std::cerr << "Unable to save time index: " << indexFileName << std::endl;
+    }
+}
+
+// Read and validate the sidecar file against the current data file and check every entry.
+bool TimeIndex::load(const std::string& indexFileName, std::uint64_t dataSize, std::int64_t dataModified) {
+    std::ifstream in(indexFileName, std::ios::binary);
+    IndexFileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kIndexMagic ||
+        header.dataSize != dataSize || header.dataModified != dataModified || header.dataBegin > dataSize ||
+        header.entryCount > dataSize) {
+        return false;
+    }
+
+    std::vector<Entry> entries(header.entryCount);
+    if (!in.read(reinterpret_cast<char*>(entries.data()),
+                 static_cast<std::streamsize>(entries.size() * sizeof(Entry)))) {
+        return false;
+    }
+    // The offsets are used to slice the mapped data, so a corrupt entry must not point outside of it.
+    // Offsets increase strictly and timestamps never decrease, as build() writes them.
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const bool inData = entries[i].offset >= header.dataBegin && entries[i].offset < dataSize;
+        const bool ordered = i == 0 || (entries[i].offset > entries[i - 1].offset &&
+                                        entries[i].timestamp >= entries[i - 1].timestamp);
+        if (!inData || !ordered) {
+            return false;
+        }
+    }
+
+    stride_ = header.stride;
+    dataBegin_ = static_cast<std::size_t>(header.dataBegin);
+    dataEnd_ = static_cast<std::size_t>(dataSize);
+    entries_ = std::move(entries);
+    return true;
+}
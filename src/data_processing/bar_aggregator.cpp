@@ -0,0 +1,50 @@
+#include "bar_aggregator.h"
+#include <stdexcept>
+
+// Constructor that checks the threshold. Time bars need at least one nanosecond.
+BarAggregator::BarAggregator(BarType type, double threshold)
+    : type_(type), threshold_(threshold), interval_(static_cast<std::int64_t>(threshold)) {
+    if (!(threshold > 0.0) || (type == BarType::Time && interval_ <= 0)) {
+        throw std::runtime_error("Bar threshold must be positive");
+    }
+}
+
+// Look up the open bar without creating it.
+const Bar* BarAggregator::current(InstrumentId instrumentId) const {
+    if (instrumentId >= bars_.size() || bars_[instrumentId].tickCount == 0) {
+        return nullptr;
+    }
+    return &bars_[instrumentId];
+}
+
+// Time bars are aligned to multiples of the interval since the epoch, so all instruments share boundaries.
+void BarAggregator::start(Bar& bar, InstrumentId instrumentId, std::int64_t timestamp, double price) const {
+    bar = Bar{};
+    bar.instrumentId = instrumentId;
+    bar.open = bar.high = bar.low = price;
+    if (type_ == BarType::Time) {
+        std::int64_t offset = timestamp % interval_;
+        if (offset < 0) {
+            offset += interval_;
+        }
+        bar.openTime = timestamp - offset;
+        bar.closeTime = bar.openTime + interval_;
+    } else {
+        bar.openTime = timestamp;
+    }
+}
+
+// Compare the measure of the bar type with the threshold.
+bool BarAggregator::complete(const Bar& bar) const {
+    switch (type_) {
+        case BarType::Tick:
+            return bar.tickCount >= threshold_;
+        case BarType::Volume:
+            return static_cast<double>(bar.volume) >= threshold_;
+        case BarType::Dollar:
+            return bar.dollarVolume >= threshold_;
+        case BarType::Time:
+            break;
+    }
+    return false;
+}
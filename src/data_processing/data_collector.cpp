@@ -1,44 +1,557 @@
 #include "data_collector.h"
-#include "security.h"  // Подключаем модуль безопасности для шифрования
-#include <iostream>
+#include "feed_arbitrator.h"
+#include "itch_decoder.h"
+#include "sequence_tracker.h"
+#include "tsc_clock.h"
+#include "../config/settings.h"
+#include <arpa/inet.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+#include <future>
 #include <cstring>
-#include <openssl/aes.h>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view kUdpScheme = "udp://";
+
+// Split a "udp://address:port" source into its address and port.
+void parseSource(const std::string& source, std::string& address, std::uint16_t& port) {
+    std::string_view rest(source);
+    const std::size_t colon = rest.rfind(':');
+    if (rest.substr(0, kUdpScheme.size()) != kUdpScheme || colon == std::string_view::npos || colon < kUdpScheme.size()) {
+        throw std::runtime_error("Unsupported data source (expected udp://address:port): " + source);
+    }
+    address = std::string(rest.substr(kUdpScheme.size(), colon - kUdpScheme.size()));
+
+    const std::string portText(rest.substr(colon + 1));
+    char* end = nullptr;
+    const unsigned long value = std::strtoul(portText.c_str(), &end, 10);
+    if (portText.empty() || *end != '\0' || value > 65535) {
+        throw std::runtime_error("Invalid port in data source: " + source);
+    }
+    port = static_cast<std::uint16_t>(value);
+}
+
+// Extract the software receive timestamp from a message's control data. Returns 0 if there is none.
+std::int64_t kernelTimestamp(msghdr& header) {
+    for (cmsghdr* control = CMSG_FIRSTHDR(&header); control != nullptr; control = CMSG_NXTHDR(&header, control)) {
+        if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPING) {
+            scm_timestamping stamps{};
+            std::memcpy(&stamps, CMSG_DATA(control), sizeof(stamps));
+            return static_cast<std::int64_t>(stamps.ts[0].tv_sec) * 1'000'000'000 + stamps.ts[0].tv_nsec;
+        }
+    }
+    return 0;
+}
+
+// Decoder handler that turns top-of-book and trade messages into ticks and publishes them to the ring.
+// Order-level messages are decoded but not published as ticks.
+class TickPublisher {
+public:
+    TickPublisher(SpscRing<Tick>& ring, std::int64_t receiveTimestamp)
+        : ring_(ring), receiveTimestamp_(receiveTimestamp) {}
+
+    // Publish a quote as a tick carrying the best bid and ask.
+    void onMessage(const itch::Quote& quote) {
+        Tick tick = makeTick(quote.header);
+        tick.bidPrice = toPrice(quote.bidPrice.value());
+        tick.bidSize = quote.bidSize.value();
+        tick.askPrice = toPrice(quote.askPrice.value());
+        tick.askSize = quote.askSize.value();
+        push(tick);
+    }
+
+    // Publish a trade as a tick carrying the trade price and quantity.
+    void onMessage(const itch::Trade& trade) {
+        Tick tick = makeTick(trade.header);
+        tick.tradePrice = toPrice(trade.price.value());
+        tick.tradeQuantity = trade.shares.value();
+        push(tick);
+    }
+
+    std::uint64_t published = 0;
+    std::uint64_t dropped = 0;
+
+private:
+    // Start a tick from the common message header.
+    Tick makeTick(const itch::Header& header) const {
+        Tick tick;
+        tick.timestamp = header.timestamp.value();
+        tick.instrumentId = header.locate.value();
+        tick.receiveTimestamp = receiveTimestamp_;
+        return tick;
+    }
+
+    // Convert a fixed-point wire price.
+    static double toPrice(std::int64_t price) {
+        return static_cast<double>(price) / static_cast<double>(itch::kPriceScale);
+    }
+
+    // The ring is never waited on: if the consumer falls behind, ticks are dropped and counted.
+    void push(const Tick& tick) {
+        if (ring_.tryPush(tick)) {
+            ++published;
+        } else {
+            ++dropped;
+        }
+    }
+
+    SpscRing<Tick>& ring_;
+    std::int64_t receiveTimestamp_;
+};
+
+} // namespace
+
+// Sequencing state of one channel: the A/B arbitrator (A/B feeds only), the tracker and, during
+// a recovery, the pending snapshot request.
+struct DataCollector::ChannelState {
+    std::optional<FeedArbitrator> arbitrator;
+    SequenceTracker tracker;
+    std::future<Snapshot> snapshot;
+};
 
 // Constructor to initialize the data source and set the initial collection state to false (inactive).
-DataCollector::DataCollector(const std::string& source)
-    : source_(source), collecting_(false) {}
+DataCollector::DataCollector(const std::string& source, ReceiveMode mode)
+    : collecting_(false), mode_(mode), ring_(config::FEED_RING_CAPACITY) {
+    legs_.push_back({source});
+}
+
+// Constructor for an A/B pair of redundant sources.
+DataCollector::DataCollector(const std::string& sourceA, const std::string& sourceB, ReceiveMode mode)
+    : collecting_(false), mode_(mode), ring_(config::FEED_RING_CAPACITY) {
+    legs_.push_back({sourceA});
+    legs_.push_back({sourceB});
+}
+
+// Make sure the receive thread never outlives the collector.
+DataCollector::~DataCollector() {
+    stopCollection();
+}
+
+// Set the recovery service.
+void DataCollector::setSnapshotSource(std::shared_ptr<SnapshotSource> source) {
+    snapshots_ = std::move(source);
+}
+
+// Set the capture recorder.
+void DataCollector::setCaptureRecorder(std::shared_ptr<CaptureRecorder> recorder) {
+    recorder_ = std::move(recorder);
+}
+
+// Run an external datagram through the receive path, applying any snapshot that has arrived first,
+// just as the receive loops do.
+void DataCollector::inject(const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp, std::size_t leg) {
+    if (!recovering_.empty()) {
+        pollRecoveries();
+    }
+    onDatagram(data, size, receiveTimestamp, leg < legs_.size() ? leg : 0);
+}
 
 // Start the data collection process and indicate that data is now being collected.
 void DataCollector::startCollection() {
+    if (collecting_) {
+        return;
+    }
+    try {
+        for (Leg& leg : legs_) {
+            openSocket(leg);
+            configureSocket(leg.socket);
+        }
+    } catch (...) {
+        closeSockets();
+        throw;
+    }
     collecting_ = true;
-    std::cout << "Started collecting data from source: " << source_ << std::endl;
-
-    // Пример: собираем данные (здесь мы используем строку в качестве примера)
-    std::string collected_data = "Sensitive data collected from " + source_;
+    receiver_ = mode_ == ReceiveMode::Blocking ? std::thread(&DataCollector::receiveBlocking, this)
+                                               : std::thread(&DataCollector::receiveBatched, this);
 
-    // Шифрование данных с использованием AES-256
-    uint8_t key[AES_BLOCK_SIZE] = { /* инициализируйте ваш ключ */ };
-    encryption_result_t encrypted_data;
-    int ret = aes_encrypt(reinterpret_cast<const uint8_t*>(collected_data.c_str()), collected_data.size(), key, AES_BLOCK_SIZE, &encrypted_data);
-    
-    if (ret == 0) {
-        std::cout << "Data successfully encrypted." << std::endl;
-        // Здесь вы можете использовать зашифрованные данные
-    } else {
-        std::cerr << "Encryption failed!" << std::endl;
+    if (config::FEED_HANDLER_CPU >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config::FEED_HANDLER_CPU, &cpus);
+        if (pthread_setaffinity_np(receiver_.native_handle(), sizeof(cpus), &cpus) != 0) {
+            std::cerr << "Unable to pin feed handler to CPU " << config::FEED_HANDLER_CPU << std::endl;
+        }
     }
 
-    // Очистка после шифрования
-    encryption_result_free(&encrypted_data);
+    for (const Leg& leg : legs_) {
+        std::cout << "Started collecting data from source: " << leg.source << " (port " << leg.port << ")" << std::endl;
+    }
 }
 
 // Stop the data collection process and set the collecting flag to false.
+// Shutting the sockets down wakes up a receive call that is blocked in the kernel.
 void DataCollector::stopCollection() {
-    collecting_ = false;
-    std::cout << "Stopped collecting data from source: " << source_ << std::endl;
+    if (!collecting_.exchange(false)) {
+        return;
+    }
+    for (const Leg& leg : legs_) {
+        ::shutdown(leg.socket, SHUT_RDWR);
+    }
+    if (receiver_.joinable()) {
+        receiver_.join();
+    }
+    closeSockets();
+    if (recorder_) {
+        try {
+            recorder_->flush();
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+        }
+    }
+    for (const Leg& leg : legs_) {
+        std::cout << "Stopped collecting data from source: " << leg.source << std::endl;
+    }
 }
 
 // Return the current status of data collection (true if active, false if inactive).
 bool DataCollector::isCollecting() const {
     return collecting_;
 }
+
+// Open a UDP socket for one source. Multicast groups are bound on the wildcard address
+// so several collectors on the host can join the same group.
+void DataCollector::openSocket(Leg& leg) {
+    std::string address;
+    std::uint16_t port = 0;
+    parseSource(leg.source, address, port);
+
+    in_addr group{};
+    if (::inet_pton(AF_INET, address.c_str(), &group) != 1) {
+        throw std::runtime_error("Invalid address in data source: " + leg.source);
+    }
+    const bool multicast = IN_MULTICAST(ntohl(group.s_addr));
+
+    leg.socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (leg.socket < 0) {
+        throw std::runtime_error("Unable to create socket: " + std::string(std::strerror(errno)));
+    }
+
+    auto fail = [](const std::string& what) {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    };
+
+    const int reuse = 1;
+    ::setsockopt(leg.socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    const int bufferSize = config::FEED_SOCKET_BUFFER_SIZE;
+    ::setsockopt(leg.socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = multicast ? htonl(INADDR_ANY) : group.s_addr;
+    if (::bind(leg.socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+        fail("Unable to bind " + leg.source);
+    }
+
+    if (multicast) {
+        ip_mreq membership{};
+        membership.imr_multiaddr = group;
+        ::inet_pton(AF_INET, config::FEED_MULTICAST_INTERFACE.c_str(), &membership.imr_interface);
+        if (::setsockopt(leg.socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+            fail("Unable to join multicast group " + address);
+        }
+    }
+
+    socklen_t length = sizeof(local);
+    ::getsockname(leg.socket, reinterpret_cast<sockaddr*>(&local), &length);
+    leg.port = ntohs(local.sin_port);
+}
+
+// Close every open socket.
+void DataCollector::closeSockets() {
+    for (Leg& leg : legs_) {
+        if (leg.socket >= 0) {
+            ::close(leg.socket);
+            leg.socket = -1;
+        }
+    }
+}
+
+// Bound blocking receives so the receive thread regularly gets to apply arrived snapshots, and ask the
+// kernel for software receive timestamps. Busy polling is best effort: raising SO_BUSY_POLL above
+// net.core.busy_read needs CAP_NET_ADMIN, and the spin loop still works without it.
+void DataCollector::configureSocket(int socket) {
+    timeval timeout{};
+    timeout.tv_usec = config::FEED_RECEIVE_TIMEOUT_MICROS;
+    ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (mode_ == ReceiveMode::Blocking) {
+        return;
+    }
+    const int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (::setsockopt(socket, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != 0) {
+        std::cerr << "Kernel receive timestamps are not available: " << std::strerror(errno) << std::endl;
+    }
+    if (mode_ == ReceiveMode::BusyPoll) {
+        const int micros = config::FEED_BUSY_POLL_MICROS;
+        if (::setsockopt(socket, SOL_SOCKET, SO_BUSY_POLL, &micros, sizeof(micros)) != 0) {
+            std::cerr << "SO_BUSY_POLL is not available: " << std::strerror(errno) << std::endl;
+        }
+    }
+}
+
+// With a single leg the receive call itself blocks (bounded by SO_RCVTIMEO), and busy polling never
+// blocks, so every leg is reported ready. With two legs, poll() waits for whichever has data first.
+std::uint32_t DataCollector::waitReadable() const {
+    const std::uint32_t all = (std::uint32_t{1} << legs_.size()) - 1;
+    if (legs_.size() == 1 || mode_ == ReceiveMode::BusyPoll) {
+        return all;
+    }
+
+    std::array<pollfd, 2> fds{};
+    for (std::size_t i = 0; i < legs_.size(); ++i) {
+        fds[i] = {legs_[i].socket, POLLIN, 0};
+    }
+    const int timeout = std::max(config::FEED_RECEIVE_TIMEOUT_MICROS / 1000, 1);
+    if (::poll(fds.data(), legs_.size(), timeout) <= 0) {
+        return 0;
+    }
+
+    std::uint32_t ready = 0;
+    for (std::size_t i = 0; i < legs_.size(); ++i) {
+        if (fds[i].revents != 0) {
+            ready |= std::uint32_t{1} << i;
+        }
+    }
+    return ready;
+}
+
+// Receive one datagram per system call and stamp it as soon as the call returns.
+void DataCollector::receiveBlocking() {
+    std::array<std::uint8_t, 65536> buffer;
+    const int flags = legs_.size() > 1 ? MSG_DONTWAIT : 0;
+
+    while (collecting_.load(std::memory_order_relaxed)) {
+        const std::uint32_t ready = waitReadable();
+        if (!recovering_.empty()) {
+            pollRecoveries();
+        }
+        for (std::size_t leg = 0; leg < legs_.size(); ++leg) {
+            if ((ready & (std::uint32_t{1} << leg)) == 0) {
+                continue;
+            }
+            const ssize_t received = ::recv(legs_[leg].socket, buffer.data(), buffer.size(), flags);
+            if (received < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+                    continue;
+                }
+                return;
+            }
+            if (!collecting_.load(std::memory_order_relaxed)) {
+                return;  // Woken up by stopCollection()
+            }
+
+            receiveCalls_.fetch_add(1, std::memory_order_relaxed);
+            onDatagram(buffer.data(), static_cast<std::size_t>(received), TscClock::now(), leg);
+        }
+    }
+}
+
+// Receive up to FEED_RECEIVE_BATCH datagrams per system call, each with its own buffer and control block.
+// Batched mode blocks until the first datagram arrives (MSG_WAITFORONE) and then takes whatever else is
+// queued; BusyPoll mode never blocks and spins on the sockets instead.
+// Datagrams longer than FEED_DATAGRAM_SIZE come back truncated; they are dropped and counted instead of
+// being decoded. With two legs the wait happens in
+// poll(), so the receive calls themselves do not block.
+void DataCollector::receiveBatched() {
+    constexpr std::size_t kControlSize = CMSG_SPACE(sizeof(scm_timestamping));
+    const std::size_t batch = config::FEED_RECEIVE_BATCH;
+    const std::size_t datagramSize = config::FEED_DATAGRAM_SIZE;
+
+    std::vector<std::uint8_t> buffers(batch * datagramSize);
+    std::vector<std::uint8_t> controls(batch * kControlSize);
+    std::vector<iovec> vectors(batch);
+    std::vector<mmsghdr> messages(batch);
+    const int flags = mode_ == ReceiveMode::BusyPoll || legs_.size() > 1 ? MSG_DONTWAIT : MSG_WAITFORONE;
+
+    while (collecting_.load(std::memory_order_relaxed)) {
+        const std::uint32_t ready = waitReadable();
+        if (!recovering_.empty()) {
+            pollRecoveries();
+        }
+        for (std::size_t leg = 0; leg < legs_.size(); ++leg) {
+            if ((ready & (std::uint32_t{1} << leg)) == 0) {
+                continue;
+            }
+            for (std::size_t i = 0; i < batch; ++i) {
+                vectors[i] = {buffers.data() + i * datagramSize, datagramSize};
+                messages[i].msg_hdr = {};
+                messages[i].msg_hdr.msg_iov = &vectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                messages[i].msg_hdr.msg_control = controls.data() + i * kControlSize;
+                messages[i].msg_hdr.msg_controllen = kControlSize;
+            }
+
+            const int received = ::recvmmsg(legs_[leg].socket, messages.data(), static_cast<unsigned>(batch), flags, nullptr);
+            if (received < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+                    continue;
+                }
+                return;
+            }
+            if (!collecting_.load(std::memory_order_relaxed)) {
+                return;  // Woken up by stopCollection()
+            }
+
+            const std::int64_t returned = TscClock::now();
+            receiveCalls_.fetch_add(1, std::memory_order_relaxed);
+            std::uint64_t timestamped = 0;
+            std::uint64_t queued = 0;
+            std::uint64_t truncated = 0;
+            for (int i = 0; i < received; ++i) {
+                if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                    ++truncated;  // Larger than FEED_DATAGRAM_SIZE: the rest of it is lost
+                    continue;
+                }
+                std::int64_t arrived = kernelTimestamp(messages[i].msg_hdr);
+                if (arrived != 0) {
+                    ++timestamped;
+                    queued += static_cast<std::uint64_t>(std::max<std::int64_t>(returned - arrived, 0));
+                } else {
+                    arrived = returned;
+                }
+                onDatagram(buffers.data() + i * datagramSize, messages[i].msg_len, arrived, leg);
+            }
+            timestamped_.fetch_add(timestamped, std::memory_order_relaxed);
+            kernelQueueNanos_.fetch_add(queued, std::memory_order_relaxed);
+            truncated_.fetch_add(truncated, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Pass the packet through the arbitrator and the tracker of its channel; only the first copy of
+// every message, in sequence order, reaches the decoder.
+void DataCollector::onDatagram(const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp,
+                               std::size_t leg) {
+    datagrams_.fetch_add(1, std::memory_order_relaxed);
+    if (recorder_) {
+        recorder_->record(data, size, receiveTimestamp, leg);
+    }
+    if (size < sizeof(itch::PacketHeader)) {
+        malformed_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    itch::PacketHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const std::uint16_t id = header.channel.value();
+    ChannelState& state = channel(id);
+    if (state.arbitrator) {
+        const FeedArbitrator::Result result =
+            state.arbitrator->accept(leg, header.sequence.value(), header.messageCount.value(), receiveTimestamp);
+        if (!result.accepted) {
+            arbitrated_.fetch_add(1, std::memory_order_relaxed);
+            legLead_[1 - leg].fetch_add(static_cast<std::uint64_t>(result.lead), std::memory_order_relaxed);
+            return;
+        }
+        if (header.messageCount.value() != 0) {
+            legWins_[leg].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SequenceTracker& tracker = state.tracker;
+    const std::uint64_t duplicates = tracker.duplicates();
+    tracker.onPacket(header.sequence.value(), header.messageCount.value(), data + sizeof(header), size - sizeof(header),
+                     receiveTimestamp,
+                     [this](const std::uint8_t* payload, std::size_t length, std::size_t skip, std::int64_t timestamp) {
+                         publish(payload, length, skip, timestamp);
+                     });
+    duplicates_.fetch_add(tracker.duplicates() - duplicates, std::memory_order_relaxed);
+
+    if (tracker.gapDetected()) {
+        handleGap(id);
+    }
+}
+
+// Decode the messages of one packet and publish the resulting ticks.
+void DataCollector::publish(const std::uint8_t* data, std::size_t size, std::size_t skip, std::int64_t receiveTimestamp) {
+    const std::size_t offset = skip == 0 ? 0 : itch::skipMessages(data, size, skip);
+    TickPublisher publisher(ring_, receiveTimestamp);
+    ItchDecoder<TickPublisher> decoder(publisher);
+    messages_.fetch_add(decoder.decode(data + offset, size - offset), std::memory_order_relaxed);
+    malformed_.fetch_add(decoder.malformed(), std::memory_order_relaxed);
+    published_.fetch_add(publisher.published, std::memory_order_relaxed);
+    dropped_.fetch_add(publisher.dropped, std::memory_order_relaxed);
+}
+
+// Channels are created on their first packet. Channel ids are small and dense, so a vector is enough.
+DataCollector::ChannelState& DataCollector::channel(std::uint16_t id) {
+    if (id >= channels_.size()) {
+        channels_.resize(id + 1);
+    }
+    if (!channels_[id]) {
+        channels_[id] = std::make_unique<ChannelState>();
+        if (legs_.size() > 1) {
+            channels_[id]->arbitrator.emplace();
+        }
+    }
+    return *channels_[id];
+}
+
+// Request the snapshot asynchronously so the receive thread keeps draining the socket; the live packets
+// are buffered by the tracker meanwhile. Without a snapshot source, resume after the hole.
+void DataCollector::handleGap(std::uint16_t id) {
+    gaps_.fetch_add(1, std::memory_order_relaxed);
+    ChannelState& state = channel(id);
+
+    if (!snapshots_) {
+        const std::uint64_t lost = state.tracker.skipGap(
+            [this](const std::uint8_t* payload, std::size_t length, std::size_t skip, std::int64_t timestamp) {
+                publish(payload, length, skip, timestamp);
+            });
+        lost_.fetch_add(lost, std::memory_order_relaxed);
+        std::cerr << "Sequence gap on channel " << id << ": " << lost << " messages lost" << std::endl;
+        return;
+    }
+
+    state.tracker.beginRecovery();
+    state.snapshot = std::async(std::launch::async, [source = snapshots_, id] { return source->requestSnapshot(id); });
+    recovering_.push_back(id);
+}
+
+// Publish every snapshot that has arrived, then replay the packets buffered during its recovery.
+// If the request failed, the missing messages are given up on, as if there were no snapshot source.
+void DataCollector::pollRecoveries() {
+    for (std::size_t i = 0; i < recovering_.size();) {
+        const std::uint16_t id = recovering_[i];
+        ChannelState& state = *channels_[id];
+        if (state.snapshot.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++i;
+            continue;
+        }
+        recovering_.erase(recovering_.begin() + static_cast<std::ptrdiff_t>(i));
+
+        auto deliver = [this](const std::uint8_t* payload, std::size_t length, std::size_t skip, std::int64_t timestamp) {
+            publish(payload, length, skip, timestamp);
+        };
+        try {
+            const Snapshot snapshot = state.snapshot.get();
+            publish(snapshot.messages.data(), snapshot.messages.size(), 0, TscClock::now());
+            state.tracker.completeRecovery(snapshot.nextSequence, deliver);
+            recoveries_.fetch_add(1, std::memory_order_relaxed);
+        } catch (const std::exception& error) {
+            std::cerr << "Snapshot recovery of channel " << id << " failed: " << error.what() << std::endl;
+            state.tracker.completeRecovery(state.tracker.expectedSequence(), deliver);
+            lost_.fetch_add(state.tracker.skipGap(deliver), std::memory_order_relaxed);
+        }
+
+        if (state.tracker.gapDetected()) {
+            handleGap(id);
+        }
+    }
+}
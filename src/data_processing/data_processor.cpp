@@ -1,55 +1,133 @@
 #include "data_processor.h"
-#include "hash_utils.h"  // Подключаем модуль безопасности для хеширования
-#include <algorithm>  // For data transformations
-#include <xmmintrin.h>  // For SIMD prefetching
-#include <immintrin.h>  // For AVX instructions
-#include <iostream>
-
-// Process the raw data by first filtering, then transforming each data point, and optionally hashing.
-// The processed data is returned as a vector of strings.
-std::vector<std::string> DataProcessor::process(const std::vector<std::string>& rawData) {
-    std::vector<std::string> processedData;
-    processedData.reserve(rawData.size());  // Reserve memory to avoid reallocations
-    
-    // Prefetch the first block of data
-    _mm_prefetch(rawData.data(), _MM_HINT_T0);
-
-    // Use standard algorithms for efficiency
-    std::transform(rawData.begin(), rawData.end(), std::back_inserter(processedData),
-                   [this](const std::string& data) {
-                       std::string filtered = filterData(data);
-                       std::string transformed = transformData(filtered);
-                       
-                       // Хешируем трансформированные данные для проверки целостности
-                       hash_result_t hash_result;
-                       int ret = hash_data((const uint8_t*)transformed.c_str(), transformed.size(), HASH_ALG_SHA256, &hash_result);
-                       
-                       if (ret == 0) {
-                           std::cout << "Hash of data: ";
-                           for (size_t i = 0; i < hash_result.hash_len; ++i) {
-                               printf("%02x", hash_result.hash[i]);
-                           }
-                           std::cout << std::endl;
-                       } else {
-                           std::cerr << "Error hashing data!" << std::endl;
-                       }
-
-                       hash_result_free(&hash_result);  // Очистка после хеширования
-                       
-                       return transformed;
-                   });
-
-    return processedData;
+#include "tsc_clock.h"
+#include <charconv>
+#include <cmath>
+
+// Parse every raw record into the batch. The batch is reserved up front so that
+// appending does not reallocate once per record.
+std::size_t DataProcessor::fill(const std::vector<std::string>& rawData, TickBatch& batch) {
+    batch.reserve(batch.size() + rawData.size());
+
+    std::size_t appended = 0;
+    Tick tick;
+    for (const auto& record : rawData) {
+        if (parseRecord(record, tick)) {
+            batch.append(tick);
+            ++appended;
+        }
+    }
+    return appended;
 }
 
-// Filter the data to remove or modify unwanted elements.
-std::string DataProcessor::filterData(const std::string& data) {
-    // Potentially add SIMD optimization here if more complex filtering is needed
-    return data;  // No filtering applied in this simple example
+// Process the batch by first filtering, then transforming it. Both steps work in place.
+// The books are updated last, from the filtered rows only.
+void DataProcessor::process(TickBatch& batch) {
+    filterData(batch);
+    transformData(batch);
+    books_.apply(batch);
+    recordLatency(batch);
 }
 
-// Transform the data, for example by normalizing or formatting it.
-std::string DataProcessor::transformData(const std::string& data) {
-    // Example SIMD usage for more complex transformations (if necessary)
-    return "Transformed: " + data;
+// One clock reading covers the whole batch. Rows without a receive timestamp (e.g. loaded from a file)
+// are skipped.
+void DataProcessor::recordLatency(const TickBatch& batch) {
+    if (batch.size() == 0) {
+        return;
+    }
+    const std::int64_t processed = TscClock::now();
+    for (const std::int64_t received : batch.receiveTimestamps()) {
+        if (received != 0) {
+            latency_.add(processed - received);
+        }
+    }
+}
+
+// Drain the ring in one step so the producer sees the freed slots at once, then process the batch.
+std::size_t DataProcessor::drain(SpscRing<Tick>& ring, TickBatch& batch, std::size_t maxTicks) {
+    batch.clear();
+    const std::size_t taken = ring.drain([&batch](const Tick& tick) { batch.append(tick); }, maxTicks);
+    process(batch);
+    return taken;
+}
+
+// Filter the batch, keeping only rows that describe a valid market state.
+void DataProcessor::filterData(TickBatch& batch) {
+    const auto bids = batch.bidPrices();
+    const auto asks = batch.askPrices();
+    const auto trades = batch.tradePrices();
+    const auto bidSizes = batch.bidSizes();
+    const auto askSizes = batch.askSizes();
+    const auto quantities = batch.tradeQuantities();
+    const auto ids = batch.instrumentIds();
+
+    auto validPrice = [](double price) { return std::isfinite(price) && price >= 0.0; };
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const bool hasQuote = bids[i] > 0.0 || asks[i] > 0.0;
+        const bool hasTrade = trades[i] > 0.0;
+        const bool valid = isValidInstrument(ids[i]) && validPrice(bids[i]) && validPrice(asks[i]) && validPrice(trades[i]) &&
+                           (hasQuote || hasTrade) &&
+                           bidSizes[i] >= 0 && askSizes[i] >= 0 && quantities[i] >= 0 &&
+                           !(bids[i] > 0.0 && asks[i] > 0.0 && bids[i] > asks[i]);
+        if (valid) {
+            if (kept != i) {
+                batch.moveRow(i, kept);
+            }
+            ++kept;
+        }
+    }
+    batch.resize(kept);
+}
+
+// Transform the batch so that every row carries a usable top of book.
+void DataProcessor::transformData(TickBatch& batch) {
+    const auto ids = batch.instrumentIds();
+    const auto bids = batch.bidPrices();
+    const auto asks = batch.askPrices();
+    const auto trades = batch.tradePrices();
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const InstrumentId id = ids[i];
+        if (!isValidInstrument(id)) {
+            continue;  // filterData() drops these rows; never index the tables with them
+        }
+        if (id >= lastBid_.size()) {
+            lastBid_.resize(id + 1, 0.0);
+            lastAsk_.resize(id + 1, 0.0);
+        }
+
+        if (bids[i] <= 0.0) {
+            bids[i] = lastBid_[id] > 0.0 ? lastBid_[id] : trades[i];
+        }
+        if (asks[i] <= 0.0) {
+            asks[i] = lastAsk_[id] > 0.0 ? lastAsk_[id] : trades[i];
+        }
+        lastBid_[id] = bids[i];
+        lastAsk_[id] = asks[i];
+    }
+}
+
+// Parse "timestamp,price,volume". The price becomes the trade price and the volume the trade quantity.
+bool DataProcessor::parseRecord(std::string_view record, Tick& tick) {
+    if (!record.empty() && record.back() == '\r') {
+        record.remove_suffix(1);
+    }
+
+    const std::size_t first = record.find(',');
+    const std::size_t second = first == std::string_view::npos ? first : record.find(',', first + 1);
+    if (second == std::string_view::npos) {
+        return false;
+    }
+
+    const std::string_view priceField = record.substr(first + 1, second - first - 1);
+    const std::string_view volumeField = record.substr(second + 1);
+
+    tick = Tick{};
+    if (!parseTimestamp(record.substr(0, first), tick.timestamp)) {
+        return false;
+    }
+    const auto price = std::from_chars(priceField.data(), priceField.data() + priceField.size(), tick.tradePrice);
+    const auto volume = std::from_chars(volumeField.data(), volumeField.data() + volumeField.size(), tick.tradeQuantity);
+    return price.ec == std::errc() && volume.ec == std::errc();
 }
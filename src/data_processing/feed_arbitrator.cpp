@@ -0,0 +1,74 @@
+#include "feed_arbitrator.h"
+#include <algorithm>
+
+// Constructor that sizes the bitmap and the arrival records to the window.
+FeedArbitrator::FeedArbitrator(std::size_t window)
+    : window_(std::max<std::size_t>((window + 63) / 64 * 64, 64)),
+      seen_(window_ / 64, 0),
+      arrival_(window_, 0),
+      firstLeg_(window_, 0) {}
+
+// A packet is new if any of its messages is new. The arrival and leg are recorded for every message the
+// packet delivered first, so a late copy finds the first arrival of its leading message even when the
+// legs split the messages into packets differently.
+FeedArbitrator::Result FeedArbitrator::accept(std::size_t leg, std::uint64_t sequence, std::uint16_t count,
+                                              std::int64_t receiveTimestamp) {
+    Result result;
+    if (count == 0) {
+        result.accepted = true;
+        return result;
+    }
+
+    advance(sequence + count - 1);
+    for (std::uint64_t message = sequence; message < sequence + count; ++message) {
+        if (!testAndSet(message)) {
+            result.accepted = true;
+            const std::size_t slot = static_cast<std::size_t>(message % window_);
+            arrival_[slot] = receiveTimestamp;
+            firstLeg_[slot] = static_cast<std::uint8_t>(leg);
+        }
+    }
+
+    if (result.accepted) {
+        ++wins_[leg];
+    } else {
+        ++duplicates_;
+        const std::size_t slot = static_cast<std::size_t>(sequence % window_);
+        const std::size_t winner = firstLeg_[slot];
+        if (winner != leg && sequence + window_ >= end_) {
+            result.lead = std::max<std::int64_t>(receiveTimestamp - arrival_[slot], 0);
+            leadTime_[winner] += static_cast<std::uint64_t>(result.lead);
+        }
+    }
+    return result;
+}
+
+// Clear the bits of the sequence numbers that enter the window. Each sequence number is cleared once,
+// so sliding costs O(1) per message; a jump larger than the window clears the whole bitmap.
+void FeedArbitrator::advance(std::uint64_t sequence) {
+    if (sequence < end_) {
+        return;
+    }
+    if (sequence - end_ + 1 >= window_) {
+        std::fill(seen_.begin(), seen_.end(), 0);
+    } else {
+        for (std::uint64_t message = end_; message <= sequence; ++message) {
+            const std::size_t bit = static_cast<std::size_t>(message % window_);
+            seen_[bit / 64] &= ~(std::uint64_t{1} << (bit % 64));
+        }
+    }
+    end_ = sequence + 1;
+}
+
+// Sequence numbers that have slid out of the window count as seen.
+bool FeedArbitrator::testAndSet(std::uint64_t sequence) {
+    if (sequence + window_ < end_) {
+        return true;
+    }
+    const std::size_t bit = static_cast<std::size_t>(sequence % window_);
+    std::uint64_t& word = seen_[bit / 64];
+    const std::uint64_t mask = std::uint64_t{1} << (bit % 64);
+    const bool seen = (word & mask) != 0;
+    word |= mask;
+    return seen;
+}
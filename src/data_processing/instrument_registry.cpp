@@ -0,0 +1,102 @@
+#include "instrument_registry.h"
+#include <charconv>
+#include <stdexcept>
+#include "mapped_file.h"
+
+namespace {
+
+// Remove surrounding spaces and a trailing carriage return.
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Split off the next comma-separated field of a line.
+std::string_view nextField(std::string_view& line) {
+    const std::size_t comma = line.find(',');
+    const std::string_view field = trim(line.substr(0, comma));
+    line = comma == std::string_view::npos ? std::string_view() : line.substr(comma + 1);
+    return field;
+}
+
+// Parse a numeric field, leaving the default in place when the field is empty.
+template <typename Number>
+bool parseNumber(std::string_view text, Number& value) {
+    if (text.empty()) {
+        return true;
+    }
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+} // namespace
+
+// Constructor that loads the reference data.
+InstrumentRegistry::InstrumentRegistry(const std::string& fileName) {
+    load(fileName);
+}
+
+// The file is mapped and parsed line by line through string views; only the symbols are copied.
+void InstrumentRegistry::load(const std::string& fileName) {
+    const MappedFile file(fileName, MappedFile::AccessHint::Sequential);
+    std::string_view text = file.view();
+
+    std::size_t lineNumber = 0;
+    while (!text.empty()) {
+        const std::size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+        ++lineNumber;
+
+        if (trim(line).empty()) {
+            continue;
+        }
+        InstrumentInfo info;
+        const std::string_view symbol = nextField(line);
+        if (lineNumber == 1 && symbol == "symbol") {
+            continue;  // Header line
+        }
+        if (symbol.empty() || !parseNumber(nextField(line), info.tickSize) || !parseNumber(nextField(line), info.lotSize) ||
+            !(info.tickSize > 0.0) || info.lotSize <= 0) {
+            throw std::runtime_error("Malformed reference data in " + fileName + " at line " + std::to_string(lineNumber));
+        }
+        info.symbol = symbol;
+        add(info);
+    }
+}
+
+// Ids are handed out in registration order, so they stay dense and below config::MAX_INSTRUMENTS.
+InstrumentId InstrumentRegistry::add(const InstrumentInfo& info) {
+    if (instruments_.size() >= config::MAX_INSTRUMENTS) {
+        throw std::runtime_error("Too many instruments, the limit is " + std::to_string(config::MAX_INSTRUMENTS) +
+                                 ": " + info.symbol);
+    }
+    const auto id = static_cast<InstrumentId>(instruments_.size());
+    if (!ids_.emplace(info.symbol, id).second) {
+        throw std::runtime_error("Duplicate instrument symbol: " + info.symbol);
+    }
+    instruments_.push_back(info);
+    return id;
+}
+
+// Look the symbol up first so that known symbols never allocate.
+InstrumentId InstrumentRegistry::intern(std::string_view symbol) {
+    const InstrumentId id = find(symbol);
+    if (id != kInvalidInstrument) {
+        return id;
+    }
+    InstrumentInfo info;
+    info.symbol = symbol;
+    return add(info);
+}
+
+// Heterogeneous lookup: the string view is hashed and compared without building a std::string.
+InstrumentId InstrumentRegistry::find(std::string_view symbol) const {
+    const auto it = ids_.find(symbol);
+    return it == ids_.end() ? kInvalidInstrument : it->second;
+}
@@ -0,0 +1,255 @@
+#include "l2_book.h"
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// Set a level's quantity, moving the window first if the price is outside it.
+void L2Book::setLevel(Side side, std::int64_t price, std::int64_t quantity) {
+    std::size_t index;
+    if (!locate(price, index)) {
+        return;
+    }
+    store(side, index, quantity > 0 ? quantity : 0);
+}
+
+// Adjust a level's quantity by a delta. A level never goes below zero.
+void L2Book::addQuantity(Side side, std::int64_t price, std::int64_t delta) {
+    std::size_t index;
+    if (!locate(price, index)) {
+        return;
+    }
+    const SideLevels& levels = side == Side::Bid ? bids_ : asks_;
+    const std::int64_t quantity = levels.quantities[index] + delta;
+    store(side, index, quantity > 0 ? quantity : 0);
+}
+
+// Remove the levels better than the new touch and the opposite levels it crosses, then store the touch
+// itself. Removing walks from the old best price, so it costs one step per stale level.
+void L2Book::applyTopOfBook(std::int64_t bidPrice, std::int64_t bidQuantity, std::int64_t askPrice,
+                            std::int64_t askQuantity) {
+    if (bidPrice > 0) {
+        while (hasBid() && bestBid() > bidPrice) {
+            store(Side::Bid, static_cast<std::size_t>(bestBid_), 0);
+        }
+        while (hasAsk() && bestAsk() <= bidPrice) {
+            store(Side::Ask, static_cast<std::size_t>(bestAsk_), 0);
+        }
+        setLevel(Side::Bid, bidPrice, bidQuantity);
+    }
+    if (askPrice > 0) {
+        while (hasAsk() && bestAsk() < askPrice) {
+            store(Side::Ask, static_cast<std::size_t>(bestAsk_), 0);
+        }
+        while (hasBid() && bestBid() >= askPrice) {
+            store(Side::Bid, static_cast<std::size_t>(bestBid_), 0);
+        }
+        setLevel(Side::Ask, askPrice, askQuantity);
+    }
+}
+
+// Reset both sides. The anchor is kept, so the next updates near the old prices need no recentering.
+void L2Book::clear() {
+    bids_ = SideLevels{};
+    asks_ = SideLevels{};
+    bestBid_ = -1;
+    bestAsk_ = -1;
+}
+
+// Look up a price directly by its offset from the anchor.
+std::int64_t L2Book::quantityAt(Side side, std::int64_t price) const {
+    const std::int64_t offset = price - anchor_;
+    if (!anchored_ || offset < 0 || offset >= static_cast<std::int64_t>(kLevels)) {
+        return 0;
+    }
+    return (side == Side::Bid ? bids_ : asks_).quantities[static_cast<std::size_t>(offset)];
+}
+
+// Walk the occupancy bitmap from the best price outwards.
+std::size_t L2Book::depth(Side side, std::span<Level> out) const {
+    const SideLevels& levels = side == Side::Bid ? bids_ : asks_;
+    std::ptrdiff_t index = side == Side::Bid ? bestBid_ : bestAsk_;
+    std::size_t copied = 0;
+    while (index >= 0 && copied < out.size()) {
+        out[copied++] = Level{anchor_ + index, levels.quantities[static_cast<std::size_t>(index)]};
+        index = side == Side::Bid ? highestAtOrBelow(levels, index - 1) : lowestAtOrAbove(levels, index + 1);
+    }
+    return copied;
+}
+
+// The first price anchors the window around itself. Later prices outside the window move it so that
+// it is centred on the touch (or on the price, if the book is empty).
+bool L2Book::locate(std::int64_t price, std::size_t& index) {
+    constexpr std::int64_t levels = static_cast<std::int64_t>(kLevels);
+    if (!anchored_) {
+        anchored_ = true;
+        anchor_ = price - levels / 2;
+    }
+
+    std::int64_t offset = price - anchor_;
+    if (offset < 0 || offset >= levels) {
+        std::int64_t centre = price;
+        if (hasBid() && hasAsk()) {
+            centre = (bestBid() + bestAsk()) / 2;
+        } else if (hasBid()) {
+            centre = bestBid();
+        } else if (hasAsk()) {
+            centre = bestAsk();
+        }
+        const std::int64_t anchor = centre - levels / 2;
+        if (price < anchor || price >= anchor + levels) {
+            ++outOfRange_;
+            return false;
+        }
+        recenter(anchor);
+        offset = price - anchor_;
+    }
+    index = static_cast<std::size_t>(offset);
+    return true;
+}
+
+// Rebuild both sides relative to the new anchor. Only occupied levels are visited.
+void L2Book::recenter(std::int64_t anchor) {
+    const std::int64_t shift = anchor - anchor_;
+    auto move = [shift](SideLevels& levels) {
+        const SideLevels old = levels;
+        levels = SideLevels{};
+        for (std::size_t word = 0; word < old.occupied.size(); ++word) {
+            for (std::uint64_t bits = old.occupied[word]; bits != 0; bits &= bits - 1) {
+                const std::int64_t from = static_cast<std::int64_t>(word * 64 + std::countr_zero(bits));
+                const std::int64_t to = from - shift;
+                if (to >= 0 && to < static_cast<std::int64_t>(kLevels)) {
+                    levels.quantities[to] = old.quantities[from];
+                    levels.occupied[to / 64] |= std::uint64_t{1} << (to % 64);
+                    ++levels.count;
+                }
+            }
+        }
+    };
+    move(bids_);
+    move(asks_);
+    anchor_ = anchor;
+    bestBid_ = highestAtOrBelow(bids_, static_cast<std::ptrdiff_t>(kLevels) - 1);
+    bestAsk_ = lowestAtOrAbove(asks_, 0);
+}
+
+// Store the quantity and keep the occupancy bit, the level count and the best index consistent.
+void L2Book::store(Side side, std::size_t index, std::int64_t quantity) {
+    SideLevels& levels = side == Side::Bid ? bids_ : asks_;
+    std::ptrdiff_t& best = side == Side::Bid ? bestBid_ : bestAsk_;
+    const std::uint64_t bit = std::uint64_t{1} << (index % 64);
+    std::uint64_t& word = levels.occupied[index / 64];
+    const auto position = static_cast<std::ptrdiff_t>(index);
+
+    levels.quantities[index] = quantity;
+    if (quantity > 0) {
+        if ((word & bit) == 0) {
+            word |= bit;
+            ++levels.count;
+        }
+        if (best < 0 || (side == Side::Bid ? position > best : position < best)) {
+            best = position;
+        }
+    } else if ((word & bit) != 0) {
+        word &= ~bit;
+        --levels.count;
+        if (position == best) {
+            best = side == Side::Bid ? highestAtOrBelow(levels, position - 1) : lowestAtOrAbove(levels, position + 1);
+        }
+    }
+}
+
+// Scan the bitmap downwards one 64-level word at a time.
+std::ptrdiff_t L2Book::highestAtOrBelow(const SideLevels& levels, std::ptrdiff_t from) {
+    if (from < 0) {
+        return -1;
+    }
+    std::ptrdiff_t word = from / 64;
+    std::uint64_t bits = levels.occupied[word];
+    const int bit = static_cast<int>(from % 64);
+    if (bit < 63) {
+        bits &= (std::uint64_t{1} << (bit + 1)) - 1;
+    }
+    while (true) {
+        if (bits != 0) {
+            return word * 64 + 63 - std::countl_zero(bits);
+        }
+        if (--word < 0) {
+            return -1;
+        }
+        bits = levels.occupied[word];
+    }
+}
+
+// Scan the bitmap upwards one 64-level word at a time.
+std::ptrdiff_t L2Book::lowestAtOrAbove(const SideLevels& levels, std::ptrdiff_t from) {
+    constexpr auto words = static_cast<std::ptrdiff_t>(kLevels / 64);
+    if (from >= static_cast<std::ptrdiff_t>(kLevels)) {
+        return -1;
+    }
+    std::ptrdiff_t word = from / 64;
+    std::uint64_t bits = levels.occupied[word] & (~std::uint64_t{0} << (from % 64));
+    while (true) {
+        if (bits != 0) {
+            return word * 64 + std::countr_zero(bits);
+        }
+        if (++word >= words) {
+            return -1;
+        }
+        bits = levels.occupied[word];
+    }
+}
+
+// Constructor that sets the tick size.
+L2BookSet::L2BookSet(double tickSize) : tickSize_(tickSize) {}
+
+// Books are allocated once per instrument and then reused for the lifetime of the set.
+L2Book& L2BookSet::book(InstrumentId instrumentId) {
+    if (!isValidInstrument(instrumentId)) {
+        throw std::runtime_error("Invalid instrument id for an L2 book: " + std::to_string(instrumentId));
+    }
+    if (instrumentId >= books_.size()) {
+        books_.resize(instrumentId + 1);
+    }
+    if (!books_[instrumentId]) {
+        books_[instrumentId] = std::make_unique<L2Book>();
+    }
+    return *books_[instrumentId];
+}
+
+// Find a book without creating it.
+const L2Book* L2BookSet::find(InstrumentId instrumentId) const {
+    return instrumentId < books_.size() ? books_[instrumentId].get() : nullptr;
+}
+
+// Clearing keeps the books, so instruments seen before do not allocate again.
+void L2BookSet::clear() {
+    for (const auto& book : books_) {
+        if (book) {
+            book->clear();
+        }
+    }
+}
+
+// Rows without quote sizes (trades, forward-filled quotes, historical CSV data) do not describe the book.
+// Rows with an invalid instrument id are skipped.
+void L2BookSet::apply(const TickBatch& batch) {
+    const auto ids = batch.instrumentIds();
+    const auto bids = batch.bidPrices();
+    const auto asks = batch.askPrices();
+    const auto bidSizes = batch.bidSizes();
+    const auto askSizes = batch.askSizes();
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        if ((bidSizes[i] <= 0 && askSizes[i] <= 0) || !isValidInstrument(ids[i])) {
+            continue;
+        }
+        book(ids[i]).applyTopOfBook(bidSizes[i] > 0 ? toTicks(bids[i]) : 0, bidSizes[i],
+                                    askSizes[i] > 0 ? toTicks(asks[i]) : 0, askSizes[i]);
+    }
+}
+
+// Round to the nearest tick so that binary floating-point noise does not shift a price by one tick.
+std::int64_t L2BookSet::toTicks(double price) const {
+    return std::llround(price / tickSize_);
+}
@@ -0,0 +1,237 @@
+#include "l3_book.h"
+#include <algorithm>
+#include <cmath>
+
+// Allocate both pools and thread every node onto its free list.
+L3Book::L3Book(std::size_t maxOrders, std::size_t maxLevels, double tickSize)
+    : orderPool_(maxOrders),
+      levelPool_(maxLevels),
+      orders_(maxOrders),
+      levels_(maxLevels),
+      books_(tickSize),
+      priceIncrement_(std::max<std::int64_t>(std::llround(tickSize * itch::kPriceScale), 1)) {
+    clear();
+}
+
+// Append the order to the tail of its level's queue and update the aggregated book.
+bool L3Book::addOrder(std::uint64_t reference, InstrumentId instrumentId, Side side, std::int64_t price,
+                      std::int64_t quantity, bool own) {
+    if (quantity <= 0 || !isValidInstrument(instrumentId) || freeOrder_ == kNone || orders_.find(reference) != FlatHashMap<std::uint64_t>::kMissing) {
+        ++rejected_;
+        return false;
+    }
+    const std::uint32_t level = acquireLevel(LevelKey{instrumentId, side, price});
+    if (level == kNone) {
+        ++rejected_;
+        return false;
+    }
+
+    const std::uint32_t index = freeOrder_;
+    Order& order = orderPool_[index];
+    freeOrder_ = order.next;
+    order = Order{reference, price, quantity, instrumentId, level, levelPool_[level].tail, kNone, side, own};
+    orders_.insert(reference, index);
+
+    Level& queue = levelPool_[level];
+    if (queue.tail == kNone) {
+        queue.head = index;
+    } else {
+        orderPool_[queue.tail].next = index;
+    }
+    queue.tail = index;
+    queue.quantity += quantity;
+    ++queue.orders;
+
+    books_.book(instrumentId).addQuantity(side, price, quantity);
+    return true;
+}
+
+// A partial reduction keeps the order's place in the queue.
+bool L3Book::reduceOrder(std::uint64_t reference, std::int64_t quantity) {
+    const std::uint32_t index = orders_.find(reference);
+    if (quantity <= 0 || index == FlatHashMap<std::uint64_t>::kMissing) {
+        ++rejected_;
+        return false;
+    }
+    Order& order = orderPool_[index];
+    if (quantity >= order.quantity) {
+        removeOrder(index);
+        return true;
+    }
+    order.quantity -= quantity;
+    levelPool_[order.level].quantity -= quantity;
+    books_.book(order.instrumentId).addQuantity(order.side, order.price, -quantity);
+    return true;
+}
+
+// Remove an order by reference.
+bool L3Book::deleteOrder(std::uint64_t reference) {
+    const std::uint32_t index = orders_.find(reference);
+    if (index == FlatHashMap<std::uint64_t>::kMissing) {
+        ++rejected_;
+        return false;
+    }
+    removeOrder(index);
+    return true;
+}
+
+// A replace loses the queue position, as it does on the exchange.
+bool L3Book::replaceOrder(std::uint64_t reference, std::uint64_t newReference, std::int64_t quantity,
+                          std::int64_t price) {
+    const std::uint32_t index = orders_.find(reference);
+    if (index == FlatHashMap<std::uint64_t>::kMissing) {
+        ++rejected_;
+        return false;
+    }
+    // Everything the new order needs is checked before the original is removed, so a rejected replace
+    // leaves the book unchanged. The original's node is reused; a level is needed only for a new price,
+    // and removing the original frees one if it was alone on its level.
+    const Order original = orderPool_[index];
+    const bool referenceTaken = newReference != reference &&
+                                orders_.find(newReference) != FlatHashMap<std::uint64_t>::kMissing;
+    const bool levelAvailable = levels_.find(LevelKey{original.instrumentId, original.side, price}) != kNone ||
+                                freeLevel_ != kNone || levelPool_[original.level].orders == 1;
+    if (quantity <= 0 || referenceTaken || !levelAvailable) {
+        ++rejected_;
+        return false;
+    }
+    removeOrder(index);
+    return addOrder(newReference, original.instrumentId, original.side, price, quantity, original.own);
+}
+
+// Flag an order as ours.
+bool L3Book::markOwn(std::uint64_t reference) {
+    const std::uint32_t index = orders_.find(reference);
+    if (index == FlatHashMap<std::uint64_t>::kMissing) {
+        return false;
+    }
+    orderPool_[index].own = true;
+    return true;
+}
+
+// Find an order through the reference map.
+const L3Book::Order* L3Book::find(std::uint64_t reference) const {
+    const std::uint32_t index = orders_.find(reference);
+    return index == FlatHashMap<std::uint64_t>::kMissing ? nullptr : &orderPool_[index];
+}
+
+// Walk backwards from the order to the front of its queue.
+std::optional<L3Book::QueuePosition> L3Book::queuePosition(std::uint64_t reference) const {
+    const std::uint32_t index = orders_.find(reference);
+    if (index == FlatHashMap<std::uint64_t>::kMissing) {
+        return std::nullopt;
+    }
+    QueuePosition position;
+    for (std::uint32_t ahead = orderPool_[index].previous; ahead != kNone; ahead = orderPool_[ahead].previous) {
+        position.quantityAhead += orderPool_[ahead].quantity;
+        ++position.ordersAhead;
+    }
+    return position;
+}
+
+// Total quantity of a level (0 if the level is empty).
+std::int64_t L3Book::levelQuantity(InstrumentId instrumentId, Side side, std::int64_t price) const {
+    const std::uint32_t level = levels_.find(LevelKey{instrumentId, side, price});
+    return level == kNone ? 0 : levelPool_[level].quantity;
+}
+
+// Number of orders of a level (0 if the level is empty).
+std::uint32_t L3Book::levelOrders(InstrumentId instrumentId, Side side, std::int64_t price) const {
+    const std::uint32_t level = levels_.find(LevelKey{instrumentId, side, price});
+    return level == kNone ? 0 : levelPool_[level].orders;
+}
+
+// Return every node to its pool. The aggregated books are cleared but kept allocated.
+void L3Book::clear() {
+    for (std::size_t i = 0; i < orderPool_.size(); ++i) {
+        orderPool_[i].next = i + 1 < orderPool_.size() ? static_cast<std::uint32_t>(i + 1) : kNone;
+    }
+    freeOrder_ = orderPool_.empty() ? kNone : 0;
+    for (std::size_t i = 0; i < levelPool_.size(); ++i) {
+        levelPool_[i] = Level{};
+        levelPool_[i].tail = i + 1 < levelPool_.size() ? static_cast<std::uint32_t>(i + 1) : kNone;
+    }
+    freeLevel_ = levelPool_.empty() ? kNone : 0;
+    orders_.clear();
+    levels_.clear();
+    books_.clear();
+}
+
+// 'A': add the order on the side given by the message.
+void L3Book::onMessage(const itch::AddOrder& message) {
+    addOrder(message.orderReference.value(), message.header.locate.value(), message.side == 'S' ? Side::Ask : Side::Bid,
+             toTicks(message.price.value()), message.shares.value());
+}
+
+// 'E': executions reduce the resting order.
+void L3Book::onMessage(const itch::OrderExecuted& message) {
+    reduceOrder(message.orderReference.value(), message.executedShares.value());
+}
+
+// 'X': partial cancels reduce the resting order.
+void L3Book::onMessage(const itch::OrderCancel& message) {
+    reduceOrder(message.orderReference.value(), message.cancelledShares.value());
+}
+
+// 'D': the order leaves the book.
+void L3Book::onMessage(const itch::OrderDelete& message) {
+    deleteOrder(message.orderReference.value());
+}
+
+// 'U': the order is replaced with a new reference.
+void L3Book::onMessage(const itch::OrderReplace& message) {
+    replaceOrder(message.originalOrderReference.value(), message.newOrderReference.value(), message.shares.value(),
+                 toTicks(message.price.value()));
+}
+
+// Find the level of a key, or take a free one from the pool and register it.
+std::uint32_t L3Book::acquireLevel(const LevelKey& key) {
+    const std::uint32_t existing = levels_.find(key);
+    if (existing != kNone) {
+        return existing;
+    }
+    if (freeLevel_ == kNone) {
+        return kNone;
+    }
+    const std::uint32_t index = freeLevel_;
+    freeLevel_ = levelPool_[index].tail;
+    levelPool_[index] = Level{};
+    levelPool_[index].key = key;
+    levels_.insert(key, index);
+    return index;
+}
+
+// Unlink the order, update its level and the aggregated book, and recycle the nodes that became free.
+void L3Book::removeOrder(std::uint32_t index) {
+    Order& order = orderPool_[index];
+    Level& level = levelPool_[order.level];
+
+    if (order.previous == kNone) {
+        level.head = order.next;
+    } else {
+        orderPool_[order.previous].next = order.next;
+    }
+    if (order.next == kNone) {
+        level.tail = order.previous;
+    } else {
+        orderPool_[order.next].previous = order.previous;
+    }
+    level.quantity -= order.quantity;
+    --level.orders;
+    books_.book(order.instrumentId).addQuantity(order.side, order.price, -order.quantity);
+
+    if (level.orders == 0) {
+        levels_.erase(level.key);
+        level.tail = freeLevel_;
+        freeLevel_ = order.level;
+    }
+    orders_.erase(order.reference);
+    order.next = freeOrder_;
+    freeOrder_ = index;
+}
+
+// ITCH prices carry four implied decimals; round them to the nearest tick.
+std::int64_t L3Book::toTicks(std::int64_t price) const {
+    const std::int64_t half = priceIncrement_ / 2;
+    return (price >= 0 ? price + half : price - half) / priceIncrement_;
+}
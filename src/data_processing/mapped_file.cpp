@@ -0,0 +1,99 @@
+#include "mapped_file.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Translate the access hint into the madvise advice value.
+int toAdvice(MappedFile::AccessHint hint) {
+    switch (hint) {
+        case MappedFile::AccessHint::Sequential:
+            return MADV_SEQUENTIAL;
+        case MappedFile::AccessHint::Random:
+            return MADV_RANDOM;
+        case MappedFile::AccessHint::Normal:
+            break;
+    }
+    return MADV_NORMAL;
+}
+
+} // namespace
+
+// Open the file, map it read-only and apply the access hints.
+// The descriptor is closed right away; the mapping keeps the file contents reachable.
+MappedFile::MappedFile(const std::string& fileName, AccessHint hint, bool hugePages) {
+    const int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open file: " + fileName + " (" + std::strerror(errno) + ")");
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Unable to stat file: " + fileName + " (" + std::strerror(error) + ")");
+    }
+
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Unable to map file: " + fileName + " (" + std::strerror(error) + ")");
+        }
+        data_ = static_cast<const char*>(address);
+    }
+    ::close(fd);
+
+    advise(hint);
+#ifdef MADV_HUGEPAGE
+    if (hugePages && data_ != nullptr) {
+        // Best effort: not every filesystem supports huge pages for file mappings.
+        ::madvise(const_cast<char*>(data_), size_, MADV_HUGEPAGE);
+    }
+#else
+    (void)hugePages;
+#endif
+}
+
+// Destructor that releases the mapping.
+MappedFile::~MappedFile() {
+    release();
+}
+
+// Move constructor that takes over the mapping of another object.
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+// Move assignment that releases the current mapping and takes over the other one.
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+// Forward the access pattern to the kernel. Advice is a hint, so failures are ignored.
+void MappedFile::advise(AccessHint hint) {
+    if (data_ != nullptr) {
+        ::madvise(const_cast<char*>(data_), size_, toAdvice(hint));
+    }
+}
+
+// Unmap the file.
+void MappedFile::release() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
@@ -0,0 +1,202 @@
+#include "market_capture.h"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "data_collector.h"
+
+namespace {
+
+// Check that a file header carries the capture magic and a supported version.
+bool isCaptureHeader(const capture::FileHeader& header) {
+    return std::memcmp(header.magic, capture::kMagic, sizeof(capture::kMagic)) == 0 && header.version == capture::kVersion;
+}
+
+// Write a whole buffer, retrying short and interrupted writes.
+bool writeAll(int fd, const std::uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+// Open the file for appending. A new (empty) file gets the file header; an existing one must already have it.
+CaptureRecorder::CaptureRecorder(const std::string& fileName)
+    : fileName_(fileName), buffers_(std::max<unsigned>(config::CAPTURE_WRITE_BUFFERS, 1)) {
+    fd_ = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Unable to open capture file: " + fileName + " (" + std::strerror(errno) + ")");
+    }
+
+    struct stat info {};
+    capture::FileHeader header{};
+    bool valid = ::fstat(fd_, &info) == 0;
+    if (valid && info.st_size == 0) {
+        std::memcpy(header.magic, capture::kMagic, sizeof(capture::kMagic));
+        header.version = capture::kVersion;
+        valid = writeAll(fd_, reinterpret_cast<const std::uint8_t*>(&header), sizeof(header));
+    } else if (valid) {
+        valid = ::pread(fd_, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) && isCaptureHeader(header);
+    }
+    if (!valid) {
+        ::close(fd_);
+        throw std::runtime_error("Not a market-data capture file: " + fileName);
+    }
+
+    for (Buffer& buffer : buffers_) {
+        buffer.data.resize(config::CAPTURE_WRITE_BUFFER);
+    }
+    writer_ = std::thread(&CaptureRecorder::writeBuffers, this);
+}
+
+// Write what is left in the buffers. Errors cannot be reported from a destructor, so they are dropped.
+CaptureRecorder::~CaptureRecorder() {
+    handOff();
+    running_.store(false, std::memory_order_release);
+    posted_.fetch_add(1, std::memory_order_release);
+    posted_.notify_one();
+    writer_.join();
+    ::close(fd_);
+}
+
+// Copy the record into the current buffer, handing the buffer to the writer first if the record does not
+// fit. While the writer still holds the buffer that would be next, the record is dropped. A datagram larger
+// than a whole buffer grows an empty one to fit.
+void CaptureRecorder::record(const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp, std::size_t leg) {
+    capture::RecordHeader header{receiveTimestamp, static_cast<std::uint32_t>(size), static_cast<std::uint16_t>(leg), 0};
+    const std::size_t length = sizeof(header) + size;
+    auto current = [this]() -> Buffer* {
+        const std::uint64_t next = handedOff_.load(std::memory_order_relaxed);
+        if (next - written_.load(std::memory_order_acquire) >= buffers_.size()) {
+            return nullptr;
+        }
+        return &buffers_[next % buffers_.size()];
+    };
+
+    Buffer* buffer = current();
+    if (buffer != nullptr && buffer->used > 0 && buffer->used + length > buffer->data.size()) {
+        handOff();
+        buffer = current();
+    }
+    if (buffer == nullptr) {
+        lost_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (length > buffer->data.size()) {
+        buffer->data.resize(length);
+    }
+    std::memcpy(buffer->data.data() + buffer->used, &header, sizeof(header));
+    std::memcpy(buffer->data.data() + buffer->used + sizeof(header), data, size);
+    buffer->used += length;
+    ++buffer->records;
+}
+
+// Hand the buffered records to the writer and wait for it. Failures are reported once, by the first flush
+// after them.
+void CaptureRecorder::flush() {
+    handOff();
+    const std::uint64_t target = handedOff_.load(std::memory_order_relaxed);
+    for (std::uint64_t seen = written_.load(std::memory_order_acquire); seen < target;
+         seen = written_.load(std::memory_order_acquire)) {
+        written_.wait(seen, std::memory_order_acquire);
+    }
+    const std::uint64_t failures = failedWrites_.load(std::memory_order_acquire);
+    if (failures != reportedFailures_) {
+        reportedFailures_ = failures;
+        throw std::runtime_error("Unable to write capture file: " + fileName_ + " (" +
+                                 std::strerror(writeError_.load(std::memory_order_relaxed)) + ")");
+    }
+}
+
+// Publish the buffer by raising the hand-off counter, then wake the writer. The current buffer is left
+// alone while the writer still holds it.
+void CaptureRecorder::handOff() {
+    const std::uint64_t next = handedOff_.load(std::memory_order_relaxed);
+    if (next - written_.load(std::memory_order_acquire) >= buffers_.size() ||
+        buffers_[next % buffers_.size()].used == 0) {
+        return;
+    }
+    handedOff_.store(next + 1, std::memory_order_release);
+    posted_.fetch_add(1, std::memory_order_release);
+    posted_.notify_one();
+}
+
+// Sleeps until something is posted, then writes every buffer handed off so far. A failed write loses the
+// whole buffer; the records already in the file stay readable. The thread exits after the stop is posted
+// and the last buffers are written.
+void CaptureRecorder::writeBuffers() {
+    std::uint64_t seen = 0;
+    while (true) {
+        posted_.wait(seen, std::memory_order_acquire);
+        seen = posted_.load(std::memory_order_acquire);
+
+        // Read the stop before the hand-offs, so the ones made before stopping are written too.
+        const bool stopping = !running_.load(std::memory_order_acquire);
+        const std::uint64_t target = handedOff_.load(std::memory_order_acquire);
+        for (std::uint64_t next = written_.load(std::memory_order_relaxed); next < target; ++next) {
+            Buffer& buffer = buffers_[next % buffers_.size()];
+            if (writeAll(fd_, buffer.data.data(), buffer.used)) {
+                recorded_.fetch_add(buffer.records, std::memory_order_release);
+            } else {
+                writeError_.store(errno, std::memory_order_relaxed);
+                lost_.fetch_add(buffer.records, std::memory_order_release);
+                failedWrites_.fetch_add(1, std::memory_order_release);
+            }
+            buffer.used = 0;
+            buffer.records = 0;
+            written_.store(next + 1, std::memory_order_release);
+            written_.notify_all();
+        }
+
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+// Map the file, check its header and index the complete records.
+CaptureReplayer::CaptureReplayer(const std::string& fileName) : file_(fileName, MappedFile::AccessHint::Sequential) {
+    capture::FileHeader header{};
+    if (file_.size() < sizeof(header)) {
+        throw std::runtime_error("Not a market-data capture file: " + fileName);
+    }
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (!isCaptureHeader(header)) {
+        throw std::runtime_error("Not a market-data capture file: " + fileName);
+    }
+
+    for (std::size_t offset = sizeof(header); offset + sizeof(capture::RecordHeader) <= file_.size();) {
+        capture::RecordHeader record;
+        std::memcpy(&record, file_.data() + offset, sizeof(record));
+        offset += sizeof(record);
+        if (record.size > file_.size() - offset) {
+            break;
+        }
+        if (datagrams_++ == 0) {
+            firstTimestamp_ = record.receiveTimestamp;
+        }
+        lastTimestamp_ = record.receiveTimestamp;
+        offset += record.size;
+    }
+}
+
+// Feed every datagram to the collector as if it had just been received.
+std::size_t CaptureReplayer::replay(DataCollector& collector, double speed) {
+    return replay(
+        [&collector](const std::uint8_t* data, std::size_t size, std::int64_t receiveTimestamp, std::size_t leg) {
+            collector.inject(data, size, receiveTimestamp, leg);
+        },
+        speed);
+}
@@ -0,0 +1,38 @@
+#include "sequence_tracker.h"
+
+// Constructor that sets the reordering tolerance and the buffer limit.
+SequenceTracker::SequenceTracker(std::size_t reorderWindow, std::size_t maxBuffered)
+    : reorderWindow_(reorderWindow), maxBuffered_(maxBuffered) {}
+
+// Buffer every packet from now on. The packets already buffered are kept for the replay.
+void SequenceTracker::beginRecovery() {
+    recovering_ = true;
+    gapDetected_ = false;
+}
+
+// Copy an early packet into the buffer. A packet that is already buffered is a duplicate.
+// When the buffer is full the packet is dropped; the hole it leaves is found and recovered later.
+void SequenceTracker::buffer(std::uint64_t sequence, std::uint16_t count, const std::uint8_t* payload, std::size_t size,
+                             std::int64_t receiveTimestamp) {
+    if (buffered_.count(sequence) != 0) {
+        ++duplicates_;
+        return;
+    }
+    if (buffered_.size() >= maxBuffered_) {
+        ++overflows_;
+        return;
+    }
+    buffered_.emplace(sequence, BufferedPacket{count, receiveTimestamp, std::vector<std::uint8_t>(payload, payload + size)});
+    updateGap();
+}
+
+// A hole is a gap once more packets than the reordering window are waiting behind it.
+// Nothing is a gap while a recovery is running: the snapshot will fill it.
+void SequenceTracker::updateGap() {
+    if (recovering_ || buffered_.size() <= reorderWindow_) {
+        gapDetected_ = false;
+    } else if (!gapDetected_) {
+        gapDetected_ = true;
+        ++gaps_;
+    }
+}
@@ -0,0 +1,111 @@
+#include "sharded_data_processor.h"
+#include <pthread.h>
+#include <iostream>
+#include <stdexcept>
+
+// Constructor that creates the shards and starts their threads.
+ShardedDataProcessor::ShardedDataProcessor(std::size_t shardCount, BarType barType, double barThreshold) {
+    if (shardCount == 0) {
+        throw std::runtime_error("ShardedDataProcessor needs at least one shard");
+    }
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>(barType, barThreshold));
+    }
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        Shard& shard = *shards_[i];
+        shard.thread = std::thread(&ShardedDataProcessor::run, this, std::ref(shard), i);
+
+        if (config::DATA_PROCESSOR_FIRST_CPU >= 0) {
+            const int cpu = config::DATA_PROCESSOR_FIRST_CPU + static_cast<int>(i);
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            if (pthread_setaffinity_np(shard.thread.native_handle(), sizeof(cpus), &cpus) != 0) {
+                std::cerr << "Unable to pin data processor shard " << i << " to CPU " << cpu << std::endl;
+            }
+        }
+    }
+}
+
+// Lets the shards finish their rings, then stops them.
+ShardedDataProcessor::~ShardedDataProcessor() {
+    waitUntilIdle();
+    running_.store(false, std::memory_order_relaxed);
+    for (const auto& shard : shards_) {
+        post(*shard);
+        shard->thread.join();
+    }
+}
+
+// Rows are pushed one by one into the ring of their instrument's shard. When a ring is full,
+// its shard is woken up and the dispatcher yields until there is room again.
+void ShardedDataProcessor::dispatch(const TickBatch& batch) {
+    const auto ids = batch.instrumentIds();
+    for (std::size_t row = 0; row < batch.size(); ++row) {
+        Shard& shard = *shards_[shardOf(ids[row])];
+        const Tick tick = batch.at(row);
+        while (!shard.ring.tryPush(tick)) {
+            post(shard);
+            std::this_thread::yield();
+        }
+    }
+    for (const auto& shard : shards_) {
+        post(*shard);
+    }
+}
+
+// Dispatches, then waits for the shards.
+void ShardedDataProcessor::process(const TickBatch& batch) {
+    dispatch(batch);
+    waitUntilIdle();
+}
+
+// Sleeps on each shard's progress counter until it has caught up with what was posted to it.
+void ShardedDataProcessor::waitUntilIdle() {
+    for (const auto& shard : shards_) {
+        const std::uint64_t target = shard->posted.load(std::memory_order_acquire);
+        for (std::uint64_t seen = shard->processed.load(std::memory_order_acquire); seen < target;
+             seen = shard->processed.load(std::memory_order_acquire)) {
+            shard->processed.wait(seen, std::memory_order_acquire);
+        }
+    }
+}
+
+// Looks the book up in the shard that owns the instrument.
+const L2Book* ShardedDataProcessor::book(InstrumentId instrumentId) const {
+    return processor(shardOf(instrumentId)).books().find(instrumentId);
+}
+
+// Bump the shard's posted counter and wake its thread.
+void ShardedDataProcessor::post(Shard& shard) {
+    shard.posted.fetch_add(1, std::memory_order_release);
+    shard.posted.notify_one();
+}
+
+// Waits for posted rows, then drains the ring in batches: each batch is processed by the shard's own
+// DataProcessor, aggregated into bars and handed to the handlers, all on this thread.
+void ShardedDataProcessor::run(Shard& shard, std::size_t index) {
+    std::uint64_t seen = 0;
+    while (true) {
+        shard.posted.wait(seen, std::memory_order_acquire);
+        seen = shard.posted.load(std::memory_order_acquire);
+
+        while (shard.processor.drain(shard.ring, shard.batch) != 0) {
+            shard.ticks.fetch_add(shard.batch.size(), std::memory_order_relaxed);
+            shard.completed.clear();
+            shard.bars.addBatch(shard.batch, [&shard](const Bar& bar) { shard.completed.push_back(bar); });
+            if (batchHandler_ && shard.batch.size() != 0) {
+                batchHandler_(index, shard.batch);
+            }
+            if (barHandler_ && !shard.completed.empty()) {
+                barHandler_(index, shard.completed);
+            }
+        }
+
+        shard.processed.store(seen, std::memory_order_release);
+        shard.processed.notify_all();
+        if (!running_.load(std::memory_order_relaxed)) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#include "snapshot_source.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+// Constructor that sets the directory the snapshot files are read from.
+FileSnapshotSource::FileSnapshotSource(const std::string& directory) : directory_(directory) {}
+
+// Read the sequence number and the messages of the channel's snapshot file.
+Snapshot FileSnapshotSource::requestSnapshot(std::uint16_t channel) {
+    const std::string name = fileName(channel);
+    std::ifstream file(name, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open snapshot file: " + name);
+    }
+
+    unsigned char sequence[8];
+    if (!file.read(reinterpret_cast<char*>(sequence), sizeof(sequence))) {
+        throw std::runtime_error("Snapshot file is truncated: " + name);
+    }
+
+    Snapshot snapshot;
+    for (unsigned char byte : sequence) {
+        snapshot.nextSequence = (snapshot.nextSequence << 8) | byte;
+    }
+    snapshot.messages.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return snapshot;
+}
+
+// Write the big-endian sequence number followed by the messages.
+void FileSnapshotSource::write(const std::string& fileName, const Snapshot& snapshot) {
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to create snapshot file: " + fileName);
+    }
+
+    unsigned char sequence[8];
+    for (int i = 0; i < 8; ++i) {
+        sequence[i] = static_cast<unsigned char>(snapshot.nextSequence >> (56 - 8 * i));
+    }
+    file.write(reinterpret_cast<const char*>(sequence), sizeof(sequence));
+    file.write(reinterpret_cast<const char*>(snapshot.messages.data()), static_cast<std::streamsize>(snapshot.messages.size()));
+}
+
+// Snapshot files are named after their channel.
+std::string FileSnapshotSource::fileName(std::uint16_t channel) const {
+    return directory_ + "/channel-" + std::to_string(channel) + ".snapshot";
+}
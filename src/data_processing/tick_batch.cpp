@@ -0,0 +1,155 @@
+#include "tick_batch.h"
+#include <charconv>
+
+// Reserve the same capacity in every column.
+void TickBatch::reserve(std::size_t capacity) {
+    timestamps_.reserve(capacity);
+    instrumentIds_.reserve(capacity);
+    bidPrices_.reserve(capacity);
+    askPrices_.reserve(capacity);
+    bidSizes_.reserve(capacity);
+    askSizes_.reserve(capacity);
+    tradePrices_.reserve(capacity);
+    tradeQuantities_.reserve(capacity);
+    receiveTimestamps_.reserve(capacity);
+}
+
+// Resize every column to the same length.
+void TickBatch::resize(std::size_t size) {
+    timestamps_.resize(size);
+    instrumentIds_.resize(size);
+    bidPrices_.resize(size);
+    askPrices_.resize(size);
+    bidSizes_.resize(size);
+    askSizes_.resize(size);
+    tradePrices_.resize(size);
+    tradeQuantities_.resize(size);
+    receiveTimestamps_.resize(size);
+}
+
+// Drop all rows; the vectors keep their capacity so the batch can be refilled without allocating.
+void TickBatch::clear() {
+    resize(0);
+}
+
+// Append one tick by pushing each field onto its column.
+void TickBatch::append(const Tick& tick) {
+    timestamps_.push_back(tick.timestamp);
+    instrumentIds_.push_back(tick.instrumentId);
+    bidPrices_.push_back(tick.bidPrice);
+    askPrices_.push_back(tick.askPrice);
+    bidSizes_.push_back(tick.bidSize);
+    askSizes_.push_back(tick.askSize);
+    tradePrices_.push_back(tick.tradePrice);
+    tradeQuantities_.push_back(tick.tradeQuantity);
+    receiveTimestamps_.push_back(tick.receiveTimestamp);
+}
+
+// Gather the fields of one row into a Tick.
+Tick TickBatch::at(std::size_t row) const {
+    Tick tick;
+    tick.timestamp = timestamps_[row];
+    tick.instrumentId = instrumentIds_[row];
+    tick.bidPrice = bidPrices_[row];
+    tick.askPrice = askPrices_[row];
+    tick.bidSize = bidSizes_[row];
+    tick.askSize = askSizes_[row];
+    tick.tradePrice = tradePrices_[row];
+    tick.tradeQuantity = tradeQuantities_[row];
+    tick.receiveTimestamp = receiveTimestamps_[row];
+    return tick;
+}
+
+// Copy one row over another, column by column.
+void TickBatch::moveRow(std::size_t from, std::size_t to) {
+    timestamps_[to] = timestamps_[from];
+    instrumentIds_[to] = instrumentIds_[from];
+    bidPrices_[to] = bidPrices_[from];
+    askPrices_[to] = askPrices_[from];
+    bidSizes_[to] = bidSizes_[from];
+    askSizes_[to] = askSizes_[from];
+    tradePrices_[to] = tradePrices_[from];
+    tradeQuantities_[to] = tradeQuantities_[from];
+    receiveTimestamps_[to] = receiveTimestamps_[from];
+}
+
+namespace {
+
+// Parse exactly `width` decimal digits starting at `pos`.
+bool parseDigits(std::string_view text, std::size_t pos, std::size_t width, int& value) {
+    if (pos + width > text.size()) {
+        return false;
+    }
+    value = 0;
+    for (std::size_t i = pos; i < pos + width; ++i) {
+        const char c = text[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+// Number of days between 1970-01-01 and the given civil date (proleptic Gregorian calendar).
+std::int64_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2 ? 1 : 0;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = year - era * 400;
+    const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return static_cast<std::int64_t>(era) * 146097 + dayOfEra - 719468;
+}
+
+} // namespace
+
+// Parse either an ISO-8601 style date/time or a raw integer nanosecond count.
+bool parseTimestamp(std::string_view text, std::int64_t& nanos) {
+    constexpr std::int64_t kNanosPerSecond = 1'000'000'000;
+
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-') {
+        // Not a calendar date; accept a plain integer value.
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), nanos);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    int year = 0, month = 0, day = 0;
+    if (!parseDigits(text, 0, 4, year) || !parseDigits(text, 5, 2, month) || !parseDigits(text, 8, 2, day) ||
+        month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+
+    std::int64_t seconds = daysFromCivil(year, month, day) * 86400;
+    std::int64_t fraction = 0;
+
+    if (text.size() > 10) {
+        int hour = 0, minute = 0, second = 0;
+        if ((text[10] != ' ' && text[10] != 'T') || text.size() < 19 || text[13] != ':' || text[16] != ':' ||
+            !parseDigits(text, 11, 2, hour) || !parseDigits(text, 14, 2, minute) ||
+            !parseDigits(text, 17, 2, second)) {
+            return false;
+        }
+        seconds += hour * 3600 + minute * 60 + second;
+
+        std::size_t pos = 19;
+        if (pos < text.size() && text[pos] == '.') {
+            // Up to nine fractional digits; anything beyond nanosecond precision is ignored.
+            std::int64_t scale = kNanosPerSecond;
+            for (++pos; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+                if (scale > 1) {
+                    scale /= 10;
+                    fraction += (text[pos] - '0') * scale;
+                }
+            }
+        }
+        if (pos < text.size() && text[pos] == 'Z') {
+            ++pos;
+        }
+        if (pos != text.size()) {
+            return false;
+        }
+    }
+
+    nanos = seconds * kNanosPerSecond + fraction;
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "logger.h"
+#include "tsc_clock.h"
 #include <iostream>  // Optional: For console output to indicate the logging status
 #include <future>    // For async operations
 
@@ -14,9 +15,11 @@ Logger::Logger(const std::string& logFile)
 
 // Log a message by appending it to the log file asynchronously.
 void Logger::log(const std::string& message) {
+    // The timestamp is taken on the caller's thread, when the event happened
+    const std::int64_t timestamp = TscClock::now();
     // Asynchronous logging to avoid blocking the main thread
-    std::async(std::launch::async, [this, message]() {
-        logStream_ << message << std::endl;
+    std::async(std::launch::async, [this, message, timestamp]() {
+        logStream_ << timestamp << ' ' << message << std::endl;
     });
 }
 
@@ -6,10 +6,62 @@ void Monitor::addMetric(const std::string& name, double value) {
     metrics_.emplace_back(name, value);
 }
 
-// Report all stored metrics by iterating over the vector and printing each name-value pair.
+// Set an instrument metric by indexing the per-instrument array.
+void Monitor::setInstrumentMetric(InstrumentId instrument, InstrumentMetric metric, double value) {
+    if (InstrumentMetrics* metrics = metricsOf(instrument)) {
+        (*metrics)[static_cast<std::size_t>(metric)] = value;
+    }
+}
+
+// Add to an instrument metric by indexing the per-instrument array.
+void Monitor::addInstrumentMetric(InstrumentId instrument, InstrumentMetric metric, double delta) {
+    if (InstrumentMetrics* metrics = metricsOf(instrument)) {
+        (*metrics)[static_cast<std::size_t>(metric)] += delta;
+    }
+}
+
+// Read an instrument metric, treating unknown instruments as all zero.
+double Monitor::instrumentMetric(InstrumentId instrument, InstrumentMetric metric) const {
+    if (instrument >= instrumentMetrics_.size()) {
+        return 0.0;
+    }
+    return instrumentMetrics_[instrument][static_cast<std::size_t>(metric)];
+}
+
+// Report all stored metrics by iterating over the vector and printing each name-value pair,
+// then print one line per instrument that has a non-zero metric.
 void Monitor::reportMetrics() const {
+    static constexpr const char* kNames[] = {"position", "exposure", "pnl", "orders"};
+
     std::cout << "System Metrics:" << std::endl;
     for (const auto& metric : metrics_) {
         std::cout << metric.first << ": " << metric.second << std::endl;
     }
+    for (std::size_t id = 0; id < instrumentMetrics_.size(); ++id) {
+        const InstrumentMetrics& metrics = instrumentMetrics_[id];
+        bool any = false;
+        for (double value : metrics) {
+            any = any || value != 0.0;
+        }
+        if (!any) {
+            continue;
+        }
+        std::cout << "Instrument " << id << ":";
+        for (std::size_t i = 0; i < metrics.size(); ++i) {
+            std::cout << " " << kNames[i] << "=" << metrics[i];
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Grow the array on the first metric of a new instrument. Invalid ids are reported and get no metrics.
+Monitor::InstrumentMetrics* Monitor::metricsOf(InstrumentId instrument) {
+    if (!isValidInstrument(instrument)) {
+        std::cerr << "Ignoring metric of invalid instrument id " << instrument << std::endl;
+        return nullptr;
+    }
+    if (instrument >= instrumentMetrics_.size()) {
+        instrumentMetrics_.resize(instrument + 1, InstrumentMetrics{});
+    }
+    return &instrumentMetrics_[instrument];
 }
@@ -10,11 +10,16 @@
 #include "logger.h"
 #include "monitor.h"
 #include "security.h"  // Подключаем модуль безопасности для шифрования и подписей
+#include "tsc_clock.h"
 #include <iostream>
 #include <memory>
 #include <openssl/aes.h>  // For AES encryption
 
 int main() {
+    // Calibrate the TSC clock before any thread reads it, then keep it aligned with the system clocks
+    TscClock::calibrate();
+    TscClock::startDriftCorrection();
+
     // Initialize UI Manager
     UIManager uiManager;
 
@@ -99,5 +104,6 @@ int main() {
     
     encryption_result_free(&encrypted_log);
     logger.log("Trading system shutdown.");
+    TscClock::stopDriftCorrection();
     return 0;
 }
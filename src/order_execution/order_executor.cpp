@@ -1,5 +1,6 @@
 #include "order_executor.h"
 #include "security.h"  // Подключаем модуль безопасности для подписи
+#include "tsc_clock.h"
 #include <iostream>  // For printing order execution information
 #include <atomic>    // For atomic operations in multithreaded environments
 #include <xmmintrin.h>  // For SIMD prefetching
@@ -14,6 +15,42 @@ OrderExecutor::OrderExecutor(const std::string& exchangeUrl)
 // Sends an order to the exchange.
 // If the exchange is connected, a unique order ID is generated and the order is signed and sent.
 void OrderExecutor::sendOrder(const std::string& orderDetails) {
+    submit(orderDetails);
+}
+
+// Sends an order for an instrument id. The position array grows the first time an instrument is traded,
+// so the lookup afterwards is a plain index instead of a hash of the symbol. The tick-to-trade sample is
+// taken on the same clock that stamped the market data.
+bool OrderExecutor::sendOrder(InstrumentId instrument, std::int64_t quantity, double price, std::int64_t triggerTimestamp) {
+    if (!isValidInstrument(instrument)) {
+        std::cerr << "Failed to send order. Invalid instrument id: " << instrument << std::endl;
+        return false;
+    }
+    if (quantity == 0) {
+        return false;
+    }
+    const std::string details = std::string(quantity > 0 ? "Buy " : "Sell ") + std::to_string(quantity > 0 ? quantity : -quantity) +
+                                " of instrument " + std::to_string(instrument) + " at " + std::to_string(price);
+    if (!submit(details)) {
+        return false;
+    }
+    if (triggerTimestamp != 0) {
+        tickToTrade_.add(TscClock::now() - triggerTimestamp);
+    }
+    if (instrument >= positions_.size()) {
+        positions_.resize(instrument + 1, 0);
+    }
+    positions_[instrument] += quantity;
+    return true;
+}
+
+// Returns the net position of an instrument by index.
+std::int64_t OrderExecutor::position(InstrumentId instrument) const {
+    return instrument < positions_.size() ? positions_[instrument] : 0;
+}
+
+// Signs the order details and sends them if the exchange is connected.
+bool OrderExecutor::submit(const std::string& orderDetails) {
     if (exchangeConnector_.isConnected()) {
         // Prefetching the order details into the cache to reduce latency
         _mm_prefetch(orderDetails.data(), _MM_HINT_T0);
@@ -36,12 +73,13 @@ void OrderExecutor::sendOrder(const std::string& orderDetails) {
 
             // После использования освобождаем память
             encryption_result_free(&signature);
-        } else {
-            std::cerr << "Failed to sign the order." << std::endl;
+            return true;
         }
+        std::cerr << "Failed to sign the order." << std::endl;
     } else {
         std::cout << "Failed to send order. Not connected to the exchange." << std::endl;
     }
+    return false;
 }
 
 // Checks the status of an order.
@@ -1,5 +1,7 @@
 #include "exposure_limit_risk_strategy.h"
 #include "hash_utils.h"  // Подключаем модуль безопасности для хеширования
+#include <algorithm> // For std::max
+#include <cmath>     // For std::fabs
 #include <iostream>  // For outputting risk alerts
 
 // Constructor to initialize the maximum allowed exposure.
@@ -28,10 +30,30 @@ void ExposureLimitRiskStrategy::updateExposure(double currentExposure) {
     hash_result_free(&hash_result);  // Очистка после хеширования
 }
 
-// Evaluate the risk based on the current exposure.
-// If the current exposure exceeds the allowed threshold, it prints an alert and returns `false`.
+// Update one instrument's exposure and adjust the total of the instruments by |new| - |old|, in O(1).
+// The system exposure set by updateExposure(double) is kept apart.
+void ExposureLimitRiskStrategy::updateExposure(InstrumentId instrument, double exposure) {
+    if (!isValidInstrument(instrument)) {
+        std::cerr << "Failed to update exposure: invalid instrument id " << instrument << std::endl;
+        return;
+    }
+    if (instrument >= instrumentExposures_.size()) {
+        instrumentExposures_.resize(instrument + 1, 0.0);
+    }
+    instrumentTotal_ += std::fabs(exposure) - std::fabs(instrumentExposures_[instrument]);
+    instrumentTotal_ = std::max(instrumentTotal_, 0.0);  // Rounding must not leave a negative total
+    instrumentExposures_[instrument] = exposure;
+}
+
+// Return the exposure of an instrument by index.
+double ExposureLimitRiskStrategy::exposure(InstrumentId instrument) const {
+    return instrument < instrumentExposures_.size() ? instrumentExposures_[instrument] : 0.0;
+}
+
+// Evaluate the risk based on the current exposure of the system and the total of the instruments.
+// If either exceeds the allowed threshold, it prints an alert and returns `false`.
 bool ExposureLimitRiskStrategy::evaluateRisk() {
-    if (currentExposure_ > maxAllowedExposure_) {
+    if (currentExposure_ > maxAllowedExposure_ || instrumentTotal_ > maxAllowedExposure_) {
         std::cout << "Risk Alert: Exposure limit exceeded!" << std::endl;
         return false;  // Risk is too high
     }
@@ -28,10 +28,33 @@ void MaxDrawdownRiskStrategy::updateDrawdown(double currentDrawdown) {
     hash_result_free(&hash_result);  // Очистка памяти после хеширования
 }
 
-// Evaluate the risk based on the current drawdown.
-// If the current drawdown exceeds the allowed threshold, it prints an alert and returns `false`.
+// Update one instrument's drawdown. The count of instruments in breach is adjusted from the old and new
+// values, so evaluateRisk() does not need to look at every instrument.
+void MaxDrawdownRiskStrategy::updateDrawdown(InstrumentId instrument, double drawdown) {
+    if (!isValidInstrument(instrument)) {
+        std::cerr << "Failed to update drawdown: invalid instrument id " << instrument << std::endl;
+        return;
+    }
+    if (instrument >= instrumentDrawdowns_.size()) {
+        instrumentDrawdowns_.resize(instrument + 1, 0.0);
+    }
+    const bool wasInBreach = instrumentDrawdowns_[instrument] > maxAllowedDrawdown_;
+    const bool inBreach = drawdown > maxAllowedDrawdown_;
+    if (inBreach != wasInBreach) {
+        inBreach ? ++instrumentsInBreach_ : --instrumentsInBreach_;
+    }
+    instrumentDrawdowns_[instrument] = drawdown;
+}
+
+// Return the drawdown of an instrument by index.
+double MaxDrawdownRiskStrategy::drawdown(InstrumentId instrument) const {
+    return instrument < instrumentDrawdowns_.size() ? instrumentDrawdowns_[instrument] : 0.0;
+}
+
+// Evaluate the risk based on the current drawdown of the system and of each instrument.
+// If a drawdown exceeds the allowed threshold, it prints an alert and returns `false`.
 bool MaxDrawdownRiskStrategy::evaluateRisk() {
-    if (currentDrawdown_ > maxAllowedDrawdown_) {
+    if (currentDrawdown_ > maxAllowedDrawdown_ || instrumentsInBreach_ != 0) {
         std::cout << "Risk Alert: Maximum drawdown exceeded!" << std::endl;
         return false;  // Risk is too high
     }
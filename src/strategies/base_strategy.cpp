@@ -2,6 +2,17 @@
 
 #include "base_strategy.h"
 
-// The implementation file for BaseStrategy is empty because it is an abstract class.
-// This file is reserved for any shared logic or helper functions that might be common across multiple strategies.
-// If any base functionality is required by all strategies, it can be implemented here in the future.
+// Default batch handler: deliver every row as typed events.
+void BaseStrategy::onBatch(const TickBatch& batch) {
+    decodeEvents(
+        batch, tickSizes_, [this](const BookUpdate& update) { onBookUpdate(update); },
+        [this](const Trade& trade) { onTrade(trade); });
+}
+
+// Copies the tick sizes into a flat array, so the callback path reads them without touching the registry.
+void BaseStrategy::setInstruments(const InstrumentRegistry& registry) {
+    tickSizes_.resize(registry.size());
+    for (InstrumentId id = 0; id < registry.size(); ++id) {
+        tickSizes_[id] = registry.info(id).tickSize;
+    }
+}
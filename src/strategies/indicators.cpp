@@ -0,0 +1,581 @@
+#include "indicators.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include "../config/settings.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define INDICATORS_HAVE_AVX2 1
+#define INDICATORS_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace indicators {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Rows per block. Each block of a windowed sum starts from a directly computed sum, and the scratch
+// buffers hold one block, so they stay in the L1/L2 cache.
+constexpr std::size_t kBlockRows = 4096;
+
+// Check once whether the CPU can run the AVX2 kernels.
+bool cpuHasAvx2() {
+#ifdef INDICATORS_HAVE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+std::atomic<SimdLevel> selectedLevel{config::INDICATORS_USE_AVX2 && cpuHasAvx2() ? SimdLevel::Avx2
+                                                                                   : SimdLevel::Scalar};
+
+bool useAvx2() {
+    return selectedLevel.load(std::memory_order_relaxed) == SimdLevel::Avx2;
+}
+
+// Check the window and the output sizes of a batch function.
+void checkArguments(std::size_t window, std::size_t rows, std::span<double> out) {
+    if (window == 0) {
+        throw std::runtime_error("Indicator window must not be empty");
+    }
+    if (out.size() < rows) {
+        throw std::runtime_error("Indicator output is shorter than its input");
+    }
+}
+
+// Series whose windowed sums the batch functions take. Each gives the value of a row, one at a time or
+// four at a time, computed on the fly from the input columns so it never has to be stored.
+
+// The values themselves.
+struct Values {
+    const double* values;
+    double at(std::size_t row) const { return values[row]; }
+#ifdef INDICATORS_HAVE_AVX2
+    INDICATORS_AVX2 __m256d at4(std::size_t row) const { return _mm256_loadu_pd(values + row); }
+#endif
+};
+
+// Deviations of the values from a fixed center, which keeps the sums small.
+struct Deviations {
+    const double* values;
+    double center;
+    double at(std::size_t row) const { return values[row] - center; }
+#ifdef INDICATORS_HAVE_AVX2
+    INDICATORS_AVX2 __m256d at4(std::size_t row) const {
+        return _mm256_sub_pd(_mm256_loadu_pd(values + row), _mm256_set1_pd(center));
+    }
+#endif
+};
+
+// Squared deviations of the values from a fixed center.
+struct Squares {
+    const double* values;
+    double center;
+    double at(std::size_t row) const { return (values[row] - center) * (values[row] - center); }
+#ifdef INDICATORS_HAVE_AVX2
+    INDICATORS_AVX2 __m256d at4(std::size_t row) const {
+        const __m256d deviation = _mm256_sub_pd(_mm256_loadu_pd(values + row), _mm256_set1_pd(center));
+        return _mm256_mul_pd(deviation, deviation);
+    }
+#endif
+};
+
+#ifdef INDICATORS_HAVE_AVX2
+// Convert four integers below 2^51 in magnitude to doubles. AVX2 has no such instruction; adding the
+// integer to the bit pattern of 1.5 * 2^52 places it in the mantissa, and subtracting 1.5 * 2^52 as a
+// double leaves its value.
+INDICATORS_AVX2 inline __m256d toDouble(const std::int64_t* integers) {
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);  // 1.5 * 2^52
+    const __m256i bits = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(integers)),
+                                          _mm256_castpd_si256(magic));
+    return _mm256_sub_pd(_mm256_castsi256_pd(bits), magic);
+}
+#endif
+
+// Traded quantities.
+struct Quantities {
+    const std::int64_t* quantities;
+    double at(std::size_t row) const { return static_cast<double>(quantities[row]); }
+#ifdef INDICATORS_HAVE_AVX2
+    INDICATORS_AVX2 __m256d at4(std::size_t row) const { return toDouble(quantities + row); }
+#endif
+};
+
+// Traded notionals (price * quantity).
+struct Notionals {
+    const double* prices;
+    const std::int64_t* quantities;
+    double at(std::size_t row) const { return prices[row] * static_cast<double>(quantities[row]); }
+#ifdef INDICATORS_HAVE_AVX2
+    INDICATORS_AVX2 __m256d at4(std::size_t row) const {
+        return _mm256_mul_pd(_mm256_loadu_pd(prices + row), toDouble(quantities + row));
+    }
+#endif
+};
+
+// Scalar kernels.
+
+// y[i] = c * y[i - 1] + y[i] over `count` elements, starting from y[-1] = carry.
+void scanScalar(double* data, std::size_t count, double c, double carry) {
+    for (std::size_t i = 0; i < count; ++i) {
+        carry = c * carry + data[i];
+        data[i] = carry;
+    }
+}
+
+// out[i - first] = series(i) - series(i - window) for i in [first, last).
+template <typename Series>
+void differencesScalar(const Series& series, std::size_t window, std::size_t first, std::size_t last,
+                       double* out) {
+    for (std::size_t row = first; row < last; ++row) {
+        out[row - first] = series.at(row) - series.at(row - window);
+    }
+}
+
+#ifdef INDICATORS_HAVE_AVX2
+// AVX2 kernels. They handle four rows per iteration and finish the last few with the scalar code.
+
+// The recurrence y[i] = c * y[i - 1] + u[i] is solved four elements at a time: two shift-and-add steps
+// give every lane the sum of the inputs of its own and the preceding lanes, weighted by powers of c,
+// and the carry from the previous vector is added with the next powers.
+INDICATORS_AVX2 void scanAvx2(double* data, std::size_t count, double c, double carry) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d c1 = _mm256_set1_pd(c);
+    const __m256d c2 = _mm256_set1_pd(c * c);
+    const __m256d powers = _mm256_setr_pd(c, c * c, c * c * c, c * c * c * c);
+    __m256d carries = _mm256_set1_pd(carry);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_loadu_pd(data + i);
+        const __m256d shifted1 = _mm256_blend_pd(_mm256_permute4x64_pd(v, 0x90), zero, 0x1);  // 0, v0, v1, v2
+        v = _mm256_fmadd_pd(c1, shifted1, v);
+        const __m256d shifted2 = _mm256_permute2f128_pd(v, v, 0x08);                         // 0, 0, v0, v1
+        v = _mm256_fmadd_pd(c2, shifted2, v);
+        v = _mm256_fmadd_pd(powers, carries, v);
+        _mm256_storeu_pd(data + i, v);
+        carries = _mm256_permute4x64_pd(v, 0xFF);
+    }
+    scanScalar(data + i, count - i, c, _mm256_cvtsd_f64(carries));
+}
+
+template <typename Series>
+INDICATORS_AVX2 void differencesAvx2(const Series& series, std::size_t window, std::size_t first,
+                                     std::size_t last, double* out) {
+    std::size_t row = first;
+    for (; row + 4 <= last; row += 4) {
+        _mm256_storeu_pd(out + row - first, _mm256_sub_pd(series.at4(row), series.at4(row - window)));
+    }
+    differencesScalar(series, window, row, last, out + row - first);
+}
+
+// out[i] = data[i] * factor.
+INDICATORS_AVX2 void scaleAvx2(const double* data, std::size_t count, double factor, double* out) {
+    const __m256d scale = _mm256_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), scale));
+    }
+    for (; i < count; ++i) {
+        out[i] = data[i] * factor;
+    }
+}
+
+// numerators[i] /= denominators[i], NaN where the denominator is 0. Returns the number of rows done.
+INDICATORS_AVX2 std::size_t divideAvx2(double* numerators, const double* denominators, std::size_t count) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d nan = _mm256_set1_pd(kNaN);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d denominator = _mm256_loadu_pd(denominators + i);
+        const __m256d ratio = _mm256_div_pd(_mm256_loadu_pd(numerators + i), denominator);
+        const __m256d empty = _mm256_cmp_pd(denominator, zero, _CMP_EQ_OQ);
+        _mm256_storeu_pd(numerators + i, _mm256_blendv_pd(ratio, nan, empty));
+    }
+    return i;
+}
+
+// Turn window sums into Bollinger bands in place (see bollinger()). Returns the number of rows done.
+INDICATORS_AVX2 std::size_t bandsAvx2(double* sums, double* squareSums, double* lower, std::size_t count,
+                                      double n, double center, double degrees, double width) {
+    const __m256d centers = _mm256_set1_pd(center);
+    const __m256d inverseN = _mm256_set1_pd(1.0 / n);
+    const __m256d inverseDegrees = _mm256_set1_pd(1.0 / degrees);
+    const __m256d bandWidth = _mm256_set1_pd(width);
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d deviation = _mm256_loadu_pd(sums + i);
+        const __m256d m2 = _mm256_fnmadd_pd(_mm256_mul_pd(deviation, deviation), inverseN,
+                                            _mm256_loadu_pd(squareSums + i));
+        const __m256d variance = _mm256_max_pd(_mm256_mul_pd(m2, inverseDegrees), zero);
+        const __m256d band = _mm256_mul_pd(bandWidth, _mm256_sqrt_pd(variance));
+        const __m256d mean = _mm256_fmadd_pd(deviation, inverseN, centers);
+        _mm256_storeu_pd(sums + i, mean);
+        _mm256_storeu_pd(squareSums + i, _mm256_add_pd(mean, band));
+        _mm256_storeu_pd(lower + i, _mm256_sub_pd(mean, band));
+    }
+    return i;
+}
+
+// Split the changes of values[first - 1 .. last) into gains and losses, divided by the period.
+// Returns the number of rows done.
+INDICATORS_AVX2 std::size_t changesAvx2(const double* values, std::size_t first, std::size_t last,
+                                        double inversePeriod, double* gains, double* losses) {
+    const __m256d scale = _mm256_set1_pd(inversePeriod);
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t row = first;
+    for (; row + 4 <= last; row += 4) {
+        const __m256d change = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(values + row),
+                                                           _mm256_loadu_pd(values + row - 1)), scale);
+        _mm256_storeu_pd(gains + row - first, _mm256_max_pd(change, zero));
+        _mm256_storeu_pd(losses + row - first, _mm256_max_pd(_mm256_sub_pd(zero, change), zero));
+    }
+    return row - first;
+}
+
+// gains[i] = 100 * gains[i] / (gains[i] + losses[i]), 50 where both are 0. Returns the number of rows done.
+INDICATORS_AVX2 std::size_t strengthAvx2(double* gains, const double* losses, std::size_t count) {
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d neutral = _mm256_set1_pd(50.0);
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d gain = _mm256_loadu_pd(gains + i);
+        const __m256d total = _mm256_add_pd(gain, _mm256_loadu_pd(losses + i));
+        const __m256d strength = _mm256_div_pd(_mm256_mul_pd(hundred, gain), total);
+        const __m256d flat = _mm256_cmp_pd(total, zero, _CMP_LE_OQ);
+        _mm256_storeu_pd(gains + i, _mm256_blendv_pd(strength, neutral, flat));
+    }
+    return i;
+}
+
+// out[i] = better(tails[i], out[i]), for the maximum or the minimum. Returns the number of rows done.
+template <bool kMaximum>
+INDICATORS_AVX2 std::size_t combineAvx2(const double* tails, double* out, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d tail = _mm256_loadu_pd(tails + i);
+        const __m256d head = _mm256_loadu_pd(out + i);
+        _mm256_storeu_pd(out + i, kMaximum ? _mm256_max_pd(tail, head) : _mm256_min_pd(tail, head));
+    }
+    return i;
+}
+#endif
+
+// out[i] = data[i] * factor.
+void scale(const double* data, std::size_t count, double factor, double* out) {
+#ifdef INDICATORS_HAVE_AVX2
+    if (useAvx2()) {
+        scaleAvx2(data, count, factor, out);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = data[i] * factor;
+    }
+}
+
+// y[i] = c * y[i - 1] + y[i], starting from y[-1] = carry.
+void scan(double* data, std::size_t count, double c, double carry) {
+#ifdef INDICATORS_HAVE_AVX2
+    if (useAvx2()) {
+        scanAvx2(data, count, c, carry);
+        return;
+    }
+#endif
+    scanScalar(data, count, c, carry);
+}
+
+// Sums of `series` over the `window` rows ending at each row of [first, last), written to out[0..).
+// `first` must be at least window - 1. The first sum is computed directly; the others add the row
+// entering the window and subtract the one leaving it, as a prefix sum of the differences.
+template <typename Series>
+void windowSums(const Series& series, std::size_t window, std::size_t first, std::size_t last, double* out) {
+    double sum = 0.0;
+    for (std::size_t row = first + 1 - window; row <= first; ++row) {
+        sum += series.at(row);
+    }
+    out[0] = sum;
+#ifdef INDICATORS_HAVE_AVX2
+    if (useAvx2()) {
+        differencesAvx2(series, window, first + 1, last, out + 1);
+        scanAvx2(out + 1, last - first - 1, 1.0, sum);
+        return;
+    }
+#endif
+    differencesScalar(series, window, first + 1, last, out + 1);
+    scanScalar(out + 1, last - first - 1, 1.0, sum);
+}
+
+// Block length for a window: long enough that the direct sum at the start of a block costs at most
+// one extra addition per row.
+std::size_t blockRows(std::size_t window) {
+    return std::max(kBlockRows, window);
+}
+
+// Rolling maximum (kMaximum) or minimum, van Herk / Gil-Werman. The series is cut into blocks of
+// `window` rows. A window ending at row i covers the tail of the previous block, whose suffix extrema
+// are known, and the head of the current block, whose prefix extrema are known: its extremum is the
+// better of the two.
+template <bool kMaximum>
+void rollingExtremum(std::span<const double> values, std::size_t window, std::span<double> out) {
+    const std::size_t rows = values.size();
+    checkArguments(window, rows, out);
+    auto better = [](double a, double b) { return kMaximum ? a > b : a < b; };
+    if (rows < window) {
+        std::fill(out.begin(), out.begin() + rows, kNaN);
+        return;
+    }
+
+    std::vector<double> suffix(window);  // Suffix extrema of the previous block
+    for (std::size_t start = 0; start < rows; start += window) {
+        const std::size_t end = std::min(start + window, rows);
+        // Prefix extrema of this block, written straight to the output.
+        double prefix = values[start];
+        out[start] = prefix;
+        for (std::size_t row = start + 1; row < end; ++row) {
+            prefix = better(values[row], prefix) ? values[row] : prefix;
+            out[row] = prefix;
+        }
+        if (start != 0) {
+            // Rows before the last of a block also cover suffix[row - start + 1] of the previous block;
+            // the last row of a full block covers exactly this block.
+            const std::size_t count = std::min(end, start + window - 1) - start;
+            const double* tails = suffix.data() + 1;
+            double* heads = out.data() + start;
+            std::size_t i = 0;
+#ifdef INDICATORS_HAVE_AVX2
+            if (useAvx2()) {
+                i = combineAvx2<kMaximum>(tails, heads, count);
+            }
+#endif
+            for (; i < count; ++i) {
+                heads[i] = better(tails[i], heads[i]) ? tails[i] : heads[i];
+            }
+        }
+        if (end - start == window) {
+            double best = values[end - 1];
+            suffix[window - 1] = best;
+            for (std::size_t offset = window - 1; offset-- > 0;) {
+                best = better(values[start + offset], best) ? values[start + offset] : best;
+                suffix[offset] = best;
+            }
+        }
+    }
+    std::fill(out.begin(), out.begin() + window - 1, kNaN);
+}
+
+} // namespace
+
+SimdLevel simdLevel() {
+    return selectedLevel.load(std::memory_order_relaxed);
+}
+
+SimdLevel setSimdLevel(SimdLevel level) {
+    if (level == SimdLevel::Avx2 && !cpuHasAvx2()) {
+        level = SimdLevel::Scalar;
+    }
+    selectedLevel.store(level, std::memory_order_relaxed);
+    return level;
+}
+
+// Window sums block by block, scaled by 1 / window in place.
+void sma(std::span<const double> values, std::size_t window, std::span<double> out) {
+    const std::size_t rows = values.size();
+    checkArguments(window, rows, out);
+    std::fill(out.begin(), out.begin() + std::min(rows, window - 1), kNaN);
+    const Values series{values.data()};
+    for (std::size_t first = window - 1; first < rows; first += blockRows(window)) {
+        const std::size_t last = std::min(first + blockRows(window), rows);
+        windowSums(series, window, first, last, out.data() + first);
+        scale(out.data() + first, last - first, 1.0 / static_cast<double>(window), out.data() + first);
+    }
+}
+
+// The recurrence y[i] = (1 - alpha) * y[i - 1] + alpha * x[i] is scanned block by block.
+void ema(std::span<const double> values, double alpha, std::span<double> out) {
+    const std::size_t rows = values.size();
+    checkArguments(1, rows, out);
+    if (!(alpha > 0.0 && alpha <= 1.0)) {
+        throw std::runtime_error("EMA weight must be in (0, 1]");
+    }
+    if (rows == 0) {
+        return;
+    }
+    out[0] = values[0];
+    for (std::size_t first = 1; first < rows; first += kBlockRows) {
+        const std::size_t last = std::min(first + kBlockRows, rows);
+        scale(values.data() + first, last - first, alpha, out.data() + first);
+        scan(out.data() + first, last - first, 1.0 - alpha, out[first - 1]);
+    }
+}
+
+// Window sums of the notionals go to the output and those of the quantities to a block-sized scratch
+// buffer; the two are then divided.
+void vwap(std::span<const double> prices, std::span<const std::int64_t> quantities, std::size_t window,
+          std::span<double> out) {
+    const std::size_t rows = std::min(prices.size(), quantities.size());
+    checkArguments(window, rows, out);
+    std::fill(out.begin(), out.begin() + std::min(rows, window - 1), kNaN);
+    const Notionals notionals{prices.data(), quantities.data()};
+    const Quantities volumes{quantities.data()};
+    std::vector<double> volume(blockRows(window));
+    for (std::size_t first = window - 1; first < rows; first += blockRows(window)) {
+        const std::size_t last = std::min(first + blockRows(window), rows);
+        double* notional = out.data() + first;
+        windowSums(notionals, window, first, last, notional);
+        windowSums(volumes, window, first, last, volume.data());
+        std::size_t i = 0;
+#ifdef INDICATORS_HAVE_AVX2
+        if (useAvx2()) {
+            i = divideAvx2(notional, volume.data(), last - first);
+        }
+#endif
+        for (; i < last - first; ++i) {
+            notional[i] = volume[i] != 0.0 ? notional[i] / volume[i] : kNaN;
+        }
+    }
+}
+
+// Window sums of the values and of their squared deviations from the first value give the mean and the
+// sample variance of each window.
+void bollinger(std::span<const double> values, std::size_t window, double width, std::span<double> middle,
+               std::span<double> upper, std::span<double> lower) {
+    const std::size_t rows = values.size();
+    checkArguments(window, rows, middle);
+    checkArguments(window, rows, upper);
+    checkArguments(window, rows, lower);
+    const std::size_t warmup = std::min(rows, window - 1);
+    std::fill(middle.begin(), middle.begin() + warmup, kNaN);
+    std::fill(upper.begin(), upper.begin() + warmup, kNaN);
+    std::fill(lower.begin(), lower.begin() + warmup, kNaN);
+    if (rows < window) {
+        return;
+    }
+
+    const double count = static_cast<double>(window);
+    const double degrees = window > 1 ? count - 1.0 : 1.0;
+    for (std::size_t first = window - 1; first < rows; first += blockRows(window)) {
+        const std::size_t last = std::min(first + blockRows(window), rows);
+        // Each block is centred on its own first row, so the deviations stay small when prices drift.
+        const double center = values[first];
+        const Deviations deviations{values.data(), center};
+        const Squares squares{values.data(), center};
+        double* sum = middle.data() + first;
+        double* squareSum = upper.data() + first;
+        windowSums(deviations, window, first, last, sum);
+        windowSums(squares, window, first, last, squareSum);
+        // With D the sum of the deviations of the values from the center c and Q the sum of their squares:
+        // mean = c + D / n, variance = (Q - D^2 / n) / (n - 1).
+        std::size_t i = 0;
+#ifdef INDICATORS_HAVE_AVX2
+        if (useAvx2()) {
+            i = bandsAvx2(sum, squareSum, lower.data() + first, last - first, count, center, degrees, width);
+        }
+#endif
+        for (; i < last - first; ++i) {
+            const double deviation = sum[i];
+            const double variance = std::max((squareSum[i] - deviation * deviation / count) / degrees, 0.0);
+            const double band = width * std::sqrt(variance);
+            const double mean = center + deviation * (1.0 / count);
+            sum[i] = mean;
+            squareSum[i] = mean + band;
+            lower[first + i] = mean - band;
+        }
+        if (window == 1) {
+            std::copy(sum, sum + (last - first), upper.data() + first);
+            std::copy(sum, sum + (last - first), lower.data() + first);
+        }
+    }
+}
+
+// The average gains go to the output and the average losses to a scratch buffer, block by block. Both
+// follow avg[i] = (1 - 1/period) * avg[i - 1] + change[i] / period, which is scanned like an EMA.
+void rsi(std::span<const double> values, std::size_t period, std::span<double> out) {
+    const std::size_t rows = values.size();
+    checkArguments(period, rows, out);
+    std::fill(out.begin(), out.begin() + std::min(rows, period), kNaN);
+    if (rows <= period) {
+        return;
+    }
+
+    const double inversePeriod = 1.0 / static_cast<double>(period);
+    double averageGain = 0.0;
+    double averageLoss = 0.0;
+    for (std::size_t row = 1; row <= period; ++row) {
+        const double change = values[row] - values[row - 1];
+        averageGain += std::max(change, 0.0) * inversePeriod;
+        averageLoss += std::max(-change, 0.0) * inversePeriod;
+    }
+    auto strength = [](double gain, double loss) {
+        const double total = gain + loss;
+        return total > 0.0 ? 100.0 * gain / total : 50.0;
+    };
+    out[period] = strength(averageGain, averageLoss);
+
+    std::vector<double> losses(kBlockRows);
+    for (std::size_t first = period + 1; first < rows; first += kBlockRows) {
+        const std::size_t last = std::min(first + kBlockRows, rows);
+        double* gains = out.data() + first;
+        std::size_t done = 0;
+#ifdef INDICATORS_HAVE_AVX2
+        if (useAvx2()) {
+            done = changesAvx2(values.data(), first, last, inversePeriod, gains, losses.data());
+        }
+#endif
+        for (std::size_t row = first + done; row < last; ++row) {
+            const double change = (values[row] - values[row - 1]) * inversePeriod;
+            gains[row - first] = std::max(change, 0.0);
+            losses[row - first] = std::max(-change, 0.0);
+        }
+        scan(gains, last - first, 1.0 - inversePeriod, averageGain);
+        scan(losses.data(), last - first, 1.0 - inversePeriod, averageLoss);
+        averageGain = gains[last - first - 1];
+        averageLoss = losses[last - first - 1];
+        std::size_t i = 0;
+#ifdef INDICATORS_HAVE_AVX2
+        if (useAvx2()) {
+            i = strengthAvx2(gains, losses.data(), last - first);
+        }
+#endif
+        for (; i < last - first; ++i) {
+            gains[i] = strength(gains[i], losses[i]);
+        }
+    }
+}
+
+void rollingMin(std::span<const double> values, std::size_t window, std::span<double> out) {
+    rollingExtremum<false>(values, window, out);
+}
+
+void rollingMax(std::span<const double> values, std::size_t window, std::span<double> out) {
+    rollingExtremum<true>(values, window, out);
+}
+
+Vwap::Vwap(std::size_t window) : rows_(window) {
+    if (window == 0) {
+        throw std::runtime_error("VWAP window must not be empty");
+    }
+}
+
+// Two plain sums over the window.
+void Vwap::refresh() {
+    notional_ = 0.0;
+    volume_ = 0.0;
+    for (const Row& row : rows_) {
+        notional_ += row.notional;
+        volume_ += row.volume;
+    }
+}
+
+Rsi::Rsi(std::size_t period) : period_(period) {
+    if (period == 0) {
+        throw std::runtime_error("RSI period must not be 0");
+    }
+}
+
+} // namespace indicators
@@ -1,22 +1,91 @@
 #include "mean_reversion_strategy.h"
+#include <cmath>
 
 // Configures the mean reversion strategy with necessary parameters.
 // In a real implementation, the config string could be used to dynamically set the mean price
 // and other parameters relevant to the strategy. Currently, it just prints the initial mean price.
-void MeanReversionStrategy::configure(const std::string& config) {
+void MeanReversionStrategy::configure([[maybe_unused]] const std::string& config) {
     // Logic for parsing and applying configuration would go here.
     std::cout << "Mean reversion strategy configured with mean price: " << meanPrice_ << std::endl;
 }
 
-// Executes the mean reversion strategy.
-// In this example, it simply simulates a trade execution by incrementing the trade counter.
-// In a real-world scenario, this method would involve checking market data and executing trades
-// when prices deviate from the mean price.
+// Records a trade executed outside the market data path.
 void MeanReversionStrategy::execute() {
     tradesExecuted_++;
     std::cout << "Mean reversion trade executed! Total trades: " << tradesExecuted_ << std::endl;
 }
 
+// The per-instrument arrays grow when a new instrument shows up, which happens on bars, not on book updates.
+// Bars of an invalid instrument id are ignored, so the arrays never grow past config::MAX_INSTRUMENTS.
+void MeanReversionStrategy::onBar(const Bar& bar) {
+    if (!isValidInstrument(bar.instrumentId)) {
+        return;
+    }
+    if (bar.instrumentId >= bands_.size()) {
+        bands_.resize(bar.instrumentId + 1, indicators::Bollinger(config::MEAN_REVERSION_STRATEGY_PERIOD,
+                                                                  config::MEAN_REVERSION_ENTRY_ZSCORE));
+        targets_.resize(bar.instrumentId + 1, 0);
+        positions_.resize(bar.instrumentId + 1, 0);
+    }
+    bands_[bar.instrumentId].update(bar.close);
+}
+
+// Only the z-score of the mid price is computed per update; the order is sent only when the target changes.
+void MeanReversionStrategy::onBookUpdate(const BookUpdate& update) {
+    if (update.instrumentId >= bands_.size() || update.bidPrice <= 0 || update.askPrice <= 0) {
+        return;
+    }
+    const double mid = toPrice(update.bidPrice + update.askPrice, update.tickSize) / 2.0;
+    const double z = zScore(update.instrumentId, mid);
+
+    std::int64_t& target = targets_[update.instrumentId];
+    std::int64_t wanted = target;
+    if (z >= config::MEAN_REVERSION_ENTRY_ZSCORE) {
+        wanted = -config::MEAN_REVERSION_ORDER_QUANTITY;
+    } else if (z <= -config::MEAN_REVERSION_ENTRY_ZSCORE) {
+        wanted = config::MEAN_REVERSION_ORDER_QUANTITY;
+    } else if (std::abs(z) <= config::MEAN_REVERSION_EXIT_ZSCORE) {
+        wanted = 0;
+    }
+    if (wanted == target) {
+        return;
+    }
+
+    OrderIntent intent;
+    intent.instrumentId = update.instrumentId;
+    intent.quantity = wanted - target;
+    intent.price = intent.quantity > 0 ? update.askPrice : update.bidPrice;
+    intent.tickSize = update.tickSize;
+    intent.triggerTimestamp = update.receiveTimestamp;
+    if (submitOrder(intent)) {
+        target = wanted;
+        tradesExecuted_++;
+    }
+}
+
+// Fills only arrive for instruments the strategy has sent orders for, so the arrays are already sized.
+void MeanReversionStrategy::onFill(const Fill& fill) {
+    if (fill.instrumentId < positions_.size()) {
+        positions_[fill.instrumentId] += fill.quantity;
+    }
+}
+
+// Returns the rolling mean once the window is full, and the default mean price before that.
+double MeanReversionStrategy::meanPrice(InstrumentId instrumentId) const {
+    if (instrumentId >= bands_.size() || !bands_[instrumentId].ready()) {
+        return meanPrice_;
+    }
+    return bands_[instrumentId].middle();
+}
+
+// The z-score is only meaningful over a full window.
+double MeanReversionStrategy::zScore(InstrumentId instrumentId, double price) const {
+    if (instrumentId >= bands_.size() || !bands_[instrumentId].ready()) {
+        return 0.0;
+    }
+    return bands_[instrumentId].zScore(price);
+}
+
 // Analyzes the results of the mean reversion strategy.
 // This method returns a summary of the trades executed, including the total number of trades performed by the strategy.
 std::string MeanReversionStrategy::analyzeResults() const {
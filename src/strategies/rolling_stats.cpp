@@ -0,0 +1,34 @@
+#include "rolling_stats.h"
+#include <stdexcept>
+
+// Allocates the ring buffer once; adding values never allocates.
+RollingStats::RollingStats(std::size_t window, double ewmaAlpha)
+    : values_(window), alpha_(ewmaAlpha > 0.0 ? ewmaAlpha : 2.0 / (static_cast<double>(window) + 1.0)) {
+    if (window == 0) {
+        throw std::runtime_error("RollingStats window must not be empty");
+    }
+}
+
+// Keeps the buffer and the EWMA weight.
+void RollingStats::reset() {
+    next_ = 0;
+    count_ = 0;
+    mean_ = 0.0;
+    m2_ = 0.0;
+    ewma_ = 0.0;
+    added_ = 0;
+}
+
+// Two passes over the window: the mean first, then the deviations from it.
+void RollingStats::refresh() {
+    double sum = 0.0;
+    for (double value : values_) {
+        sum += value;
+    }
+    mean_ = sum / static_cast<double>(values_.size());
+    double m2 = 0.0;
+    for (double value : values_) {
+        m2 += (value - mean_) * (value - mean_);
+    }
+    m2_ = m2;
+}
@@ -1,16 +1,46 @@
 #include "scalping_strategy.h"
-#include <atomic>    // Для атомарного счетчика в многопоточной среде
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
 
-// Атомарный счетчик для многопоточной среды
-std::atomic<int> tradesExecuted_{0};
+// Parses the "key=value" pairs. Values are parsed into integers with std::from_chars, which accepts
+// nothing but digits, so a price or percentage can never come in as a fraction.
+void ScalpingStrategy::configure(const std::string& config) {
+    std::string_view text = config;
+    while (!text.empty()) {
+        const std::size_t end = text.find_first_of(" ,;\t\n");
+        const std::string_view word = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1);
 
-// Configures the scalping strategy with necessary parameters.
-// Future implementation where config will contain real settings.
-void ScalpingStrategy::configure([[maybe_unused]] const std::string& config) {
-    // Parsing and applying configuration will be added here.
+        const std::size_t equals = word.find('=');
+        if (equals == std::string_view::npos) {
+            continue;
+        }
+        const std::string_view key = word.substr(0, equals);
+        const std::string_view value = word.substr(equals + 1);
+        std::int64_t number = 0;
+        const auto result = std::from_chars(value.data(), value.data() + value.size(), number);
+        if (result.ec != std::errc() || result.ptr != value.data() + value.size() || number < 0) {
+            throw std::runtime_error("Invalid scalping strategy setting: " + std::string(word));
+        }
+
+        if (key == "spread") {
+            maxSpreadTicks_ = number;
+        } else if (key == "imbalance") {
+            imbalancePercent_ = number;
+        } else if (key == "take_profit") {
+            takeProfitTicks_ = number;
+        } else if (key == "stop_loss") {
+            stopLossTicks_ = number;
+        } else if (key == "quantity") {
+            quantity_ = number;
+        } else {
+            throw std::runtime_error("Unknown scalping strategy setting: " + std::string(key));
+        }
+    }
 }
 
-// Executes the scalping strategy.
+// Records a trade executed outside the market data path.
 // Now uses atomic increment for trade execution to ensure thread safety.
 void ScalpingStrategy::execute() {
     // Increment the trade counter atomically
@@ -18,6 +48,70 @@ void ScalpingStrategy::execute() {
     std::cout << "Scalping trade executed! Total trades: " << tradesExecuted_.load() << std::endl;
 }
 
+// The imbalance (bidSize - askSize) / (bidSize + askSize) is compared with the threshold percentage by
+// cross-multiplying, and profit and loss are differences of tick prices, so everything stays in integers.
+void ScalpingStrategy::onBookUpdate(const BookUpdate& update) {
+    const std::int64_t spread = update.askPrice - update.bidPrice;
+    const std::int64_t depth = update.bidSize + update.askSize;
+    if (update.bidPrice <= 0 || spread <= 0 || depth <= 0) {
+        return;  // One-sided, crossed or empty book
+    }
+    if (!isValidInstrument(update.instrumentId)) {
+        return;  // No state for ids outside the registry range
+    }
+    if (update.instrumentId >= instruments_.size()) {
+        instruments_.resize(update.instrumentId + 1);
+    }
+    InstrumentState& state = instruments_[update.instrumentId];
+
+    const std::int64_t lean = (update.bidSize - update.askSize) * 100;
+    const std::int64_t threshold = imbalancePercent_ * depth;
+    const bool buyers = lean >= threshold;
+    const bool sellers = -lean >= threshold;
+
+    if (state.target == 0) {
+        if (spread > maxSpreadTicks_) {
+            return;
+        }
+        if (buyers) {
+            trade(update, state, quantity_);
+        } else if (sellers) {
+            trade(update, state, -quantity_);
+        }
+        return;
+    }
+
+    // Profit of the open position if it were closed now, at the price it would be closed at.
+    const std::int64_t profit = state.target > 0 ? update.bidPrice - state.entryPrice
+                                                 : state.entryPrice - update.askPrice;
+    const bool reversed = state.target > 0 ? sellers : buyers;
+    if (profit >= takeProfitTicks_ || -profit >= stopLossTicks_ || reversed) {
+        trade(update, state, 0);
+    }
+}
+
+// Buys at the ask and sells at the bid, so the order trades at once.
+void ScalpingStrategy::trade(const BookUpdate& update, InstrumentState& state, std::int64_t wanted) {
+    OrderIntent intent;
+    intent.instrumentId = update.instrumentId;
+    intent.quantity = wanted - state.target;
+    intent.price = intent.quantity > 0 ? update.askPrice : update.bidPrice;
+    intent.tickSize = update.tickSize;
+    intent.triggerTimestamp = update.receiveTimestamp;
+    if (submitOrder(intent)) {
+        state.target = wanted;
+        state.entryPrice = intent.price;
+        tradesExecuted_++;
+    }
+}
+
+// Fills only arrive for instruments the strategy has sent orders for, so the state already exists.
+void ScalpingStrategy::onFill(const Fill& fill) {
+    if (fill.instrumentId < instruments_.size()) {
+        instruments_[fill.instrumentId].position += fill.quantity;
+    }
+}
+
 // Analyzes the results of the scalping strategy.
 // Uses atomic load to safely retrieve the trade counter.
 std::string ScalpingStrategy::analyzeResults() const {
@@ -1,24 +1,291 @@
 #include "strategy_manager.h"
+#include <algorithm>
+#include "tsc_clock.h"
 
 // Adds a strategy to the list of strategies managed by the StrategyManager.
 // The strategy is stored as a shared pointer to ensure that memory is managed automatically,
 // and multiple references to the same strategy can exist if needed.
+// Each strategy also gets its own order channel.
+// If its thread cannot be started, the strategy is taken out again before the error is passed on.
 void StrategyManager::addStrategy(std::shared_ptr<BaseStrategy> strategy) {
+    channels_.push_back(std::make_unique<OrderChannel>());
+    strategy->setOrderChannel(channels_.back().get());
+    if (instruments_ != nullptr) {
+        strategy->setInstruments(*instruments_);
+    }
     strategies_.emplace_back(strategy);
+    strategyTimes_.emplace_back();
+    if (mode_ != DeliveryMode::Serial) {
+        try {
+            startWorker(strategy, channels_.back().get());
+        } catch (...) {
+            strategy->setOrderChannel(nullptr);
+            strategies_.pop_back();
+            channels_.pop_back();
+            strategyTimes_.pop_back();
+            throw;
+        }
+    }
+}
+
+// Stops the strategy threads before the strategies are released.
+StrategyManager::~StrategyManager() {
+    stopWorkers();
+}
+
+// Starts or stops the strategy threads when the mode changes. The threads of the old mode deliver
+// what is still pending before they stop. If the threads of the new mode cannot all be started, the
+// ones that were are stopped and the manager falls back to serial delivery.
+void StrategyManager::setDeliveryMode(DeliveryMode mode) {
+    if (mode == mode_) {
+        return;
+    }
+    if (mode_ != DeliveryMode::Serial) {
+        waitUntilIdle();
+        stopWorkers();
+    }
+    mode_ = mode;
+    if (mode_ != DeliveryMode::Serial) {
+        try {
+            startWorkers();
+        } catch (...) {
+            stopWorkers();
+            mode_ = DeliveryMode::Serial;
+            throw;
+        }
+    }
+}
+
+// In multicast mode the ring tracks every cursor; in conflated mode each worker's generation counter is
+// waited on until it catches up with the last publication.
+void StrategyManager::waitUntilIdle() {
+    if (mode_ == DeliveryMode::Multicast) {
+        ring_->waitUntilConsumed();
+        return;
+    }
+    const std::uint64_t target = generation_.load(std::memory_order_acquire);
+    for (const auto& worker : workers_) {
+        for (std::uint64_t seen = worker->processed.load(std::memory_order_acquire); seen < target;
+             seen = worker->processed.load(std::memory_order_acquire)) {
+            worker->processed.wait(seen, std::memory_order_acquire);
+        }
+    }
+}
+
+// Reads the conflation counter of a strategy's buffer.
+std::uint64_t StrategyManager::conflatedUpdates(std::size_t strategy) const {
+    return strategy < workers_.size() && workers_[strategy]->buffer ? workers_[strategy]->buffer->conflated() : 0;
+}
+
+// Reads the drop counter of a strategy's buffer.
+std::uint64_t StrategyManager::droppedUpdates(std::size_t strategy) const {
+    return strategy < workers_.size() && workers_[strategy]->buffer ? workers_[strategy]->buffer->dropped() : 0;
+}
+
+// Combines the time measured on the caller's thread with the time measured by the strategy's thread.
+LatencyStats StrategyManager::strategyTime(std::size_t strategy) const {
+    if (strategy >= strategies_.size()) {
+        return {};
+    }
+    LatencyStats time = strategyTimes_[strategy];
+    if (strategy < workers_.size()) {
+        time.merge(workers_[strategy]->time);
+    }
+    return time;
 }
 
 // Executes all strategies in the list.
 // This method loops through the vector of strategies and calls the `execute` method on each one.
 // It allows multiple strategies to be executed in sequence.
+// In the threaded modes the strategy threads are idle before the strategies are called from this thread.
 void StrategyManager::executeStrategies() {
+    if (mode_ != DeliveryMode::Serial) {
+        waitUntilIdle();
+    }
     for (const auto& strategy : strategies_) {
         strategy->execute();
     }
 }
 
+// Executes all strategies over a batch of market data.
+// The batch is shared by reference, so no strategy copies the data it reads. In multicast mode it is
+// copied once, into a ring slot whose column vectors keep their capacity, and read there by every strategy.
+void StrategyManager::executeStrategies(const TickBatch& batch) {
+    if (mode_ == DeliveryMode::Multicast) {
+        if (batch.size() != 0) {
+            const auto slot = ring_->claim();
+            ring_->slot(slot) = batch;
+            ring_->publish(slot, 1);
+        }
+        return;
+    }
+    if (mode_ == DeliveryMode::Conflated) {
+        for (std::size_t row = 0; row < batch.size(); ++row) {
+            const Tick tick = batch.at(row);
+            for (const auto& worker : workers_) {
+                worker->buffer->publish(tick);
+            }
+        }
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+        return;
+    }
+    for (std::size_t i = 0; i < strategies_.size(); ++i) {
+        deliverFills(*strategies_[i], *channels_[i]);
+        const std::uint64_t start = TscClock::cycles();
+        strategies_[i]->onBatch(batch);
+        strategyTimes_[i].add(TscClock::toNanos(TscClock::cycles() - start));
+    }
+}
+
+// Delivers the bars one at a time to every strategy, so each strategy sees them in completion order.
+// As with execute(), the strategy threads finish the published batches first.
+void StrategyManager::executeStrategies(std::span<const Bar> bars) {
+    if (mode_ != DeliveryMode::Serial) {
+        waitUntilIdle();
+    }
+    for (const Bar& bar : bars) {
+        for (const auto& strategy : strategies_) {
+            strategy->onBar(bar);
+        }
+    }
+}
+
+// Pending fills are delivered first, so the strategy sees its executions before the time moves on.
+void StrategyManager::executeTimers(const TimerEvent& timer) {
+    if (mode_ != DeliveryMode::Serial) {
+        waitUntilIdle();
+    }
+    for (std::size_t i = 0; i < strategies_.size(); ++i) {
+        deliverFills(*strategies_[i], *channels_[i]);
+        strategies_[i]->onTimer(timer);
+    }
+}
+
+// Sums the rejections counted by every strategy's channel.
+std::uint64_t StrategyManager::rejectedOrders() const {
+    std::uint64_t rejected = 0;
+    for (const auto& channel : channels_) {
+        rejected += channel->rejected();
+    }
+    return rejected;
+}
+
+// Remembers the registry for the strategies added later.
+void StrategyManager::setInstruments(const InstrumentRegistry& registry) {
+    instruments_ = &registry;
+    for (const auto& strategy : strategies_) {
+        strategy->setInstruments(registry);
+    }
+}
+
+// Combines the column requirements of every strategy, so that data is loaded once for all of them.
+TickColumnMask StrategyManager::requiredColumns() const {
+    TickColumnMask columns = 0;
+    for (const auto& strategy : strategies_) {
+        columns |= strategy->requiredColumns();
+    }
+    return columns;
+}
+
 // Clears the list of strategies.
 // This method removes all strategies from the internal vector, effectively releasing any resources
 // held by the strategies and allowing new strategies to be added later.
 void StrategyManager::clearStrategies() {
+    stopWorkers();
+    for (const auto& strategy : strategies_) {
+        strategy->setOrderChannel(nullptr);
+    }
     strategies_.clear();
+    channels_.clear();
+    strategyTimes_.clear();
+    if (mode_ != DeliveryMode::Serial) {
+        startWorkers();
+    }
+}
+
+// A new ring starts every multicast session, so cursors of strategies that were removed do not linger.
+void StrategyManager::startWorkers() {
+    running_.store(true, std::memory_order_relaxed);
+    if (mode_ == DeliveryMode::Multicast) {
+        ring_ = std::make_unique<MulticastRing<TickBatch>>(config::MULTICAST_RING_CAPACITY, waitStrategy_);
+    }
+    for (std::size_t i = 0; i < strategies_.size(); ++i) {
+        startWorker(strategies_[i], channels_[i].get());
+    }
+}
+
+// Creates the strategy's buffer, or registers its cursor on the ring, and starts its thread.
+void StrategyManager::startWorker(const std::shared_ptr<BaseStrategy>& strategy, OrderChannel* orders) {
+    auto worker = std::make_unique<Worker>(strategy, orders);
+    Worker& self = *worker;
+    if (mode_ == DeliveryMode::Multicast) {
+        self.consumer = ring_->addConsumer();
+        workers_.push_back(std::move(worker));
+        self.thread = std::thread([this, &self, ring = ring_.get()] { runMulticastWorker(self, *ring); });
+        return;
+    }
+    const std::size_t instruments = instruments_ != nullptr ? instruments_->size() : 0;
+    self.buffer = std::make_unique<ConflatingBuffer>(
+        std::max<std::size_t>(config::CONFLATION_MAX_INSTRUMENTS, instruments));
+    self.processed.store(generation_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    workers_.push_back(std::move(worker));
+    self.thread = std::thread([this, &self] { runWorker(self); });
+}
+
+// Wakes up every strategy thread and joins it, keeping the time it measured.
+void StrategyManager::stopWorkers() {
+    running_.store(false, std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release);
+    generation_.notify_all();
+    if (ring_) {
+        ring_->halt();
+    }
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        if (workers_[i]->thread.joinable()) {
+            workers_[i]->thread.join();
+        }
+        strategyTimes_[i].merge(workers_[i]->time);  // Keep the measurements of the threaded modes
+    }
+    workers_.clear();
+    ring_.reset();
+}
+
+// Sleeps on the publication counter, then drains the strategy's buffer into a batch of at most one row
+// per instrument and runs the strategy over it. Whatever is published while the strategy runs is
+// conflated into the next round.
+void StrategyManager::runWorker(Worker& worker) {
+    TickBatch batch;
+    std::uint64_t seen = worker.processed.load(std::memory_order_relaxed);
+    while (true) {
+        generation_.wait(seen, std::memory_order_acquire);
+        seen = generation_.load(std::memory_order_acquire);
+        const bool running = running_.load(std::memory_order_relaxed);
+
+        batch.clear();
+        worker.buffer->drain([&batch](const Tick& tick) { batch.append(tick); });
+        deliverFills(*worker.strategy, *worker.orders);
+        if (batch.size() != 0) {
+            const std::uint64_t start = TscClock::cycles();
+            worker.strategy->onBatch(batch);
+            worker.time.add(TscClock::toNanos(TscClock::cycles() - start));
+        }
+        worker.processed.store(seen, std::memory_order_release);
+        worker.processed.notify_all();
+        if (!running) {
+            break;
+        }
+    }
+}
+
+// Runs the strategy over the batches in the ring slots, in place, until the ring is halted and drained.
+void StrategyManager::runMulticastWorker(Worker& worker, MulticastRing<TickBatch>& ring) {
+    auto deliver = [&worker](const TickBatch& batch, MulticastRing<TickBatch>::Sequence) {
+        deliverFills(*worker.strategy, *worker.orders);
+        const std::uint64_t start = TscClock::cycles();
+        worker.strategy->onBatch(batch);
+        worker.time.add(TscClock::toNanos(TscClock::cycles() - start));
+    };
+    while (ring.consume(worker.consumer, deliver) != 0) {
+    }
 }
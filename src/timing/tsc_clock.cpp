@@ -0,0 +1,187 @@
+#include "tsc_clock.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace {
+
+// A counter reading taken together with both system clocks.
+struct Sample {
+    std::uint64_t cycles = 0;
+    std::int64_t realtime = 0;
+    std::int64_t monotonic = 0;
+};
+
+// Reference point of the long-term frequency measurement and the state of the correction thread.
+struct Calibration {
+    std::mutex mutex;                 // Serializes calibrations
+    Sample origin;                    // Sample taken by calibrate()
+    std::mutex threadMutex;
+    std::condition_variable wakeup;
+    std::thread thread;
+    bool stopping = false;
+};
+
+Calibration& calibration() {
+    static Calibration instance;
+    return instance;
+}
+
+// Check CPUID for an invariant TSC (leaf 0x80000007, EDX bit 8).
+bool hasInvariantTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007 || !__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+// Read the counter and both clocks. The clocks are read between two counter readings, and the attempt
+// with the shortest bracket is kept (the least disturbed by an interrupt), with the counter at its midpoint.
+Sample takeSample() {
+    Sample best;
+    std::uint64_t bestWidth = UINT64_MAX;
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        const std::uint64_t before = TscClock::readTsc();
+        const std::int64_t monotonic = TscClock::systemNanos(CLOCK_MONOTONIC);
+        const std::int64_t realtime = TscClock::systemNanos(CLOCK_REALTIME);
+        const std::uint64_t after = TscClock::readTsc();
+        if (after - before < bestWidth) {
+            bestWidth = after - before;
+            best = Sample{before + (after - before) / 2, realtime, monotonic};
+        }
+    }
+    return best;
+}
+
+// Largest relative rate change used to slew the clock towards CLOCK_MONOTONIC (500 ppm, as adjtime()).
+constexpr double kMaxSlew = 500e-6;
+
+} // namespace
+
+// Take two samples `window` apart and derive the frequency from them. If the clock was already running,
+// it is not moved back: the new anchor is the later of the clock's own reading and CLOCK_MONOTONIC.
+void TscClock::calibrate(std::chrono::milliseconds window) {
+    if (!config::TSC_CLOCK_ENABLED || !hasInvariantTsc()) {
+        state_.enabled.store(false, std::memory_order_relaxed);
+        state_.calibrated.store(true, std::memory_order_release);
+        return;
+    }
+    Calibration& shared = calibration();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.origin = takeSample();
+    std::this_thread::sleep_for(window);
+    const Sample end = takeSample();
+    if (end.cycles <= shared.origin.cycles || end.monotonic <= shared.origin.monotonic) {
+        state_.enabled.store(false, std::memory_order_relaxed);
+        state_.calibrated.store(true, std::memory_order_release);
+        return;
+    }
+
+    const double nanosPerCycle = static_cast<double>(end.monotonic - shared.origin.monotonic) /
+                                 static_cast<double>(end.cycles - shared.origin.cycles);
+    std::int64_t monotonic = end.monotonic;
+    if (state_.enabled.load(std::memory_order_relaxed)) {
+        monotonic = std::max(monotonic, convert(end.cycles, false));
+    }
+    anchor(end.cycles, monotonic + (end.realtime - end.monotonic), monotonic, nanosPerCycle);
+    state_.enabled.store(true, std::memory_order_relaxed);
+    state_.calibrated.store(true, std::memory_order_release);
+}
+
+// Threads that read the clock before calibrate() has finished wait for it here.
+void TscClock::calibrateOnce() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        if (!state_.calibrated.load(std::memory_order_acquire)) {
+            calibrate();
+        }
+    });
+}
+
+// The longer the baseline, the smaller the relative error of the frequency, so it is measured from the
+// original calibration sample every time. The clock is anchored where it stands, not where CLOCK_MONOTONIC
+// is, and its rate is adjusted so that it catches up over the next correction period. Only an error too
+// large to slew away while moving forward (e.g. after the machine was suspended) is stepped, forwards.
+void TscClock::recalibrate() {
+    if (!usesTsc()) {
+        return;
+    }
+    Calibration& shared = calibration();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    const Sample now = takeSample();
+    if (now.cycles <= shared.origin.cycles || now.monotonic <= shared.origin.monotonic) {
+        return;
+    }
+    double nanosPerCycle = static_cast<double>(now.monotonic - shared.origin.monotonic) /
+                           static_cast<double>(now.cycles - shared.origin.cycles);
+    std::int64_t monotonic = convert(now.cycles, false);
+    const double error = static_cast<double>(now.monotonic - monotonic);
+    const double horizon = static_cast<double>(config::TSC_DRIFT_CORRECTION_MILLIS) * 1e6;
+    if (error > kMaxSlew * horizon) {
+        monotonic = now.monotonic;
+    } else {
+        nanosPerCycle *= 1.0 + std::max(error / horizon, -kMaxSlew);
+    }
+    anchor(now.cycles, monotonic + (now.realtime - now.monotonic), monotonic, nanosPerCycle);
+}
+
+// Write the parameters with the sequence number odd, so readers retry instead of mixing old and new values.
+void TscClock::anchor(std::uint64_t cycles, std::int64_t realtime, std::int64_t monotonic, double nanosPerCycle) {
+    state_.sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    state_.baseCycles.store(cycles, std::memory_order_relaxed);
+    state_.baseRealtime.store(realtime, std::memory_order_relaxed);
+    state_.baseMonotonic.store(monotonic, std::memory_order_relaxed);
+    state_.multiplier.store(static_cast<std::uint64_t>(nanosPerCycle * static_cast<double>(1ULL << kShift)),
+                            std::memory_order_relaxed);
+    state_.sequence.fetch_add(1, std::memory_order_release);
+}
+
+// The thread sleeps on a condition variable, so stopping it does not wait for a whole period.
+void TscClock::startDriftCorrection(std::chrono::milliseconds period) {
+    Calibration& shared = calibration();
+    std::lock_guard<std::mutex> lock(shared.threadMutex);
+    if (shared.thread.joinable()) {
+        return;
+    }
+    shared.stopping = false;
+    shared.thread = std::thread([&shared, period] {
+        std::unique_lock<std::mutex> wait(shared.threadMutex);
+        while (!shared.wakeup.wait_for(wait, period, [&shared] { return shared.stopping; })) {
+            wait.unlock();
+            recalibrate();
+            wait.lock();
+        }
+    });
+}
+
+// Wake the correction thread up and join it.
+void TscClock::stopDriftCorrection() {
+    Calibration& shared = calibration();
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(shared.threadMutex);
+        shared.stopping = true;
+        thread = std::move(shared.thread);
+    }
+    shared.wakeup.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+// Invert the fixed-point multiplier.
+double TscClock::cyclesPerNanosecond() {
+    const std::uint64_t multiplier = state_.multiplier.load(std::memory_order_relaxed);
+    return usesTsc() && multiplier != 0 ? static_cast<double>(1ULL << kShift) / static_cast<double>(multiplier) : 0.0;
+}
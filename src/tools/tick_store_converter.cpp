@@ -0,0 +1,40 @@
+#include "historical_data_loader.h"
+#include "tick_store.h"
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+// Converts a CSV history file into the binary columnar tick store format.
+// Usage: TickStoreConverter [--raw | --compressed] <input.csv> <output.ticks>
+// Without a flag, config::TICK_STORE_COMPRESSION decides whether columns are compressed.
+int main(int argc, char* argv[]) {
+    TickStoreOptions options;
+    int arg = 1;
+    if (arg < argc && std::strcmp(argv[arg], "--raw") == 0) {
+        options.compressed = false;
+        ++arg;
+    } else if (arg < argc && std::strcmp(argv[arg], "--compressed") == 0) {
+        options.compressed = true;
+        ++arg;
+    }
+
+    if (argc - arg != 2) {
+        std::cerr << "Usage: " << argv[0] << " [--raw | --compressed] <input.csv> <output.ticks>" << std::endl;
+        return 1;
+    }
+
+    try {
+        HistoricalDataLoader loader(argv[arg]);
+        TickBatch batch;
+        loader.loadBatch(batch);
+
+        TickStoreWriter::write(argv[arg + 1], batch, options);
+        std::cout << "Wrote " << batch.size() << (options.compressed ? " compressed" : " raw")
+                  << " ticks to tick store: " << argv[arg + 1] << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Conversion failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -3,8 +3,12 @@
 #include <cstdio>  // For std::remove
 #include "backtester.h"
 #include "historical_data_loader.h"
+#include "time_index.h"
 #include "strategy_manager.h"
 #include "data_processor.h"
+#include "base_strategy.h"
+#include "mean_reversion_strategy.h"
+#include "tick_store.h"
 
 // Helper function to create a dummy historical data CSV file for testing
 void createHistoricalDataFile(const std::string& filepath) {
@@ -33,6 +37,7 @@ protected:
     // Clean up after each test
     void TearDown() override {
         std::remove(filepath.c_str());  // Remove the file
+        std::remove(TimeIndex::indexFileName(filepath).c_str());  // Remove the time index, if one was built
     }
 };
 
@@ -63,3 +68,181 @@ TEST_F(BacktesterTests, CanLoadHistoricalData) {
     // Optionally, check that the first data point is not empty (ensure valid data format).
     EXPECT_FALSE(data[0].empty());
 }
+
+// Test to ensure that the mapped loader exposes lines as views and loads the same ticks as the buffered loader.
+TEST_F(BacktesterTests, MappedAndBufferedLoadsAgree) {
+    HistoricalDataLoader mapped(filepath, HistoricalDataLoader::LoadMode::Mapped);
+    HistoricalDataLoader buffered(filepath, HistoricalDataLoader::LoadMode::Buffered);
+
+    // The lines are served straight from the mapping, without the trailing newline.
+    std::vector<std::string_view> lines(mapped.lines().begin(), mapped.lines().end());
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0], "Date,Price,Volume");
+    EXPECT_EQ(lines[2], "2023-09-21,105,250");
+
+    TickBatch fromMapping;
+    TickBatch fromBuffer;
+    EXPECT_EQ(mapped.loadBatch(fromMapping), 2u);
+    EXPECT_EQ(buffered.loadBatch(fromBuffer), 2u);
+    EXPECT_EQ(fromMapping.timestamps()[1], fromBuffer.timestamps()[1]);
+    EXPECT_DOUBLE_EQ(fromMapping.tradePrices()[1], 105.0);
+}
+
+// Test to ensure that range loads from CSV use the sidecar time index and return exactly the requested ticks.
+TEST_F(BacktesterTests, LoadsTimeRangeFromCsv) {
+    {
+        std::ofstream file(filepath);
+        file << "timestamp,instrument,price,qty\n";
+        for (int i = 0; i < 50; ++i) {
+            file << 1000 + i * 10 << ',' << i % 2 << ',' << 100 + i << ",1\n";
+        }
+    }
+
+    // A small stride gives several entries; a range starts at the entry before it.
+    std::ifstream in(filepath);
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const TimeIndex index = TimeIndex::build(text, 8);
+    ASSERT_EQ(index.entries().size(), 7u);
+    EXPECT_EQ(index.entries()[1].timestamp, 1080);
+    const auto [begin, end] = index.byteRange(1200, 1300);
+    EXPECT_EQ(begin, index.entries()[2].offset);
+    EXPECT_EQ(end, index.entries()[4].offset);
+
+    HistoricalDataLoader loader(filepath);
+    TickBatch batch;
+    EXPECT_EQ(loader.loadRange(batch, 1200, 1300, {0}), 5u);
+    EXPECT_EQ(batch.timestamps().front(), 1200);
+    EXPECT_EQ(batch.timestamps().back(), 1280);
+    TickBatch unknown;
+    EXPECT_EQ(loader.loadRange(unknown, 1200, 1300, {kInvalidInstrument}), 0u);
+
+    // The second query reuses the saved index.
+    std::ifstream sidecar(TimeIndex::indexFileName(filepath));
+    EXPECT_TRUE(sidecar.good());
+    TickBatch again;
+    EXPECT_EQ(loader.loadRange(again, 1200, 1300), 10u);
+
+    // A saved entry pointing past the data file is rejected and the index is rebuilt.
+    sidecar.close();
+    {
+        std::fstream corrupt(TimeIndex::indexFileName(filepath), std::ios::in | std::ios::out | std::ios::binary);
+        corrupt.seekp(-static_cast<std::streamoff>(sizeof(std::uint64_t)), std::ios::end);
+        const std::uint64_t offset = 1u << 30;
+        corrupt.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    TickBatch rebuilt;
+    EXPECT_EQ(loader.loadRange(rebuilt, 1200, 1300, {0}), 5u);
+    EXPECT_EQ(rebuilt.timestamps().back(), 1280);
+}
+
+namespace {
+
+// Strategy that buys one lot on every book update and counts its fills.
+class BuyEveryUpdateStrategy : public BaseStrategy {
+public:
+    void execute() override {}
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+
+    void onBookUpdate(const BookUpdate& update) override {
+        OrderIntent intent;
+        intent.instrumentId = update.instrumentId;
+        intent.quantity = 1;
+        intent.price = update.askPrice;
+        intent.tickSize = update.tickSize;
+        submitOrder(intent);
+    }
+
+    void onFill(const Fill&) override { ++fills; }
+
+    int fills = 0;
+};
+
+} // namespace
+
+// Test to ensure that orders are routed during the replay, so a backtest with more orders than an order
+// channel holds fills all of them.
+TEST_F(BacktesterTests, RoutesOrdersDuringReplay) {
+    constexpr int kRows = 3 * config::ORDER_CHANNEL_CAPACITY;
+    {
+        std::ofstream file(filepath);
+        file << "timestamp,instrument,price,qty\n";
+        for (int i = 0; i < kRows; ++i) {
+            file << 1000 + i << ",0," << 100 + i % 7 << ",1\n";
+        }
+    }
+
+    auto strategyManager = std::make_shared<StrategyManager>();
+    auto strategy = std::make_shared<BuyEveryUpdateStrategy>();
+    strategyManager->addStrategy(strategy);
+    Backtester backtester(strategyManager, std::make_shared<DataProcessor>());
+    backtester.runBacktest(filepath);
+
+    EXPECT_EQ(strategy->fills, kRows);
+    EXPECT_EQ(strategyManager->rejectedOrders(), 0u);
+}
+
+// Test to ensure that bars are interleaved with the ticks, so a strategy that needs bars before it can
+// score book updates trades in a backtest.
+TEST_F(BacktesterTests, DeliversBarsBeforeLaterTicks) {
+    constexpr std::int64_t kSecond = 1'000'000'000;
+    {
+        std::ofstream file(filepath);
+        file << "timestamp,instrument,bid,ask,price,qty\n";
+        auto row = [&file](std::int64_t timestamp, double price) {
+            file << timestamp << ",0," << price - 0.05 << ',' << price + 0.05 << ',' << price << ",1\n";
+        };
+        for (int i = 0; i < 300; ++i) {  // 50 one-minute bars closing at 100, 100.1 or 100.2
+            row(i * 10 * kSecond, 100.0 + (i / 6 % 3) * 0.1);
+        }
+        row(300 * 10 * kSecond, 110.0);  // Far above the mean: the strategy sells
+    }
+
+    auto strategyManager = std::make_shared<StrategyManager>();
+    auto strategy = std::make_shared<MeanReversionStrategy>();
+    strategyManager->addStrategy(strategy);
+    Backtester backtester(strategyManager, std::make_shared<DataProcessor>());
+    backtester.runBacktest(filepath);
+
+    EXPECT_EQ(strategy->position(0), -config::MEAN_REVERSION_ORDER_QUANTITY);
+}
+
+namespace {
+
+// Strategy that asks for the timestamps only and counts the rows it receives.
+class TimestampOnlyStrategy : public BaseStrategy {
+public:
+    void execute() override {}
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+    TickColumnMask requiredColumns() const override { return tickColumnBit(TickColumn::Timestamp); }
+    void onBatch(const TickBatch& batch) override { rows += batch.size(); }
+
+    std::size_t rows = 0;
+};
+
+} // namespace
+
+// Test to ensure that the columns the data processor filters on are loaded from a tick store even when
+// no strategy asks for them, so the rows are not all filtered out.
+TEST_F(BacktesterTests, LoadsColumnsTheProcessorNeeds) {
+    const std::string storePath = "/tmp/historical_data.ticks";
+    TickBatch written;
+    for (int i = 0; i < 10; ++i) {
+        Tick tick;
+        tick.timestamp = 1000 + i;
+        tick.tradePrice = 100.0 + i;
+        tick.tradeQuantity = 1;
+        written.append(tick);
+    }
+    TickStoreWriter::write(storePath, written);
+
+    auto strategyManager = std::make_shared<StrategyManager>();
+    auto strategy = std::make_shared<TimestampOnlyStrategy>();
+    strategyManager->addStrategy(strategy);
+    Backtester backtester(strategyManager, std::make_shared<DataProcessor>());
+    backtester.runBacktest(storePath);
+    std::remove(storePath.c_str());
+
+    EXPECT_EQ(strategy->rows, 10u);
+}
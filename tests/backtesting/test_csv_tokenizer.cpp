@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "csv_tokenizer.h"
+
+// Test to ensure that the default "Date,Price,Volume" layout is parsed into typed columns.
+TEST(CsvTokenizerTests, ParsesDatePriceVolume) {
+    CsvTokenizer tokenizer;
+    TickBatch batch;
+
+    const std::string text = "Date,Price,Volume\n2023-09-20,100,200\r\n2023-09-21,105.25,250";
+    EXPECT_EQ(tokenizer.parse(text, batch), 2u);
+
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.timestamps()[1], 1695254400LL * 1000000000LL);
+    EXPECT_DOUBLE_EQ(batch.tradePrices()[0], 100.0);
+    EXPECT_DOUBLE_EQ(batch.tradePrices()[1], 105.25);
+    EXPECT_EQ(batch.tradeQuantities()[1], 250);
+}
+
+// Test to ensure that every supported kernel produces the same result as the scalar scan,
+// including rows that straddle 64-byte block boundaries.
+TEST(CsvTokenizerTests, KernelsAgreeWithScalar) {
+    std::string text = "timestamp,instrument,bid,ask,bid_size,ask_size,price,qty,comment\n";
+    for (int i = 0; i < 500; ++i) {
+        text += std::to_string(1000 + i) + "," + std::to_string(i % 7) + "," + std::to_string(99 + i % 3) +
+                ".5," + std::to_string(101 + i % 3) + ".25," + std::to_string(i) + "," + std::to_string(2 * i) +
+                ",100.125," + std::to_string(i % 11) + ",x\n";
+    }
+
+    TickBatch expected;
+    CsvTokenizer(CsvTokenizer::Kernel::Scalar).parse(text, expected);
+    ASSERT_EQ(expected.size(), 500u);
+    EXPECT_EQ(expected.instrumentIds()[13], 6u);
+    EXPECT_DOUBLE_EQ(expected.askPrices()[2], 103.25);
+
+    for (auto kernel : {CsvTokenizer::Kernel::Sse2, CsvTokenizer::Kernel::Avx2}) {
+        if (!CsvTokenizer::isSupported(kernel)) {
+            continue;
+        }
+        TickBatch batch;
+        CsvTokenizer(kernel).parse(text, batch);
+        ASSERT_EQ(batch.size(), expected.size());
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            EXPECT_EQ(batch.timestamps()[i], expected.timestamps()[i]);
+            EXPECT_EQ(batch.bidSizes()[i], expected.bidSizes()[i]);
+            EXPECT_DOUBLE_EQ(batch.bidPrices()[i], expected.bidPrices()[i]);
+            EXPECT_EQ(batch.tradeQuantities()[i], expected.tradeQuantities()[i]);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>  // For offsetof
+#include <cstdio>  // For std::remove
+#include <fstream>
+#include <limits>
+#include "historical_data_loader.h"
+#include "tick_store.h"
+
+// Test suite for the binary tick store
+class TickStoreTests : public ::testing::Test {
+protected:
+    std::string filepath;
+    TickBatch batch;
+
+    // Write a small store with a short index stride before each test
+    void SetUp() override {
+        filepath = "/tmp/test_tick_store.ticks";
+        for (int i = 0; i < 100; ++i) {
+            Tick tick;
+            tick.timestamp = 1000 + i * 10;
+            tick.instrumentId = static_cast<std::uint32_t>(i % 3);
+            tick.bidPrice = 99.5 + i;
+            tick.askPrice = 100.5 + i;
+            tick.tradePrice = 100.0 + i;
+            tick.tradeQuantity = i;
+            batch.append(tick);
+        }
+        TickStoreOptions options;
+        options.indexStride = 16;
+        options.compressed = false;
+        TickStoreWriter::write(filepath, batch, options);
+    }
+
+    // Remove the store after each test
+    void TearDown() override {
+        std::remove(filepath.c_str());
+    }
+};
+
+// Test to ensure that a store round-trips every column and exposes zero-copy column views.
+TEST_F(TickStoreTests, RoundTripsAllColumns) {
+    TickStoreReader reader(filepath);
+    ASSERT_EQ(reader.rowCount(), 100u);
+    EXPECT_EQ(reader.timeIndex().size(), 7u);
+    EXPECT_EQ(reader.column<std::uint32_t>(TickColumn::InstrumentId)[5], 2u);
+
+    TickBatch loaded;
+    EXPECT_EQ(reader.read(loaded), 100u);
+    for (std::size_t i = 0; i < loaded.size(); ++i) {
+        EXPECT_EQ(loaded.timestamps()[i], batch.timestamps()[i]);
+        EXPECT_DOUBLE_EQ(loaded.askPrices()[i], batch.askPrices()[i]);
+        EXPECT_EQ(loaded.tradeQuantities()[i], batch.tradeQuantities()[i]);
+    }
+}
+
+// Test to ensure that the loader recognizes the store and reads only the requested columns.
+TEST_F(TickStoreTests, LoaderReadsSelectedColumns) {
+    HistoricalDataLoader loader(filepath);
+    EXPECT_TRUE(loader.isTickStore());
+
+    TickBatch loaded;
+    EXPECT_EQ(loader.loadBatch(loaded, tickColumnBit(TickColumn::TradePrice)), 100u);
+    EXPECT_EQ(loaded.timestamps()[42], batch.timestamps()[42]);
+    EXPECT_DOUBLE_EQ(loaded.tradePrices()[42], batch.tradePrices()[42]);
+    EXPECT_DOUBLE_EQ(loaded.bidPrices()[42], 0.0);
+}
+
+// Test to ensure that the time index finds the first row at or after a timestamp.
+TEST_F(TickStoreTests, FindsRowsByTime) {
+    TickStoreReader reader(filepath);
+    EXPECT_EQ(reader.lowerBound(0), 0u);
+    EXPECT_EQ(reader.lowerBound(1005), 1u);
+    EXPECT_EQ(reader.lowerBound(1330), 33u);
+    EXPECT_EQ(reader.lowerBound(5000), 100u);
+}
+
+// Test to ensure that the loader reads only the ticks of a time range and instrument set.
+TEST_F(TickStoreTests, LoadsTimeRange) {
+    HistoricalDataLoader loader(filepath);
+
+    TickBatch loaded;
+    EXPECT_EQ(loader.loadRange(loaded, 1200, 1500), 30u);
+    EXPECT_EQ(loaded.timestamps().front(), 1200);
+    EXPECT_EQ(loaded.timestamps().back(), 1490);
+
+    TickBatch filtered;
+    EXPECT_EQ(loader.loadRange(filtered, 1200, 1500, {1}), 10u);
+    for (std::size_t i = 0; i < filtered.size(); ++i) {
+        EXPECT_EQ(filtered.instrumentIds()[i], 1u);
+    }
+}
+
+// Test to ensure that compressed columns decode to the original values, including partial blocks.
+TEST_F(TickStoreTests, RoundTripsCompressedColumns) {
+    TickStoreOptions options;
+    options.indexStride = 16;
+    options.compressed = true;
+    options.blockRows = 8;
+    options.priceDecimals = 2;
+    TickStoreWriter::write(filepath, batch, options);
+
+    TickStoreReader reader(filepath);
+    EXPECT_TRUE(reader.isCompressed(TickColumn::TradePrice));
+    EXPECT_TRUE(reader.column<double>(TickColumn::TradePrice).empty());
+
+    // Rows 13..70 start and end in the middle of a block.
+    TickBatch loaded;
+    EXPECT_EQ(reader.read(loaded, kAllTickColumns, 13, 70), 57u);
+    for (std::size_t i = 0; i < loaded.size(); ++i) {
+        EXPECT_EQ(loaded.timestamps()[i], batch.timestamps()[i + 13]);
+        EXPECT_EQ(loaded.instrumentIds()[i], batch.instrumentIds()[i + 13]);
+        EXPECT_DOUBLE_EQ(loaded.bidPrices()[i], batch.bidPrices()[i + 13]);
+        EXPECT_EQ(loaded.tradeQuantities()[i], batch.tradeQuantities()[i + 13]);
+    }
+    EXPECT_EQ(reader.lowerBound(1330), 33u);
+}
+
+// Test to ensure that a price column that cannot be scaled to integers is stored raw when compressing.
+TEST_F(TickStoreTests, StoresUnscalablePricesRaw) {
+    TickBatch unscalable;
+    for (int i = 0; i < 20; ++i) {
+        Tick tick;
+        tick.timestamp = 1000 + i;
+        tick.bidPrice = 99.5 + i;
+        tick.askPrice = i == 7 ? 1e300 : 100.5 + i;
+        tick.tradePrice = i == 3 ? std::numeric_limits<double>::quiet_NaN() : 100.0 + i;
+        unscalable.append(tick);
+    }
+    TickStoreOptions options;
+    options.compressed = true;
+    options.blockRows = 8;
+    TickStoreWriter::write(filepath, unscalable, options);
+
+    TickStoreReader reader(filepath);
+    EXPECT_TRUE(reader.isCompressed(TickColumn::BidPrice));
+    EXPECT_FALSE(reader.isCompressed(TickColumn::AskPrice));
+    EXPECT_FALSE(reader.isCompressed(TickColumn::TradePrice));
+
+    TickBatch loaded;
+    EXPECT_EQ(reader.read(loaded, kAllTickColumns, 0, 20), 20u);
+    EXPECT_DOUBLE_EQ(loaded.askPrices()[7], 1e300);
+    EXPECT_TRUE(std::isnan(loaded.tradePrices()[3]));
+    EXPECT_DOUBLE_EQ(loaded.tradePrices()[4], 104.0);
+    EXPECT_DOUBLE_EQ(loaded.bidPrices()[19], 118.5);
+}
+
+// Test to ensure that section sizes that wrap around when added to their offsets are rejected.
+TEST_F(TickStoreTests, RejectsWrappingSectionSizes) {
+    auto patch = [this](std::size_t offset, std::uint64_t value) {
+        std::fstream file(filepath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    const std::size_t firstColumn = sizeof(TickStoreHeader);
+
+    // offset + bytes wraps to a small value
+    patch(firstColumn + offsetof(TickStoreColumn, bytes), ~std::uint64_t{0} - 63);
+    EXPECT_THROW(TickStoreReader reader(filepath), std::runtime_error);
+
+    // indexCount * sizeof(TickStoreIndexEntry) wraps to a small value
+    TickStoreWriter::write(filepath, batch, TickStoreOptions{16, false});
+    patch(offsetof(TickStoreHeader, indexCount), (std::uint64_t{1} << 60) + 1);
+    EXPECT_THROW(TickStoreReader reader(filepath), std::runtime_error);
+
+    // rowCount * elementSize wraps to the size of a raw column
+    TickStoreWriter::write(filepath, batch, TickStoreOptions{16, false});
+    patch(offsetof(TickStoreHeader, rowCount), (std::uint64_t{1} << 62) + 100);
+    EXPECT_THROW(TickStoreReader reader(filepath), std::runtime_error);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "bar_aggregator.h"
+
+namespace {
+
+constexpr std::int64_t kSecond = 1000000000LL;
+
+} // namespace
+
+// Test to ensure that time bars are aligned to the interval and emitted on the first trade past their end.
+TEST(BarAggregatorTests, BuildsTimeBars) {
+    BarAggregator aggregator(BarType::Time, 60.0 * kSecond);
+    std::vector<Bar> bars;
+    auto emit = [&bars](const Bar& bar) { bars.push_back(bar); };
+
+    aggregator.addTrade(1, 61 * kSecond, 100.0, 10, emit);
+    aggregator.addTrade(1, 90 * kSecond, 103.0, 5, emit);
+    aggregator.addTrade(1, 119 * kSecond, 99.0, 5, emit);
+    aggregator.addTrade(2, 100 * kSecond, 50.0, 1, emit);
+    EXPECT_TRUE(bars.empty());
+
+    aggregator.addTrade(1, 120 * kSecond, 101.0, 1, emit);
+    ASSERT_EQ(bars.size(), 1u);
+    EXPECT_EQ(bars[0].instrumentId, 1u);
+    EXPECT_EQ(bars[0].openTime, 60 * kSecond);
+    EXPECT_EQ(bars[0].closeTime, 120 * kSecond);
+    EXPECT_DOUBLE_EQ(bars[0].open, 100.0);
+    EXPECT_DOUBLE_EQ(bars[0].high, 103.0);
+    EXPECT_DOUBLE_EQ(bars[0].low, 99.0);
+    EXPECT_DOUBLE_EQ(bars[0].close, 99.0);
+    EXPECT_EQ(bars[0].volume, 20);
+    EXPECT_EQ(bars[0].tickCount, 3u);
+    EXPECT_DOUBLE_EQ(bars[0].vwap(), (1000.0 + 515.0 + 495.0) / 20.0);
+
+    // A timer closes instrument 2's bar without waiting for its next trade
+    aggregator.closeExpired(120 * kSecond, emit);
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_EQ(bars[1].instrumentId, 2u);
+    EXPECT_EQ(aggregator.current(2), nullptr);
+    ASSERT_NE(aggregator.current(1), nullptr);
+    EXPECT_DOUBLE_EQ(aggregator.current(1)->open, 101.0);
+}
+
+// Test to ensure that tick, volume and dollar bars are emitted on the trade that reaches the threshold.
+TEST(BarAggregatorTests, BuildsActivityBars) {
+    std::vector<Bar> bars;
+    auto emit = [&bars](const Bar& bar) { bars.push_back(bar); };
+
+    BarAggregator ticks(BarType::Tick, 2);
+    for (int i = 0; i < 5; ++i) {
+        ticks.addTrade(0, i, 10.0 + i, 1, emit);
+    }
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_DOUBLE_EQ(bars[1].open, 12.0);
+    EXPECT_DOUBLE_EQ(bars[1].close, 13.0);
+    EXPECT_EQ(bars[1].openTime, 2);
+    EXPECT_EQ(bars[1].closeTime, 3);
+
+    bars.clear();
+    BarAggregator volume(BarType::Volume, 100);
+    volume.addTrade(0, 1, 10.0, 60, emit);
+    volume.addTrade(0, 2, 10.0, 60, emit);  // Crosses the threshold: not split
+    volume.addTrade(0, 3, 10.0, 10, emit);
+    ASSERT_EQ(bars.size(), 1u);
+    EXPECT_EQ(bars[0].volume, 120);
+
+    bars.clear();
+    BarAggregator dollar(BarType::Dollar, 1000.0);
+    dollar.addTrade(0, 1, 100.0, 5, emit);
+    dollar.addTrade(0, 2, 100.0, 5, emit);
+    dollar.flush(emit);
+    EXPECT_EQ(bars.size(), 1u);
+    EXPECT_DOUBLE_EQ(bars[0].dollarVolume, 1000.0);
+
+    EXPECT_THROW(BarAggregator(BarType::Tick, 0.0), std::runtime_error);
+}
+
+// Test to ensure that only the trades of a batch are aggregated.
+TEST(BarAggregatorTests, AggregatesBatches) {
+    TickBatch batch;
+    Tick trade;
+    trade.instrumentId = 4;
+    trade.timestamp = 5;
+    trade.tradePrice = 20.0;
+    trade.tradeQuantity = 3;
+    batch.append(trade);
+
+    Tick quote;
+    quote.instrumentId = 4;
+    quote.timestamp = 6;
+    quote.bidPrice = 19.0;
+    quote.askPrice = 21.0;
+    batch.append(quote);
+
+    BarAggregator aggregator(BarType::Tick, 10);
+    aggregator.addBatch(batch, [](const Bar&) {});
+    ASSERT_NE(aggregator.current(4), nullptr);
+    EXPECT_EQ(aggregator.current(4)->tickCount, 1u);
+}
+
+// Test to ensure that trades of invalid instrument ids never open a bar.
+TEST(BarAggregatorTests, IgnoresInvalidInstruments) {
+    BarAggregator aggregator(BarType::Tick, 1);
+    std::vector<Bar> bars;
+    auto collect = [&bars](const Bar& bar) { bars.push_back(bar); };
+    aggregator.addTrade(kInvalidInstrument, kSecond, 100.0, 1, collect);
+    aggregator.addTrade(InstrumentId{config::MAX_INSTRUMENTS}, kSecond, 100.0, 1, collect);
+    aggregator.flush(collect);
+    EXPECT_TRUE(bars.empty());
+    EXPECT_EQ(aggregator.current(kInvalidInstrument), nullptr);
+}
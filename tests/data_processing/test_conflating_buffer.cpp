@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "conflating_buffer.h"
+
+// Test to ensure that only the latest state per instrument is delivered, in instrument order.
+TEST(ConflatingBufferTests, KeepsLatestStatePerInstrument) {
+    ConflatingBuffer buffer(128);
+    EXPECT_EQ(buffer.capacity(), 128u);
+
+    Tick tick;
+    for (int i = 1; i <= 3; ++i) {
+        tick.instrumentId = 70;
+        tick.bidPrice = 100.0 + i;
+        buffer.publish(tick);
+    }
+    tick.instrumentId = 5;
+    tick.bidPrice = 50.0;
+    buffer.publish(tick);
+    tick.instrumentId = 128;
+    EXPECT_FALSE(buffer.publish(tick));  // Out of range
+    EXPECT_EQ(buffer.dropped(), 1u);
+
+    EXPECT_TRUE(buffer.pending());
+    std::vector<Tick> ticks;
+    EXPECT_EQ(buffer.drain([&ticks](const Tick& t) { ticks.push_back(t); }), 2u);
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].instrumentId, 5u);
+    EXPECT_EQ(ticks[1].instrumentId, 70u);
+    EXPECT_DOUBLE_EQ(ticks[1].bidPrice, 103.0);
+    EXPECT_EQ(buffer.published(), 4u);
+    EXPECT_EQ(buffer.conflated(), 2u);
+
+    EXPECT_FALSE(buffer.pending());
+    EXPECT_EQ(buffer.drain([](const Tick&) {}), 0u);
+}
+
+// Test to ensure that a consumer racing the producer never sees a torn state
+// and ends with the last published state.
+TEST(ConflatingBufferTests, ReadsConsistentStateUnderContention) {
+    ConflatingBuffer buffer(64);
+    constexpr int kUpdates = 200000;
+
+    std::thread producer([&buffer] {
+        Tick tick;
+        tick.instrumentId = 3;
+        for (int i = 1; i <= kUpdates; ++i) {
+            tick.bidPrice = i;
+            tick.askPrice = i + 1;
+            tick.bidSize = i;
+            buffer.publish(tick);
+        }
+    });
+
+    double last = 0.0;
+    bool consistent = true;
+    auto check = [&](const Tick& tick) {
+        consistent = consistent && tick.askPrice == tick.bidPrice + 1 && tick.bidSize == static_cast<std::int64_t>(tick.bidPrice);
+        last = tick.bidPrice;
+    };
+    while (last < kUpdates) {
+        if (buffer.drain(check) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(consistent);
+    EXPECT_DOUBLE_EQ(last, kUpdates);
+}
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>  // For std::remove
+#include <thread>
+#include "data_collector.h"
+#include "data_processor.h"
+#include "itch_protocol.h"
+
+// Helper function that plays the role of a local publisher: sends one datagram to 127.0.0.1:port.
+void sendDatagram(std::uint16_t port, const std::vector<std::uint8_t>& datagram) {
+    const int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(sender, 0);
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(port);
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(::sendto(sender, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr*>(&target),
+                       sizeof(target)),
+              static_cast<ssize_t>(datagram.size()));
+    ::close(sender);
+}
+
+// Helper function that appends an ITCH trade message to a datagram.
+void appendTrade(std::vector<std::uint8_t>& datagram, std::uint16_t instrument, std::int64_t timestamp,
+                 std::int64_t price, std::uint32_t shares) {
+    itch::Trade trade{};
+    trade.header = itch::makeHeader(itch::Trade::kType, instrument, timestamp);
+    trade.side = 'B';
+    trade.shares.set(shares);
+    trade.price.set(price * itch::kPriceScale);
+    itch::append(datagram, trade);
+}
+
+// Test to ensure that the ring preserves order across wrap-around and between threads.
+TEST(SpscRingTests, TransfersValuesInOrder) {
+    SpscRing<int> ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+
+    int value = 0;
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(8));
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 0);
+
+    // Move 10000 values through the ring from a producer thread.
+    std::thread producer([&ring] {
+        for (int i = 8; i < 10000; ++i) {
+            while (!ring.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 1;
+    while (expected < 10000) {
+        if (ring.drain([&expected](int received) { EXPECT_EQ(received, expected++); }) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
+
+// Test to ensure that ticks sent to a loopback socket reach the data processor through the ring.
+TEST(DataCollectorTests, ReceivesTicksOverUdp) {
+    DataCollector collector("udp://127.0.0.1:0");
+    collector.startCollection();
+    ASSERT_TRUE(collector.isCollecting());
+    ASSERT_NE(collector.port(), 0);
+
+    std::vector<std::uint8_t> datagram;
+    for (std::int64_t i = 0; i < 3; ++i) {
+        appendTrade(datagram, 7, 1000 + i, 100 + i, 5);
+    }
+    sendDatagram(collector.port(), itch::makePacket(0, 1, 3, datagram));
+
+    // Wait for the receive thread to publish the ticks.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (collector.ticksPublished() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    DataProcessor processor;
+    TickBatch batch;
+    EXPECT_EQ(processor.drain(collector.ticks(), batch), 3u);
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch.timestamps()[2], 1002);
+    EXPECT_EQ(batch.instrumentIds()[0], 7u);
+    EXPECT_DOUBLE_EQ(batch.tradePrices()[1], 101.0);
+    EXPECT_DOUBLE_EQ(batch.bidPrices()[0], 100.0);  // Seeded from the first trade by the processor
+
+    collector.stopCollection();
+    EXPECT_FALSE(collector.isCollecting());
+    EXPECT_EQ(collector.datagramsReceived(), 1u);
+    EXPECT_EQ(collector.messagesDecoded(), 3u);
+    EXPECT_EQ(collector.ticksDropped(), 0u);
+}
+
+// Test to ensure that every receive mode delivers the ticks and stamps them with the receive time.
+TEST(DataCollectorTests, AllReceiveModesDeliverTimestampedTicks) {
+    using Mode = DataCollector::ReceiveMode;
+    for (Mode mode : {Mode::Blocking, Mode::Batched, Mode::BusyPoll}) {
+        DataCollector collector("udp://127.0.0.1:0", mode);
+        collector.startCollection();
+
+        std::vector<std::uint8_t> datagram;
+        appendTrade(datagram, 0, 42, 100, 1);
+        for (std::uint64_t sequence = 1; sequence <= 4; ++sequence) {
+            sendDatagram(collector.port(), itch::makePacket(0, sequence, 1, datagram));
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (collector.ticksPublished() < 4 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        collector.stopCollection();
+
+        EXPECT_EQ(collector.datagramsReceived(), 4u);
+        EXPECT_LE(collector.receiveCalls(), 4u);
+        if (mode != Mode::Blocking) {
+            // Kernel timestamps are taken on arrival, before the datagrams are read.
+            EXPECT_EQ(collector.timestampedDatagrams(), 4u);
+        }
+
+        Tick received;
+        ASSERT_TRUE(collector.ticks().tryPop(received));
+        EXPECT_EQ(received.timestamp, 42);
+        EXPECT_GT(received.receiveTimestamp, 0);
+    }
+}
+
+// Test to ensure that in the batched modes a datagram too long for its buffer is dropped and counted,
+// not decoded from its truncated start.
+TEST(DataCollectorTests, DropsTruncatedDatagrams) {
+    DataCollector collector("udp://127.0.0.1:0", DataCollector::ReceiveMode::Batched);
+    collector.startCollection();
+
+    std::vector<std::uint8_t> oversized;
+    std::uint16_t trades = 0;
+    for (; oversized.size() <= config::FEED_DATAGRAM_SIZE; ++trades) {
+        appendTrade(oversized, 0, 42, 100, 1);
+    }
+    sendDatagram(collector.port(), itch::makePacket(0, 1, trades, oversized));
+    std::vector<std::uint8_t> datagram;
+    appendTrade(datagram, 0, 43, 100, 1);
+    sendDatagram(collector.port(), itch::makePacket(0, 1, 1, datagram));  // Takes the lost packet's place
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (collector.ticksPublished() < 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    collector.stopCollection();
+
+    EXPECT_EQ(collector.truncatedDatagrams(), 1u);
+    EXPECT_EQ(collector.datagramsReceived(), 1u);
+    EXPECT_EQ(collector.ticksPublished(), 1u);
+    EXPECT_EQ(collector.malformedMessages(), 0u);
+}
+
+// Test to ensure that a sequence gap is recovered from a snapshot, with the live packets received
+// during the recovery replayed after it.
+TEST(DataCollectorTests, RecoversGapFromSnapshot) {
+    const std::uint16_t channel = 5;
+    auto snapshots = std::make_shared<FileSnapshotSource>("/tmp");
+
+    // The snapshot covers messages 1 and 2 and carries a single quote.
+    Snapshot snapshot;
+    snapshot.nextSequence = 3;
+    itch::Quote quote{};
+    quote.header = itch::makeHeader(itch::Quote::kType, 1, 2);
+    quote.bidPrice.set(99 * itch::kPriceScale);
+    quote.askPrice.set(101 * itch::kPriceScale);
+    itch::append(snapshot.messages, quote);
+    FileSnapshotSource::write(snapshots->fileName(channel), snapshot);
+
+    DataCollector collector("udp://127.0.0.1:0");
+    collector.setSnapshotSource(snapshots);
+    collector.startCollection();
+
+    // Message 1 arrives, message 2 is lost, and messages 3..(3 + window) arrive after the hole.
+    const std::uint64_t last = 3 + config::FEED_REORDER_WINDOW;
+    for (std::uint64_t sequence = 1; sequence <= last; ++sequence) {
+        if (sequence == 2) {
+            continue;
+        }
+        std::vector<std::uint8_t> messages;
+        appendTrade(messages, 1, static_cast<std::int64_t>(sequence), 100, 1);
+        sendDatagram(collector.port(), itch::makePacket(channel, sequence, 1, messages));
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (collector.ticksPublished() < last && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    collector.stopCollection();
+    std::remove(snapshots->fileName(channel).c_str());
+
+    EXPECT_EQ(collector.sequenceGaps(), 1u);
+    EXPECT_EQ(collector.recoveries(), 1u);
+    EXPECT_EQ(collector.lostMessages(), 0u);
+
+    // Trade 1, then the snapshot quote, then trades 3.. in sequence order.
+    std::vector<Tick> ticks;
+    collector.ticks().drain([&ticks](const Tick& tick) { ticks.push_back(tick); });
+    ASSERT_EQ(ticks.size(), last);
+    EXPECT_EQ(ticks[0].timestamp, 1);
+    EXPECT_DOUBLE_EQ(ticks[1].bidPrice, 99.0);
+    for (std::size_t i = 2; i < ticks.size(); ++i) {
+        EXPECT_EQ(ticks[i].timestamp, static_cast<std::int64_t>(i + 1));
+    }
+}
+
+// Test to ensure that A/B legs are merged: every message is published once, whichever leg delivers it first.
+TEST(DataCollectorTests, ArbitratesRedundantLegs) {
+    DataCollector collector("udp://127.0.0.1:0", "udp://127.0.0.1:0");
+    collector.startCollection();
+    ASSERT_NE(collector.port(0), collector.port(1));
+
+    // A leads on 1 and 2, B leads on 3; B's copy of 2 is lost.
+    auto packet = [](std::uint64_t sequence) {
+        std::vector<std::uint8_t> messages;
+        appendTrade(messages, 0, static_cast<std::int64_t>(sequence), 100, 1);
+        return itch::makePacket(0, sequence, 1, messages);
+    };
+    sendDatagram(collector.port(0), packet(1));
+    sendDatagram(collector.port(0), packet(2));
+    sendDatagram(collector.port(1), packet(1));
+    sendDatagram(collector.port(1), packet(3));
+    sendDatagram(collector.port(0), packet(3));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (collector.datagramsReceived() < 5 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    collector.stopCollection();
+
+    EXPECT_EQ(collector.ticksPublished(), 3u);
+    EXPECT_EQ(collector.arbitratedDuplicates(), 2u);
+    EXPECT_EQ(collector.legWins(0) + collector.legWins(1), 3u);
+    EXPECT_EQ(collector.sequenceGaps(), 0u);
+
+    std::vector<std::int64_t> timestamps;
+    collector.ticks().drain([&timestamps](const Tick& tick) { timestamps.push_back(tick.timestamp); });
+    EXPECT_EQ(timestamps, (std::vector<std::int64_t>{1, 2, 3}));
+}
+
+// Test to ensure that sources other than UDP endpoints are rejected.
+TEST(DataCollectorTests, RejectsUnsupportedSource) {
+    DataCollector collector("market_feed");
+    EXPECT_THROW(collector.startCollection(), std::runtime_error);
+    EXPECT_FALSE(collector.isCollecting());
+}
@@ -1,20 +1,84 @@
 #include <gtest/gtest.h>
 #include "data_processor.h"
+#include "tsc_clock.h"
 
-// Test to ensure that the DataProcessor can correctly process the raw data.
+// Test to ensure that the DataProcessor can correctly parse and process raw data.
 TEST(DataProcessorTests, CanProcessData) {
     // Initialize the data processor
     DataProcessor processor;
 
-    // Create a vector of raw data strings
-    std::vector<std::string> rawData = {"data1", "data2", "data3"};
+    // Create a vector of raw data records, including a header line
+    std::vector<std::string> rawData = {"Date,Price,Volume", "2023-09-20,100,200", "2023-09-21,105.5,250"};
 
-    // Process the raw data using the processor
-    auto processedData = processor.process(rawData);
+    // Parse the raw records into a typed batch and process it in place
+    TickBatch batch;
+    EXPECT_EQ(processor.fill(rawData, batch), 2u);
+    processor.process(batch);
 
-    // Verify that the processed data has the same size as the raw data
-    EXPECT_EQ(processedData.size(), rawData.size());
+    // Verify that the header was skipped and the records were parsed into the right columns
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.timestamps()[0], 1695168000LL * 1000000000LL);
+    EXPECT_DOUBLE_EQ(batch.tradePrices()[1], 105.5);
+    EXPECT_EQ(batch.tradeQuantities()[1], 250);
 
-    // Verify that the first element in the processed data is correctly transformed
-    EXPECT_EQ(processedData[0], "Transformed: data1");
+    // Verify that the missing quotes were seeded from the trade price
+    EXPECT_DOUBLE_EQ(batch.bidPrices()[0], 100.0);
+    EXPECT_DOUBLE_EQ(batch.askPrices()[0], 100.0);
+}
+
+// Test to ensure that invalid ticks are filtered out and quotes are forward-filled.
+TEST(DataProcessorTests, FiltersInvalidTicks) {
+    DataProcessor processor;
+    TickBatch batch;
+
+    Tick quote;
+    quote.timestamp = 1;
+    quote.bidPrice = 99.0;
+    quote.askPrice = 101.0;
+    batch.append(quote);
+
+    Tick crossed = quote;
+    crossed.timestamp = 2;
+    crossed.bidPrice = 102.0;
+    batch.append(crossed);
+
+    Tick trade;
+    trade.timestamp = 3;
+    trade.tradePrice = 100.0;
+    trade.tradeQuantity = 10;
+    batch.append(trade);
+
+    Tick unknown = trade;
+    unknown.timestamp = 4;
+    unknown.instrumentId = kInvalidInstrument;
+    batch.append(unknown);
+
+    processor.process(batch);
+
+    // The crossed quote and the unknown instrument are dropped and the trade inherits the last valid quote
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.timestamps()[1], 3);
+    EXPECT_DOUBLE_EQ(batch.bidPrices()[1], 99.0);
+    EXPECT_DOUBLE_EQ(batch.askPrices()[1], 101.0);
+}
+
+// Test to ensure that ticks carrying a receive timestamp feed the receive-to-processed latency.
+TEST(DataProcessorTests, MeasuresReceiveToProcessedLatency) {
+    DataProcessor processor;
+    TickBatch batch;
+
+    Tick received;
+    received.bidPrice = 99.0;
+    received.askPrice = 101.0;
+    received.receiveTimestamp = TscClock::now() - 5000;
+    batch.append(received);
+
+    Tick loaded = received;  // E.g. read from a file: no receive timestamp
+    loaded.receiveTimestamp = 0;
+    batch.append(loaded);
+
+    processor.process(batch);
+    EXPECT_EQ(processor.latency().count, 1u);
+    EXPECT_GE(processor.latency().max, 5000);
+    EXPECT_LT(processor.latency().max, 1'000'000'000);
 }
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "feed_arbitrator.h"
+
+// Test to ensure that the first copy of a packet wins and the late copy is dropped and timed.
+TEST(FeedArbitratorTests, FirstCopyWins) {
+    FeedArbitrator arbitrator(128);
+
+    EXPECT_TRUE(arbitrator.accept(0, 1, 2, 1000).accepted);   // A delivers 1..2
+    const FeedArbitrator::Result late = arbitrator.accept(1, 1, 2, 1250);  // B's copy
+    EXPECT_FALSE(late.accepted);
+    EXPECT_EQ(late.lead, 250);
+
+    EXPECT_TRUE(arbitrator.accept(1, 3, 1, 2000).accepted);   // B is first on 3
+    EXPECT_FALSE(arbitrator.accept(0, 3, 1, 2100).accepted);
+
+    EXPECT_EQ(arbitrator.wins(0), 1u);
+    EXPECT_EQ(arbitrator.wins(1), 1u);
+    EXPECT_EQ(arbitrator.leadTime(0), 250u);
+    EXPECT_EQ(arbitrator.leadTime(1), 100u);
+    EXPECT_EQ(arbitrator.duplicates(), 2u);
+}
+
+// Test to ensure that the window slides: old sequence numbers are forgotten and treated as seen,
+// and packets that partly overlap are accepted for their new messages.
+TEST(FeedArbitratorTests, SlidesWindow) {
+    FeedArbitrator arbitrator(64);
+
+    EXPECT_TRUE(arbitrator.accept(0, 10, 1, 0).accepted);
+    EXPECT_TRUE(arbitrator.accept(0, 100, 1, 0).accepted);  // Slides 10 out of the window
+    EXPECT_FALSE(arbitrator.accept(1, 10, 1, 0).accepted);  // Too old: treated as seen
+    EXPECT_TRUE(arbitrator.accept(1, 99, 3, 0).accepted);   // 99 and 101 are new
+    EXPECT_FALSE(arbitrator.accept(0, 101, 1, 0).accepted);
+
+    // Sequence numbers that wrap onto reused bitmap slots start out unseen.
+    EXPECT_TRUE(arbitrator.accept(0, 164, 1, 0).accepted);
+    EXPECT_TRUE(arbitrator.accept(0, 165, 1, 0).accepted);
+    EXPECT_TRUE(arbitrator.accept(0, 0, 0, 0).accepted);    // Heartbeat
+}
+
+// Test to ensure that the lead time is measured from the first arrival of every message,
+// also when the legs split the messages into packets differently.
+TEST(FeedArbitratorTests, TracksLeadAcrossPacketBoundaries) {
+    FeedArbitrator arbitrator(64);
+
+    EXPECT_TRUE(arbitrator.accept(0, 1, 2, 1000).accepted);   // A delivers 1 and 2
+    const FeedArbitrator::Result late = arbitrator.accept(1, 2, 1, 1030);
+    EXPECT_FALSE(late.accepted);
+    EXPECT_EQ(late.lead, 30);
+
+    EXPECT_TRUE(arbitrator.accept(1, 3, 2, 1100).accepted);   // B delivers 3 and 4
+    EXPECT_TRUE(arbitrator.accept(0, 4, 2, 1150).accepted);   // Only 5 is new for A
+    EXPECT_EQ(arbitrator.accept(1, 5, 1, 1170).lead, 20);
+    EXPECT_EQ(arbitrator.accept(1, 4, 1, 1180).lead, 0);      // Same leg as the first copy of 4: no lead
+
+    EXPECT_EQ(arbitrator.leadTime(0), 50u);
+    EXPECT_EQ(arbitrator.leadTime(1), 0u);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "instrument_registry.h"
+
+// Test to ensure that a reference-data file is loaded with dense ids in file order.
+TEST(InstrumentRegistryTests, LoadsReferenceData) {
+    const std::string fileName = "/tmp/test_instruments.csv";
+    {
+        std::ofstream file(fileName);
+        file << "symbol,tick_size,lot_size\n"
+             << "AAPL,0.01,100\r\n"
+             << "\n"
+             << "ES,0.25\n"
+             << "EURUSD\n";
+    }
+
+    InstrumentRegistry registry(fileName);
+    std::remove(fileName.c_str());
+
+    ASSERT_EQ(registry.size(), 3u);
+    EXPECT_EQ(registry.find("AAPL"), 0u);
+    EXPECT_EQ(registry.find("ES"), 1u);
+    EXPECT_EQ(registry.find("EURUSD"), 2u);
+    EXPECT_EQ(registry.find("MSFT"), kInvalidInstrument);
+    EXPECT_EQ(registry.info(0).lotSize, 100);
+    EXPECT_DOUBLE_EQ(registry.info(1).tickSize, 0.25);
+    EXPECT_EQ(registry.info(1).lotSize, 1);
+    EXPECT_EQ(registry.symbol(2), "EURUSD");
+}
+
+// Test to ensure that symbols are interned once and that bad reference data is rejected.
+TEST(InstrumentRegistryTests, InternsSymbols) {
+    InstrumentRegistry registry;
+    const InstrumentId first = registry.intern("MSFT");
+    EXPECT_EQ(registry.intern("MSFT"), first);
+    EXPECT_EQ(registry.intern("NVDA"), first + 1);
+    EXPECT_THROW(registry.add(InstrumentInfo{"MSFT", 0.01, 1}), std::runtime_error);
+
+    const std::string fileName = "/tmp/test_instruments_bad.csv";
+    {
+        std::ofstream file(fileName);
+        file << "AAPL,abc,100\n";
+    }
+    EXPECT_THROW(InstrumentRegistry bad(fileName), std::runtime_error);
+    std::remove(fileName.c_str());
+    EXPECT_THROW(InstrumentRegistry missing("/tmp/no_such_instruments.csv"), std::runtime_error);
+}
+
+// Test to ensure that the registry never hands out an id at or above config::MAX_INSTRUMENTS.
+TEST(InstrumentRegistryTests, StopsAtMaxInstruments) {
+    InstrumentRegistry registry;
+    for (unsigned i = 0; i < config::MAX_INSTRUMENTS; ++i) {
+        registry.intern("S" + std::to_string(i));
+    }
+    EXPECT_EQ(registry.size(), config::MAX_INSTRUMENTS);
+    EXPECT_TRUE(isValidInstrument(registry.find("S" + std::to_string(config::MAX_INSTRUMENTS - 1))));
+    EXPECT_THROW(registry.intern("ONE_TOO_MANY"), std::runtime_error);
+    EXPECT_FALSE(isValidInstrument(kInvalidInstrument));
+}
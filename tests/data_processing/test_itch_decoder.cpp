@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "itch_decoder.h"
+
+// Handler that records the messages it is interested in. Other message types are ignored by the decoder.
+struct RecordingHandler {
+    std::vector<itch::AddOrder> adds;
+    std::vector<itch::Quote> quotes;
+    std::vector<std::uint64_t> deletes;
+
+    void onMessage(const itch::AddOrder& message) { adds.push_back(message); }
+    void onMessage(const itch::Quote& message) { quotes.push_back(message); }
+    void onMessage(const itch::OrderDelete& message) { deletes.push_back(message.orderReference.value()); }
+};
+
+// Test to ensure that framed messages are decoded field by field and dispatched by type.
+TEST(ItchDecoderTests, DecodesFramedMessages) {
+    std::vector<std::uint8_t> datagram;
+
+    itch::AddOrder add{};
+    add.header = itch::makeHeader(itch::AddOrder::kType, 513, 1'700'000'000'123'456'789);
+    add.orderReference.set(0x0102030405060708ULL);
+    add.side = 'S';
+    add.shares.set(300);
+    add.price.set(1'012'500);  // 101.25
+    itch::append(datagram, add);
+
+    itch::Quote quote{};
+    quote.header = itch::makeHeader(itch::Quote::kType, 2, 77);
+    quote.bidPrice.set(995'000);
+    quote.bidSize.set(10);
+    quote.askPrice.set(-1);
+    quote.askSize.set(20);
+    itch::append(datagram, quote);
+
+    itch::OrderExecuted executed{};  // Not handled, but still a valid message
+    executed.header = itch::makeHeader(itch::OrderExecuted::kType, 2, 78);
+    itch::append(datagram, executed);
+
+    itch::OrderDelete removed{};
+    removed.header = itch::makeHeader(itch::OrderDelete::kType, 513, 79);
+    removed.orderReference.set(42);
+    itch::append(datagram, removed);
+
+    // The wire format is big-endian.
+    EXPECT_EQ(datagram[0], 0);
+    EXPECT_EQ(datagram[1], sizeof(itch::AddOrder));
+    EXPECT_EQ(datagram[3], 0x02);  // High byte of locate 513
+
+    RecordingHandler handler;
+    ItchDecoder<RecordingHandler> decoder(handler);
+    EXPECT_EQ(decoder.decode(datagram.data(), datagram.size()), 4u);
+    EXPECT_EQ(decoder.malformed(), 0u);
+
+    ASSERT_EQ(handler.adds.size(), 1u);
+    EXPECT_EQ(handler.adds[0].header.locate.value(), 513);
+    EXPECT_EQ(handler.adds[0].header.timestamp.value(), 1'700'000'000'123'456'789);
+    EXPECT_EQ(handler.adds[0].orderReference.value(), 0x0102030405060708ULL);
+    EXPECT_EQ(handler.adds[0].side, 'S');
+    EXPECT_EQ(handler.adds[0].shares.value(), 300u);
+    EXPECT_EQ(handler.adds[0].price.value(), 1'012'500);
+
+    ASSERT_EQ(handler.quotes.size(), 1u);
+    EXPECT_EQ(handler.quotes[0].askPrice.value(), -1);
+    EXPECT_EQ(handler.quotes[0].askSize.value(), 20u);
+
+    ASSERT_EQ(handler.deletes.size(), 1u);
+    EXPECT_EQ(handler.deletes[0], 42u);
+}
+
+// Test to ensure that unknown, short and truncated messages are skipped and counted.
+TEST(ItchDecoderTests, SkipsMalformedMessages) {
+    std::vector<std::uint8_t> datagram = {0, 3, 'Z', 1, 2};  // Unknown type 'Z'
+    datagram.insert(datagram.end(), {0, 2, 'A', 0});          // Add order shorter than its layout
+
+    itch::OrderDelete removed{};
+    removed.header = itch::makeHeader(itch::OrderDelete::kType, 1, 1);
+    removed.orderReference.set(7);
+    itch::append(datagram, removed);
+    datagram.insert(datagram.end(), {0, 50, 'D'});  // Frame longer than the datagram
+
+    RecordingHandler handler;
+    ItchDecoder<RecordingHandler> decoder(handler);
+    EXPECT_EQ(decoder.decode(datagram.data(), datagram.size()), 1u);
+    EXPECT_EQ(decoder.malformed(), 3u);
+    ASSERT_EQ(handler.deletes.size(), 1u);
+    EXPECT_EQ(handler.deletes[0], 7u);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <stdexcept>
+#include "data_processor.h"
+#include "l2_book.h"
+
+// Test to ensure that levels are stored and removed, and that the touch and depth follow them.
+TEST(L2BookTests, TracksLevelsAndTouch) {
+    L2Book book;
+    book.setLevel(Side::Bid, 10000, 5);
+    book.setLevel(Side::Bid, 9998, 7);
+    book.setLevel(Side::Ask, 10002, 3);
+    book.setLevel(Side::Ask, 10005, 9);
+
+    EXPECT_EQ(book.bestBid(), 10000);
+    EXPECT_EQ(book.bestBidQuantity(), 5);
+    EXPECT_EQ(book.bestAsk(), 10002);
+    EXPECT_EQ(book.bestAskQuantity(), 3);
+    EXPECT_EQ(book.quantityAt(Side::Bid, 9998), 7);
+    EXPECT_EQ(book.quantityAt(Side::Bid, 9999), 0);
+
+    // Executing the best bid moves the touch to the next level
+    book.addQuantity(Side::Bid, 10000, -5);
+    EXPECT_EQ(book.bestBid(), 9998);
+    EXPECT_EQ(book.levelCount(Side::Bid), 1u);
+
+    std::array<L2Book::Level, 4> levels{};
+    ASSERT_EQ(book.depth(Side::Ask, levels), 2u);
+    EXPECT_EQ(levels[0].price, 10002);
+    EXPECT_EQ(levels[1].price, 10005);
+    EXPECT_EQ(levels[1].quantity, 9);
+
+    book.setLevel(Side::Bid, 9998, 0);
+    EXPECT_FALSE(book.hasBid());
+    EXPECT_EQ(book.bestBid(), 0);
+}
+
+// Test to ensure that the window follows the market without losing the levels near the touch,
+// and that updates too far from the touch are ignored.
+TEST(L2BookTests, RecentersWindow) {
+    constexpr auto levels = static_cast<std::int64_t>(L2Book::kLevels);
+    L2Book book;
+    book.setLevel(Side::Bid, 1000, 1);
+    book.setLevel(Side::Ask, 1001, 1);
+    const std::int64_t anchor = book.anchor();
+
+    // Drift the market upwards well past the end of the initial window
+    for (std::int64_t price = 1001; price < 1000 + levels; ++price) {
+        book.setLevel(Side::Bid, price, 2);
+        book.setLevel(Side::Ask, price + 1, 2);
+        book.setLevel(Side::Ask, price, 0);
+    }
+    EXPECT_GT(book.anchor(), anchor);
+    EXPECT_EQ(book.bestBid(), 999 + levels);
+    EXPECT_EQ(book.bestAsk(), 1000 + levels);
+    EXPECT_EQ(book.quantityAt(Side::Bid, 998 + levels), 2);
+
+    // A price a whole window away from the touch does not fit
+    book.setLevel(Side::Ask, 1000 + 3 * levels, 1);
+    EXPECT_EQ(book.outOfRange(), 1u);
+    EXPECT_EQ(book.bestAsk(), 1000 + levels);
+}
+
+// Test to ensure that a top-of-book update removes the levels it makes stale.
+TEST(L2BookTests, AppliesTopOfBook) {
+    L2Book book;
+    book.applyTopOfBook(100, 10, 102, 20);
+    book.applyTopOfBook(99, 11, 101, 21);
+    EXPECT_EQ(book.bestBid(), 99);
+    EXPECT_EQ(book.bestAsk(), 101);
+    EXPECT_EQ(book.quantityAt(Side::Bid, 100), 0);
+    EXPECT_EQ(book.quantityAt(Side::Ask, 102), 20);
+
+    // A one-sided update through the other side removes the levels it crosses.
+    book.applyTopOfBook(102, 12, 0, 0);
+    EXPECT_EQ(book.bestBid(), 102);
+    EXPECT_EQ(book.quantityAt(Side::Ask, 101), 0);
+    EXPECT_EQ(book.quantityAt(Side::Ask, 102), 0);
+    EXPECT_FALSE(book.hasAsk());
+    book.applyTopOfBook(0, 0, 98, 22);
+    EXPECT_EQ(book.bestAsk(), 98);
+    EXPECT_EQ(book.quantityAt(Side::Bid, 99), 0);
+    EXPECT_FALSE(book.hasBid());
+}
+
+// Test to ensure that the DataProcessor keeps a book per instrument from the quotes it processes.
+TEST(L2BookTests, DataProcessorUpdatesBooks) {
+    DataProcessor processor;
+    TickBatch batch;
+
+    Tick quote;
+    quote.instrumentId = 3;
+    quote.bidPrice = 100.25;
+    quote.askPrice = 100.27;
+    quote.bidSize = 500;
+    quote.askSize = 300;
+    batch.append(quote);
+
+    Tick trade;
+    trade.instrumentId = 3;
+    trade.tradePrice = 100.26;
+    trade.tradeQuantity = 100;
+    batch.append(trade);
+
+    processor.process(batch);
+
+    const L2BookSet& books = processor.books();
+    EXPECT_EQ(books.find(0), nullptr);
+    const L2Book* book = books.find(3);
+    ASSERT_NE(book, nullptr);
+    EXPECT_EQ(book->bestBid(), books.toTicks(100.25));
+    EXPECT_EQ(book->bestBid(), 10025);
+    EXPECT_EQ(book->bestAskQuantity(), 300);
+    EXPECT_DOUBLE_EQ(books.toPrice(book->bestAsk()), 100.27);
+}
+
+// Test to ensure that invalid instrument ids never index the book set.
+TEST(L2BookTests, BookSetRejectsInvalidInstruments) {
+    L2BookSet books;
+    EXPECT_THROW(books.book(kInvalidInstrument), std::runtime_error);
+    EXPECT_THROW(books.book(InstrumentId{config::MAX_INSTRUMENTS}), std::runtime_error);
+
+    TickBatch batch;
+    Tick quote;
+    quote.instrumentId = kInvalidInstrument;
+    quote.bidPrice = 100.25;
+    quote.askPrice = 100.27;
+    quote.bidSize = 500;
+    quote.askSize = 300;
+    batch.append(quote);
+    books.apply(batch);
+    EXPECT_EQ(books.find(kInvalidInstrument), nullptr);
+}
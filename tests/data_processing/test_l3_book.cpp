@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "flat_hash_map.h"
+#include "itch_decoder.h"
+#include "l3_book.h"
+
+// Test to ensure that the open-addressing map keeps finding every key after erasures shift entries back.
+TEST(L3BookTests, FlatHashMapErasesWithoutTombstones) {
+    FlatHashMap<std::uint64_t> map(64);
+    for (std::uint64_t key = 0; key < 64; ++key) {
+        EXPECT_TRUE(map.insert(key * 1024, static_cast<std::uint32_t>(key)));
+    }
+    EXPECT_FALSE(map.insert(65 * 1024, 65));  // Full
+    for (std::uint64_t key = 0; key < 64; key += 2) {
+        EXPECT_TRUE(map.erase(key * 1024));
+    }
+    EXPECT_FALSE(map.erase(0));
+    EXPECT_FALSE(map.insert(1024, 9));  // Duplicate
+    EXPECT_EQ(map.size(), 32u);
+    for (std::uint64_t key = 0; key < 64; ++key) {
+        EXPECT_EQ(map.find(key * 1024), key % 2 == 0 ? FlatHashMap<std::uint64_t>::kMissing : key);
+    }
+}
+
+// Test to ensure that orders queue in arrival order and that queue positions follow executions and cancels.
+TEST(L3BookTests, TracksQueuePosition) {
+    L3Book book(16, 8);
+    EXPECT_TRUE(book.addOrder(1, 7, Side::Bid, 1000, 100));
+    EXPECT_TRUE(book.addOrder(2, 7, Side::Bid, 1000, 50));
+    EXPECT_TRUE(book.addOrder(3, 7, Side::Bid, 1000, 30, true));
+    EXPECT_TRUE(book.addOrder(4, 7, Side::Ask, 1002, 10));
+    EXPECT_FALSE(book.addOrder(4, 7, Side::Ask, 1003, 10));  // Reference in use
+
+    auto position = book.queuePosition(3);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position->ordersAhead, 2u);
+    EXPECT_EQ(position->quantityAhead, 150);
+    EXPECT_TRUE(book.find(3)->own);
+
+    // The front order is partly executed, then the second one is cancelled
+    EXPECT_TRUE(book.reduceOrder(1, 60));
+    EXPECT_TRUE(book.deleteOrder(2));
+    position = book.queuePosition(3);
+    EXPECT_EQ(position->ordersAhead, 1u);
+    EXPECT_EQ(position->quantityAhead, 40);
+
+    std::vector<std::uint64_t> queue;
+    book.forEachOrder(7, Side::Bid, 1000, [&](const L3Book::Order& order) { queue.push_back(order.reference); });
+    EXPECT_EQ(queue, (std::vector<std::uint64_t>{1, 3}));
+    EXPECT_EQ(book.levelQuantity(7, Side::Bid, 1000), 70);
+    EXPECT_EQ(book.levelOrders(7, Side::Bid, 1000), 2u);
+
+    const L2Book* aggregated = book.aggregated().find(7);
+    ASSERT_NE(aggregated, nullptr);
+    EXPECT_EQ(aggregated->bestBid(), 1000);
+    EXPECT_EQ(aggregated->bestBidQuantity(), 70);
+    EXPECT_EQ(aggregated->bestAsk(), 1002);
+
+    // A replace sends the order to the back of the new level
+    EXPECT_TRUE(book.replaceOrder(1, 11, 20, 1000));
+    EXPECT_EQ(book.queuePosition(11)->ordersAhead, 1u);
+    EXPECT_EQ(book.orderCount(), 3u);
+}
+
+// Test to ensure that the pools bound the book and that freed nodes are reused.
+TEST(L3BookTests, ReusesPooledNodes) {
+    L3Book book(2, 2);
+    EXPECT_TRUE(book.addOrder(1, 0, Side::Bid, 10, 1));
+    EXPECT_TRUE(book.addOrder(2, 0, Side::Ask, 12, 1));
+    EXPECT_FALSE(book.addOrder(3, 0, Side::Ask, 12, 1));  // Order pool exhausted
+    EXPECT_EQ(book.rejected(), 1u);
+
+    EXPECT_TRUE(book.reduceOrder(2, 1));
+    EXPECT_TRUE(book.addOrder(3, 0, Side::Ask, 13, 1));  // Reuses the order node and the level
+    EXPECT_EQ(book.levelQuantity(0, Side::Ask, 12), 0);
+    EXPECT_EQ(book.aggregated().find(0)->bestAsk(), 13);
+
+    book.clear();
+    EXPECT_EQ(book.orderCount(), 0u);
+    EXPECT_FALSE(book.aggregated().find(0)->hasBid());
+}
+
+// Test to ensure that a rejected replace or reduce leaves the original order untouched.
+TEST(L3BookTests, KeepsOrderWhenReplaceIsRejected) {
+    L3Book book(3, 1);
+    EXPECT_TRUE(book.addOrder(1, 0, Side::Bid, 10, 5));
+    EXPECT_TRUE(book.addOrder(2, 0, Side::Bid, 10, 7));
+
+    EXPECT_FALSE(book.replaceOrder(1, 2, 5, 10));  // New reference already in use
+    EXPECT_FALSE(book.replaceOrder(1, 3, 5, 11));  // Level pool full and the original's level is shared
+    EXPECT_FALSE(book.replaceOrder(1, 3, 0, 10));  // Quantity not positive
+    EXPECT_FALSE(book.reduceOrder(1, 0));
+    EXPECT_FALSE(book.reduceOrder(1, -5));
+    EXPECT_EQ(book.rejected(), 5u);
+    EXPECT_EQ(book.orderCount(), 2u);
+    EXPECT_EQ(book.levelQuantity(0, Side::Bid, 10), 12);
+    EXPECT_EQ(book.queuePosition(1)->ordersAhead, 0u);
+
+    EXPECT_TRUE(book.reduceOrder(2, 7));
+    EXPECT_TRUE(book.replaceOrder(1, 3, 5, 11));  // The original's level is freed for the new price
+    EXPECT_EQ(book.levelQuantity(0, Side::Bid, 11), 5);
+    EXPECT_EQ(book.aggregated().find(0)->bestBid(), 11);
+}
+
+// Test to ensure that the book can be driven by ITCH order messages through the decoder.
+TEST(L3BookTests, AppliesItchMessages) {
+    L3Book book(64, 16);
+    ItchDecoder<L3Book> decoder(book);
+
+    std::vector<std::uint8_t> messages;
+    itch::AddOrder add{};
+    add.header = itch::makeHeader(itch::AddOrder::kType, 5, 1);
+    add.orderReference.set(42);
+    add.side = 'S';
+    add.shares.set(300);
+    add.price.set(1002500);  // 100.25
+    itch::append(messages, add);
+
+    itch::OrderExecuted executed{};
+    executed.header = itch::makeHeader(itch::OrderExecuted::kType, 5, 2);
+    executed.orderReference.set(42);
+    executed.executedShares.set(100);
+    itch::append(messages, executed);
+
+    EXPECT_EQ(decoder.decode(messages.data(), messages.size()), 2u);
+    const L3Book::Order* order = book.find(42);
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(order->instrumentId, 5u);
+    EXPECT_EQ(order->side, Side::Ask);
+    EXPECT_EQ(order->price, 10025);
+    EXPECT_EQ(order->quantity, 200);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>  // For std::remove
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "data_collector.h"
+#include "data_processor.h"
+#include "itch_protocol.h"
+#include "market_capture.h"
+
+// Helper function that sends one datagram to 127.0.0.1:port.
+void sendDatagram(std::uint16_t port, const std::vector<std::uint8_t>& datagram) {
+    const int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(sender, 0);
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(port);
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(::sendto(sender, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr*>(&target),
+                       sizeof(target)),
+              static_cast<ssize_t>(datagram.size()));
+    ::close(sender);
+}
+
+// Helper function that builds a packet carrying one ITCH trade.
+std::vector<std::uint8_t> tradePacket(std::uint64_t sequence, std::uint16_t instrument, std::int64_t price) {
+    std::vector<std::uint8_t> payload;
+    itch::Trade trade{};
+    trade.header = itch::makeHeader(itch::Trade::kType, instrument, static_cast<std::int64_t>(sequence));
+    trade.side = 'B';
+    trade.shares.set(10);
+    trade.price.set(price * itch::kPriceScale);
+    itch::append(payload, trade);
+    return itch::makePacket(0, sequence, 1, payload);
+}
+
+// Test to ensure that datagrams received live are captured and produce the same ticks when replayed.
+TEST(MarketCaptureTests, ReplaysLiveCaptureThroughCollector) {
+    const std::string fileName = "test_live_capture.bin";
+    std::remove(fileName.c_str());
+    {
+        DataCollector collector("udp://127.0.0.1:0");
+        auto recorder = std::make_shared<CaptureRecorder>(fileName);
+        collector.setCaptureRecorder(recorder);
+        collector.startCollection();
+        for (std::uint64_t sequence = 1; sequence <= 3; ++sequence) {
+            sendDatagram(collector.port(), tradePacket(sequence, 5, 100 + static_cast<std::int64_t>(sequence)));
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (collector.datagramsReceived() < 3 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        collector.stopCollection();
+        EXPECT_EQ(recorder->recorded(), 3u);
+        EXPECT_EQ(recorder->lost(), 0u);
+    }
+
+    CaptureReplayer replayer(fileName);
+    EXPECT_EQ(replayer.datagrams(), 3u);
+    EXPECT_LE(replayer.firstTimestamp(), replayer.lastTimestamp());
+
+    DataCollector collector("udp://127.0.0.1:0");
+    EXPECT_EQ(replayer.replay(collector), 3u);
+    EXPECT_EQ(collector.datagramsReceived(), 3u);
+
+    DataProcessor processor;
+    TickBatch batch;
+    ASSERT_EQ(processor.drain(collector.ticks(), batch), 3u);
+    EXPECT_EQ(batch.instrumentIds()[0], 5u);
+    EXPECT_DOUBLE_EQ(batch.tradePrices()[2], 103.0);
+    EXPECT_EQ(batch.receiveTimestamps()[0], replayer.firstTimestamp());
+    std::remove(fileName.c_str());
+}
+
+// Test to ensure that a timed replay keeps the recorded gaps, scaled by the speed multiplier.
+TEST(MarketCaptureTests, ReplayKeepsInterArrivalTiming) {
+    const std::string fileName = "test_timed_capture.bin";
+    std::remove(fileName.c_str());
+    {
+        CaptureRecorder recorder(fileName);
+        const std::vector<std::uint8_t> packet = tradePacket(1, 1, 100);
+        for (std::int64_t i = 0; i < 5; ++i) {
+            recorder.record(packet.data(), packet.size(), 1'000'000'000 + i * 20'000'000, i % 2);
+        }
+    }
+
+    CaptureReplayer replayer(fileName);
+    ASSERT_EQ(replayer.datagrams(), 5u);
+    EXPECT_EQ(replayer.lastTimestamp() - replayer.firstTimestamp(), 80'000'000);
+
+    std::vector<std::chrono::steady_clock::time_point> arrivals;
+    std::vector<std::size_t> legs;
+    auto sink = [&](const std::uint8_t*, std::size_t, std::int64_t, std::size_t leg) {
+        arrivals.push_back(std::chrono::steady_clock::now());
+        legs.push_back(leg);
+    };
+
+    EXPECT_EQ(replayer.replay(sink, 1.0), 5u);
+    EXPECT_GE(arrivals.back() - arrivals.front(), std::chrono::milliseconds(80));
+    EXPECT_EQ(legs, (std::vector<std::size_t>{0, 1, 0, 1, 0}));
+
+    arrivals.clear();
+    replayer.replay(sink, 4.0);
+    EXPECT_GE(arrivals.back() - arrivals.front(), std::chrono::milliseconds(20));
+    EXPECT_LT(arrivals.back() - arrivals.front(), std::chrono::milliseconds(80));
+
+    arrivals.clear();
+    replayer.replay(sink);
+    EXPECT_LT(arrivals.back() - arrivals.front(), std::chrono::milliseconds(20));
+    std::remove(fileName.c_str());
+}
+
+// Test to ensure that recording appends to an existing capture and that a truncated last record is ignored.
+TEST(MarketCaptureTests, AppendsAndIgnoresTruncatedRecord) {
+    const std::string fileName = "test_append_capture.bin";
+    std::remove(fileName.c_str());
+    const std::vector<std::uint8_t> packet = tradePacket(1, 1, 100);
+    for (int session = 0; session < 2; ++session) {
+        CaptureRecorder recorder(fileName);
+        recorder.record(packet.data(), packet.size(), session, 0);
+        recorder.flush();
+        EXPECT_EQ(recorder.recorded(), 1u);
+    }
+    EXPECT_EQ(CaptureReplayer(fileName).datagrams(), 2u);
+
+    // A record header promising more bytes than the file holds, as left by a crash mid-write.
+    {
+        std::ofstream file(fileName, std::ios::binary | std::ios::app);
+        const capture::RecordHeader header{2, 1000, 0, 0};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write("abc", 3);
+    }
+    CaptureReplayer replayer(fileName);
+    EXPECT_EQ(replayer.datagrams(), 2u);
+    EXPECT_EQ(replayer.lastTimestamp(), 1);
+    std::remove(fileName.c_str());
+}
+
+// Test to ensure that records spanning several write buffers all reach the file or are counted as lost,
+// in the order they were recorded.
+TEST(MarketCaptureTests, WritesFullBuffersInOrder) {
+    const std::string fileName = "test_buffered_capture.bin";
+    std::remove(fileName.c_str());
+    const std::vector<std::uint8_t> datagram(1400, 0x5a);
+    const std::int64_t total = 4 * config::CAPTURE_WRITE_BUFFER / 1400;
+    {
+        CaptureRecorder recorder(fileName);
+        for (std::int64_t i = 0; i < total; ++i) {
+            recorder.record(datagram.data(), datagram.size(), i, 0);
+        }
+        recorder.flush();
+        EXPECT_EQ(recorder.recorded() + recorder.lost(), static_cast<std::uint64_t>(total));
+        EXPECT_GT(recorder.recorded(), 0u);
+
+        std::int64_t previous = -1;
+        bool ordered = true;
+        CaptureReplayer replayer(fileName);
+        EXPECT_EQ(replayer.datagrams(), recorder.recorded());
+        replayer.replay([&](const std::uint8_t*, std::size_t size, std::int64_t timestamp, std::size_t) {
+            ordered = ordered && size == datagram.size() && timestamp > previous;
+            previous = timestamp;
+        });
+        EXPECT_TRUE(ordered);
+    }
+    std::remove(fileName.c_str());
+}
+
+// Test to ensure that files that are not captures are refused.
+TEST(MarketCaptureTests, RejectsForeignFiles) {
+    const std::string fileName = "test_not_a_capture.bin";
+    {
+        std::ofstream file(fileName);
+        file << "timestamp,price\n1,100\n";
+    }
+    EXPECT_THROW(CaptureReplayer replayer(fileName), std::runtime_error);
+    EXPECT_THROW(CaptureRecorder recorder(fileName), std::runtime_error);
+    EXPECT_THROW(CaptureReplayer replayer("missing_capture.bin"), std::runtime_error);
+    std::remove(fileName.c_str());
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "multicast_ring.h"
+
+// Test to ensure that every consumer sees every value in order, whatever the wait strategy, while the
+// producer wraps around a small ring in claimed batches.
+TEST(MulticastRingTests, EveryConsumerSeesEveryValue) {
+    for (WaitStrategy wait : {WaitStrategy::BusySpin, WaitStrategy::Yield, WaitStrategy::Block}) {
+        MulticastRing<int> ring(64, wait);
+        constexpr int kValues = 2048;
+        constexpr std::size_t kBatch = 4;
+
+        std::vector<std::size_t> consumers;
+        for (int i = 0; i < 3; ++i) {
+            consumers.push_back(ring.addConsumer());
+        }
+        std::vector<long long> sums(consumers.size(), 0);
+        std::vector<int> errors(consumers.size(), 0);
+        std::vector<std::thread> threads;
+        for (std::size_t c = 0; c < consumers.size(); ++c) {
+            threads.emplace_back([&, c] {
+                int expected = 0;
+                while (ring.consume(consumers[c], [&](const int& value, std::size_t sequence) {
+                    errors[c] += value != expected || sequence != static_cast<std::size_t>(expected);
+                    sums[c] += value;
+                    ++expected;
+                }) != 0) {
+                }
+            });
+        }
+
+        for (int value = 0; value < kValues; value += kBatch) {
+            const auto first = ring.claim(kBatch);
+            for (std::size_t i = 0; i < kBatch; ++i) {
+                ring.slot(first + i) = value + static_cast<int>(i);
+            }
+            ring.publish(first, kBatch);
+        }
+        ring.waitUntilConsumed();
+        ring.halt();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (std::size_t c = 0; c < consumers.size(); ++c) {
+            EXPECT_EQ(errors[c], 0);
+            EXPECT_EQ(sums[c], static_cast<long long>(kValues) * (kValues - 1) / 2);
+            EXPECT_EQ(ring.cursor(consumers[c]), static_cast<std::size_t>(kValues));
+        }
+    }
+}
+
+// Test to ensure that consumers read the producer's slot in place instead of a copy.
+TEST(MulticastRingTests, ConsumersReadSlotsInPlace) {
+    MulticastRing<std::vector<int>> ring(4);
+    const std::size_t first = ring.addConsumer();
+    const std::size_t second = ring.addConsumer();
+
+    const auto sequence = ring.claim();
+    ring.slot(sequence) = {1, 2, 3};
+    ring.publish(sequence, 1);
+
+    const std::vector<int>* seen[2] = {nullptr, nullptr};
+    EXPECT_EQ(ring.poll(first, [&](const std::vector<int>& value, std::size_t) { seen[0] = &value; }), 1u);
+    EXPECT_EQ(ring.poll(second, [&](const std::vector<int>& value, std::size_t) { seen[1] = &value; }), 1u);
+    EXPECT_EQ(seen[0], &ring.slot(sequence));
+    EXPECT_EQ(seen[1], &ring.slot(sequence));
+    EXPECT_EQ(ring.poll(first, [](const std::vector<int>&, std::size_t) {}), 0u);
+}
+
+// Test to ensure that the slowest consumer gates the producer, that removing it releases the producer,
+// and that a consumer added later starts at the next value.
+TEST(MulticastRingTests, SlowestConsumerGatesProducer) {
+    MulticastRing<int> ring(4, WaitStrategy::Yield);
+    const std::size_t fast = ring.addConsumer();
+    const std::size_t slow = ring.addConsumer();
+
+    MulticastRing<int>::Sequence first = 0;
+    ASSERT_TRUE(ring.tryClaim(4, first));
+    ring.publish(first, 4);
+    EXPECT_EQ(ring.poll(fast, [](const int&, std::size_t) {}), 4u);
+    EXPECT_FALSE(ring.tryClaim(1, first));  // The slow consumer still holds every slot
+
+    ring.removeConsumer(slow);
+    ASSERT_TRUE(ring.tryClaim(1, first));
+    ring.slot(first) = 42;
+    ring.publish(first, 1);
+
+    const std::size_t late = ring.addConsumer();
+    EXPECT_EQ(ring.cursor(late), 5u);
+    ASSERT_TRUE(ring.tryClaim(1, first));
+    ring.slot(first) = 43;
+    ring.publish(first, 1);
+
+    std::vector<int> values;
+    ring.poll(late, [&values](const int& value, std::size_t) { values.push_back(value); });
+    EXPECT_EQ(values, std::vector<int>{43});
+    EXPECT_EQ(ring.poll(fast, [](const int&, std::size_t) {}), 2u);
+}
+
+// Test to ensure that halting the ring wakes up a consumer blocked on an empty ring.
+TEST(MulticastRingTests, HaltWakesBlockedConsumers) {
+    MulticastRing<int> ring(8, WaitStrategy::Block);
+    const std::size_t consumer = ring.addConsumer();
+    std::thread thread([&] {
+        while (ring.consume(consumer, [](const int&, std::size_t) {}) != 0) {
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring.halt();
+    thread.join();
+    EXPECT_TRUE(ring.halted());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "sequence_tracker.h"
+
+// Test suite for the per-channel sequence tracker.
+// Every packet carries one byte per message, equal to the message's sequence number, so the
+// delivered stream can be checked directly.
+class SequenceTrackerTests : public ::testing::Test {
+protected:
+    SequenceTracker tracker{2, 100};  // Reordering window of 2 packets
+    std::vector<std::uint8_t> delivered;
+
+    // Delivery callback that appends the messages that were not delivered before.
+    auto deliver() {
+        return [this](const std::uint8_t* payload, std::size_t size, std::size_t skip, std::int64_t) {
+            delivered.insert(delivered.end(), payload + skip, payload + size);
+        };
+    }
+
+    // Send a packet of `count` messages starting at `sequence`.
+    void send(std::uint64_t sequence, std::uint16_t count) {
+        std::vector<std::uint8_t> payload;
+        for (std::uint16_t i = 0; i < count; ++i) {
+            payload.push_back(static_cast<std::uint8_t>(sequence + i));
+        }
+        tracker.onPacket(sequence, count, payload.data(), payload.size(), 0, deliver());
+    }
+};
+
+// Test to ensure that in-order packets are delivered and duplicates or overlaps are not delivered twice.
+TEST_F(SequenceTrackerTests, DropsDuplicatesAndOverlaps) {
+    send(1, 2);
+    send(3, 1);
+    send(1, 2);  // Duplicate
+    send(3, 3);  // Overlaps message 3
+    EXPECT_EQ(delivered, (std::vector<std::uint8_t>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(tracker.duplicates(), 1u);
+    EXPECT_EQ(tracker.expectedSequence(), 6u);
+}
+
+// Test to ensure that packets reordered within the window are delivered in sequence without a gap.
+TEST_F(SequenceTrackerTests, ReordersWithinWindow) {
+    send(1, 1);
+    send(3, 1);
+    send(4, 1);
+    EXPECT_EQ(tracker.bufferedPackets(), 2u);
+    send(2, 1);
+    EXPECT_EQ(delivered, (std::vector<std::uint8_t>{1, 2, 3, 4}));
+    EXPECT_FALSE(tracker.gapDetected());
+    EXPECT_EQ(tracker.gaps(), 0u);
+}
+
+// Test to ensure that a gap is detected and that packets received during recovery are replayed after the snapshot.
+TEST_F(SequenceTrackerTests, ReplaysBufferedPacketsAfterRecovery) {
+    send(1, 1);
+    send(4, 1);
+    send(5, 1);
+    EXPECT_FALSE(tracker.gapDetected());
+    send(6, 1);
+    ASSERT_TRUE(tracker.gapDetected());
+    EXPECT_EQ(tracker.gaps(), 1u);
+
+    tracker.beginRecovery();
+    send(7, 1);  // Live packet during recovery
+    EXPECT_EQ(delivered, (std::vector<std::uint8_t>{1}));
+
+    // The snapshot covers everything before 5; packet 4 is superseded by it.
+    tracker.completeRecovery(5, deliver());
+    EXPECT_EQ(delivered, (std::vector<std::uint8_t>{1, 5, 6, 7}));
+    EXPECT_EQ(tracker.bufferedPackets(), 0u);
+    EXPECT_FALSE(tracker.recovering());
+}
+
+// Test to ensure that a gap can be skipped, reporting the lost messages.
+TEST_F(SequenceTrackerTests, SkipsGap) {
+    send(1, 1);
+    send(5, 1);
+    send(6, 1);
+    send(7, 1);
+    ASSERT_TRUE(tracker.gapDetected());
+    EXPECT_EQ(tracker.skipGap(deliver()), 3u);
+    EXPECT_EQ(delivered, (std::vector<std::uint8_t>{1, 5, 6, 7}));
+    EXPECT_FALSE(tracker.gapDetected());
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "sharded_data_processor.h"
+
+// Test to ensure that instruments are partitioned across shards, that every shard sees its instruments'
+// ticks in their original order on its own thread, and that books and bars are kept per shard.
+TEST(ShardedDataProcessorTests, PartitionsInstrumentsAcrossShards) {
+    constexpr std::size_t kShards = 3;
+    constexpr InstrumentId kInstruments = 9;
+    constexpr int kTicksPerInstrument = 2000;
+
+    ShardedDataProcessor sharded(kShards, BarType::Tick, 100);
+    EXPECT_EQ(sharded.shardCount(), kShards);
+
+    // Per-shard state, written only by the shard's own thread
+    std::vector<std::vector<std::int64_t>> lastTimestamp(kShards, std::vector<std::int64_t>(kInstruments, 0));
+    std::vector<int> outOfOrder(kShards, 0);
+    std::vector<int> foreign(kShards, 0);
+    std::vector<std::size_t> bars(kShards, 0);
+    std::vector<std::thread::id> threads(kShards);
+
+    sharded.setBatchHandler([&](std::size_t shard, const TickBatch& batch) {
+        threads[shard] = std::this_thread::get_id();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            const InstrumentId id = batch.instrumentIds()[i];
+            foreign[shard] += sharded.shardOf(id) != shard;
+            outOfOrder[shard] += batch.timestamps()[i] <= lastTimestamp[shard][id];
+            lastTimestamp[shard][id] = batch.timestamps()[i];
+        }
+    });
+    sharded.setBarHandler([&](std::size_t shard, std::span<const Bar> completed) { bars[shard] += completed.size(); });
+
+    TickBatch batch;
+    for (int i = 1; i <= kTicksPerInstrument; ++i) {
+        for (InstrumentId id = 0; id < kInstruments; ++id) {
+            Tick tick;
+            tick.timestamp = i;
+            tick.instrumentId = id;
+            tick.bidPrice = 100.0;
+            tick.askPrice = 100.02;
+            tick.bidSize = 10;
+            tick.askSize = 10;
+            tick.tradePrice = 100.01;
+            tick.tradeQuantity = 1;
+            batch.append(tick);
+        }
+    }
+    sharded.process(batch);
+
+    std::uint64_t total = 0;
+    for (std::size_t shard = 0; shard < kShards; ++shard) {
+        EXPECT_EQ(outOfOrder[shard], 0);
+        EXPECT_EQ(foreign[shard], 0);
+        EXPECT_EQ(bars[shard], kInstruments / kShards * kTicksPerInstrument / 100);
+        EXPECT_NE(threads[shard], std::this_thread::get_id());
+        total += sharded.ticksProcessed(shard);
+    }
+    EXPECT_EQ(total, static_cast<std::uint64_t>(kInstruments) * kTicksPerInstrument);
+    for (InstrumentId id = 0; id < kInstruments; ++id) {
+        EXPECT_EQ(lastTimestamp[sharded.shardOf(id)][id], kTicksPerInstrument);
+        ASSERT_NE(sharded.book(id), nullptr);
+        EXPECT_EQ(sharded.book(id)->bestBid(), 10000);
+    }
+
+    EXPECT_THROW(ShardedDataProcessor(0), std::runtime_error);
+}
@@ -1,11 +1,15 @@
 #include <gtest/gtest.h>
 #include "logger.h"
+#include "tsc_clock.h"
+#include <cstdio>  // For std::remove
 #include <fstream>
 
 // Test to ensure that Logger can log messages to a file
 TEST(LoggerTests, CanLogToFile) {
-    // Create a logger that writes to "test_log.txt"
+    // Create a logger that writes to a fresh "test_log.txt"
+    std::remove("test_log.txt");
     Logger logger("test_log.txt");
+    const std::int64_t before = TscClock::now();
 
     // Log a message to the file
     logger.log("Test message");
@@ -16,6 +20,11 @@ TEST(LoggerTests, CanLogToFile) {
     std::getline(logFile, line);  // Read the first line from the file
     logFile.close();  // Close the file after reading
 
-    // Verify that the message logged to the file is the expected one
-    EXPECT_EQ(line, "Test message");
+    // Verify that the message logged to the file is the expected one, after its timestamp
+    const std::size_t space = line.find(' ');
+    ASSERT_NE(space, std::string::npos);
+    EXPECT_EQ(line.substr(space + 1), "Test message");
+    const std::int64_t timestamp = std::stoll(line.substr(0, space));
+    EXPECT_GE(timestamp, before);
+    EXPECT_LE(timestamp, TscClock::now());
 }
@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+#include "monitor.h"
+
+// Test to ensure that the Monitor keeps metrics per instrument id.
+TEST(MonitorTests, TracksInstrumentMetrics) {
+    Monitor monitor;
+    monitor.setInstrumentMetric(3, InstrumentMetric::Position, 100.0);
+    monitor.addInstrumentMetric(3, InstrumentMetric::Orders, 1.0);
+    monitor.addInstrumentMetric(3, InstrumentMetric::Orders, 1.0);
+
+    EXPECT_DOUBLE_EQ(monitor.instrumentMetric(3, InstrumentMetric::Position), 100.0);
+    EXPECT_DOUBLE_EQ(monitor.instrumentMetric(3, InstrumentMetric::Orders), 2.0);
+    EXPECT_DOUBLE_EQ(monitor.instrumentMetric(7, InstrumentMetric::Pnl), 0.0);
+    EXPECT_NO_THROW(monitor.reportMetrics());
+}
+
+// Test to ensure that metrics of invalid instrument ids are ignored.
+TEST(MonitorTests, IgnoresInvalidInstruments) {
+    Monitor monitor;
+    monitor.setInstrumentMetric(kInvalidInstrument, InstrumentMetric::Position, 100.0);
+    monitor.addInstrumentMetric(InstrumentId{config::MAX_INSTRUMENTS}, InstrumentMetric::Orders, 1.0);
+    EXPECT_DOUBLE_EQ(monitor.instrumentMetric(kInvalidInstrument, InstrumentMetric::Position), 0.0);
+    EXPECT_DOUBLE_EQ(monitor.instrumentMetric(InstrumentId{config::MAX_INSTRUMENTS}, InstrumentMetric::Orders), 0.0);
+}
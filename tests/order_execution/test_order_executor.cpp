@@ -19,3 +19,18 @@ TEST(OrderExecutorTests, CanCheckOrderStatus) {
     int orderId = 1;
     EXPECT_TRUE(executor.checkOrderStatus(orderId));
 }
+
+// Test to ensure that orders by instrument id only move the position when they are actually sent
+TEST(OrderExecutorTests, TracksPositionsByInstrumentId) {
+    OrderExecutor executor("http://fake.exchange");
+
+    // The fake exchange cannot be reached, so nothing is sent and no position is taken
+    EXPECT_FALSE(executor.sendOrder(InstrumentId{2}, 100, 10.5));
+    EXPECT_FALSE(executor.sendOrder(InstrumentId{2}, 0, 10.5));
+    EXPECT_EQ(executor.position(2), 0);
+    EXPECT_EQ(executor.position(99), 0);
+
+    // Ids the registry never hands out are refused
+    EXPECT_FALSE(executor.sendOrder(kInvalidInstrument, 100, 10.5));
+    EXPECT_EQ(executor.position(kInvalidInstrument), 0);
+}
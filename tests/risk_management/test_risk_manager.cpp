@@ -29,3 +29,38 @@ TEST(RiskManagerTests, CanEvaluateRisk) {
     // Test that assessing risk returns true (i.e., risk is within acceptable limits)
     EXPECT_TRUE(riskManager.assessRisk());
 }
+
+// Test to ensure that risk strategies aggregate per-instrument updates indexed by instrument id
+TEST(RiskManagerTests, EvaluatesPerInstrumentRisk) {
+    ExposureLimitRiskStrategy exposure(1000.0);
+    exposure.updateExposure(InstrumentId{0}, 600.0);
+    exposure.updateExposure(InstrumentId{5}, -300.0);
+    EXPECT_TRUE(exposure.evaluateRisk());
+    exposure.updateExposure(InstrumentId{5}, -500.0);  // |600| + |-500| exceeds the limit
+    EXPECT_FALSE(exposure.evaluateRisk());
+    EXPECT_DOUBLE_EQ(exposure.exposure(5), -500.0);
+    EXPECT_DOUBLE_EQ(exposure.instrumentTotal(), 1100.0);
+
+    // The system exposure and the instrument total are checked separately and do not overwrite each other
+    exposure.updateExposure(0.0);
+    EXPECT_FALSE(exposure.evaluateRisk());
+    exposure.updateExposure(InstrumentId{5}, 0.0);
+    EXPECT_TRUE(exposure.evaluateRisk());
+    exposure.updateExposure(2000.0);
+    EXPECT_FALSE(exposure.evaluateRisk());
+    EXPECT_DOUBLE_EQ(exposure.instrumentTotal(), 600.0);
+    exposure.updateExposure(0.0);
+
+    MaxDrawdownRiskStrategy drawdown(0.2);
+    drawdown.updateDrawdown(InstrumentId{1}, 0.3);
+    EXPECT_FALSE(drawdown.evaluateRisk());
+    drawdown.updateDrawdown(InstrumentId{1}, 0.1);
+    EXPECT_TRUE(drawdown.evaluateRisk());
+
+    // Invalid ids are ignored instead of growing the per-instrument arrays
+    exposure.updateExposure(kInvalidInstrument, 1.0);
+    exposure.updateExposure(InstrumentId{config::MAX_INSTRUMENTS}, 1.0);
+    EXPECT_DOUBLE_EQ(exposure.exposure(kInvalidInstrument), 0.0);
+    drawdown.updateDrawdown(kInvalidInstrument, 0.5);
+    EXPECT_TRUE(drawdown.evaluateRisk());
+}
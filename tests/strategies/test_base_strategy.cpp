@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "base_strategy.h"
+
+namespace {
+
+// Strategy that records the events it receives and sends an order on every trade.
+class EventStrategy : public BaseStrategy {
+public:
+    void execute() override { ++executions; }
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+
+    void onBookUpdate(const BookUpdate& update) override { updates.push_back(update); }
+
+    void onTrade(const Trade& trade) override {
+        trades.push_back(trade);
+        OrderIntent intent;
+        intent.instrumentId = trade.instrumentId;
+        intent.quantity = -trade.quantity;
+        intent.price = trade.price;
+        intent.tickSize = trade.tickSize;
+        intent.triggerTimestamp = trade.receiveTimestamp;
+        sent += submitOrder(intent);
+    }
+
+    std::vector<BookUpdate> updates;
+    std::vector<Trade> trades;
+    int executions = 0;
+    int sent = 0;
+};
+
+// Strategy that only implements execute().
+class LegacyStrategy : public BaseStrategy {
+public:
+    void execute() override { ++executions; }
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+
+    int executions = 0;
+};
+
+} // namespace
+
+// Test to ensure that every row becomes a book update, trade rows also a trade, with prices in ticks of
+// the instrument.
+TEST(BaseStrategyTests, DeliversRowsAsTypedEvents) {
+    InstrumentRegistry registry;
+    registry.add({"AAA", 0.01, 1});
+    registry.add({"BBB", 0.5, 1});
+    EventStrategy strategy;
+    strategy.setInstruments(registry);
+
+    TickBatch batch;
+    Tick quote;
+    quote.timestamp = 10;
+    quote.instrumentId = 1;
+    quote.bidPrice = 99.5;
+    quote.askPrice = 100.0;
+    quote.bidSize = 3;
+    quote.askSize = 4;
+    batch.append(quote);
+    Tick trade;
+    trade.timestamp = 20;
+    trade.receiveTimestamp = 25;
+    trade.instrumentId = 0;
+    trade.bidPrice = 10.01;
+    trade.askPrice = 10.03;
+    trade.tradePrice = 10.02;
+    trade.tradeQuantity = 7;
+    batch.append(trade);
+    strategy.onBatch(batch);
+
+    ASSERT_EQ(strategy.updates.size(), 2u);
+    EXPECT_EQ(strategy.updates[0].bidPrice, 199);
+    EXPECT_EQ(strategy.updates[0].askPrice, 200);
+    EXPECT_EQ(strategy.updates[0].askSize, 4);
+    EXPECT_DOUBLE_EQ(strategy.updates[0].tickSize, 0.5);
+    EXPECT_EQ(strategy.updates[1].bidPrice, 1001);
+    ASSERT_EQ(strategy.trades.size(), 1u);
+    EXPECT_EQ(strategy.trades[0].price, 1002);
+    EXPECT_EQ(strategy.trades[0].quantity, 7);
+    EXPECT_EQ(strategy.trades[0].receiveTimestamp, 25);
+    EXPECT_EQ(strategy.sent, 0);  // No channel connected
+    EXPECT_EQ(strategy.executions, 0);
+}
+
+// Test to ensure that strategies that only implement execute() still run once per tick.
+TEST(BaseStrategyTests, DefaultBookUpdateExecutes) {
+    LegacyStrategy strategy;
+    TickBatch batch;
+    batch.resize(3);
+    strategy.onBatch(batch);
+    EXPECT_EQ(strategy.executions, 3);
+}
+
+// Test to ensure that orders go through the channel with increasing ids, that a full channel rejects
+// them, and that fills come back.
+TEST(BaseStrategyTests, SubmitsOrdersThroughChannel) {
+    OrderChannel channel(2);
+    EventStrategy strategy;
+    strategy.setOrderChannel(&channel);
+
+    TickBatch batch;
+    Tick tick;
+    tick.tradePrice = 1.0;
+    tick.tradeQuantity = 5;
+    for (int i = 0; i < 3; ++i) {
+        batch.append(tick);
+    }
+    strategy.onBatch(batch);
+    EXPECT_EQ(strategy.sent, 2);
+    EXPECT_EQ(channel.rejected(), 1u);
+
+    std::vector<OrderIntent> intents;
+    EXPECT_EQ(channel.drainIntents([&intents](const OrderIntent& intent) { intents.push_back(intent); }), 2u);
+    ASSERT_EQ(intents.size(), 2u);
+    EXPECT_EQ(intents[0].orderId, 1u);
+    EXPECT_EQ(intents[1].orderId, 2u);
+    EXPECT_EQ(intents[0].quantity, -5);
+    EXPECT_EQ(intents[0].price, 100);
+
+    Fill fill;
+    fill.orderId = intents[1].orderId;
+    EXPECT_TRUE(channel.reportFill(fill));
+    std::uint64_t filled = 0;
+    EXPECT_EQ(channel.deliverFills([&filled](const Fill& f) { filled = f.orderId; }), 1u);
+    EXPECT_EQ(filled, 2u);
+}
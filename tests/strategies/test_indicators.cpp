@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "indicators.h"
+
+namespace {
+
+// Price series long enough to cross several blocks of the batch functions.
+std::vector<double> makePrices(std::size_t rows) {
+    std::vector<double> prices;
+    for (std::size_t i = 0; i < rows; ++i) {
+        prices.push_back(100.0 + std::sin(static_cast<double>(i) * 0.05) * 2.0 + static_cast<double>(i % 11) * 0.01);
+    }
+    return prices;
+}
+
+// Compare two series row by row, NaN matching NaN.
+void expectSeriesNear(const std::vector<double>& actual, const std::vector<double>& expected, double tolerance) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        if (std::isnan(expected[i])) {
+            EXPECT_TRUE(std::isnan(actual[i])) << "row " << i;
+        } else {
+            EXPECT_NEAR(actual[i], expected[i], tolerance) << "row " << i;
+        }
+    }
+}
+
+// Run a test body once with each instruction set, restoring the default afterwards.
+template <typename Body>
+void forEachSimdLevel(Body&& body) {
+    const indicators::SimdLevel saved = indicators::simdLevel();
+    for (indicators::SimdLevel level : {indicators::SimdLevel::Scalar, indicators::SimdLevel::Avx2}) {
+        indicators::setSimdLevel(level);
+        body();
+    }
+    indicators::setSimdLevel(saved);
+}
+
+} // namespace
+
+// Test to ensure that the batch SMA matches the incremental one, with NaN before the first full window.
+TEST(IndicatorsTests, SmaMatchesIncremental) {
+    const std::vector<double> prices = makePrices(10007);
+    indicators::Sma sma(20);
+    std::vector<double> expected;
+    for (double price : prices) {
+        expected.push_back(sma.update(price));
+    }
+    EXPECT_TRUE(std::isnan(expected[18]));
+
+    forEachSimdLevel([&] {
+        std::vector<double> out(prices.size());
+        indicators::sma(prices, 20, out);
+        expectSeriesNear(out, expected, 1e-9);
+    });
+}
+
+// Test to ensure that the batch EMA matches the incremental one.
+TEST(IndicatorsTests, EmaMatchesIncremental) {
+    const std::vector<double> prices = makePrices(10007);
+    indicators::Ema ema(indicators::emaAlpha(10));
+    std::vector<double> expected;
+    for (double price : prices) {
+        expected.push_back(ema.update(price));
+    }
+
+    forEachSimdLevel([&] {
+        std::vector<double> out(prices.size());
+        indicators::ema(prices, indicators::emaAlpha(10), out);
+        expectSeriesNear(out, expected, 1e-9);
+    });
+}
+
+// Test to ensure that VWAP weighs prices by quantity and ignores quote rows without a trade.
+TEST(IndicatorsTests, VwapSkipsQuoteRows) {
+    const std::vector<double> prices = makePrices(10007);
+    std::vector<std::int64_t> quantities;
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        quantities.push_back(i % 3 == 0 ? 0 : static_cast<std::int64_t>(i % 5) + 1);
+    }
+    quantities[100] = quantities[101] = quantities[102] = quantities[103] = 0;  // A window without trades
+
+    indicators::Vwap vwap(4);
+    std::vector<double> expected;
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        expected.push_back(vwap.update(prices[i], quantities[i]));
+    }
+    EXPECT_TRUE(std::isnan(expected[103]));
+    EXPECT_NEAR(expected[5], (prices[2] * 3 + prices[4] * 5 + prices[5] * 1) / 9.0, 1e-12);  // Rows 2 to 5
+
+    forEachSimdLevel([&] {
+        std::vector<double> out(prices.size());
+        indicators::vwap(prices, quantities, 4, out);
+        expectSeriesNear(out, expected, 1e-9);
+    });
+}
+
+// Test to ensure that the batch Bollinger bands match the incremental ones.
+TEST(IndicatorsTests, BollingerMatchesIncremental) {
+    const std::vector<double> prices = makePrices(10007);
+    indicators::Bollinger bands(20, 2.0);
+    std::vector<double> middle;
+    std::vector<double> upper;
+    std::vector<double> lower;
+    for (double price : prices) {
+        bands.update(price);
+        middle.push_back(bands.middle());
+        upper.push_back(bands.upper());
+        lower.push_back(bands.lower());
+    }
+
+    forEachSimdLevel([&] {
+        std::vector<double> outMiddle(prices.size());
+        std::vector<double> outUpper(prices.size());
+        std::vector<double> outLower(prices.size());
+        indicators::bollinger(prices, 20, 2.0, outMiddle, outUpper, outLower);
+        expectSeriesNear(outMiddle, middle, 1e-9);
+        expectSeriesNear(outUpper, upper, 1e-7);
+        expectSeriesNear(outLower, lower, 1e-7);
+    });
+}
+
+// Test to ensure that the batch Bollinger bands stay accurate when prices drift far from the first row.
+TEST(IndicatorsTests, BollingerStaysAccurateOnDriftingPrices) {
+    std::vector<double> prices;
+    for (std::size_t i = 0; i < 100000; ++i) {
+        prices.push_back(1.0 + static_cast<double>(i) * 100.0 + static_cast<double>(i % 7) * 0.001);
+    }
+    const std::size_t window = 20;
+
+    forEachSimdLevel([&] {
+        std::vector<double> middle(prices.size());
+        std::vector<double> upper(prices.size());
+        std::vector<double> lower(prices.size());
+        indicators::bollinger(prices, window, 2.0, middle, upper, lower);
+        for (std::size_t row : {std::size_t{window - 1}, std::size_t{50000}, prices.size() - 1}) {
+            double mean = 0.0;
+            for (std::size_t i = row + 1 - window; i <= row; ++i) {
+                mean += prices[i] / static_cast<double>(window);
+            }
+            double squares = 0.0;
+            for (std::size_t i = row + 1 - window; i <= row; ++i) {
+                squares += (prices[i] - mean) * (prices[i] - mean);
+            }
+            const double band = 2.0 * std::sqrt(squares / static_cast<double>(window - 1));
+            EXPECT_NEAR(upper[row] - middle[row], band, band * 1e-9) << "row " << row;
+            EXPECT_NEAR(middle[row] - lower[row], band, band * 1e-9) << "row " << row;
+        }
+    });
+}
+
+// Test to ensure that the batch RSI matches the incremental one and stays within 0 to 100.
+TEST(IndicatorsTests, RsiMatchesIncremental) {
+    const std::vector<double> prices = makePrices(10007);
+    indicators::Rsi rsi(14);
+    std::vector<double> expected;
+    for (double price : prices) {
+        expected.push_back(rsi.update(price));
+    }
+    EXPECT_TRUE(std::isnan(expected[13]));
+    EXPECT_FALSE(std::isnan(expected[14]));
+
+    forEachSimdLevel([&] {
+        std::vector<double> out(prices.size());
+        indicators::rsi(prices, 14, out);
+        expectSeriesNear(out, expected, 1e-9);
+        for (std::size_t i = 14; i < out.size(); ++i) {
+            ASSERT_GE(out[i], 0.0);
+            ASSERT_LE(out[i], 100.0);
+        }
+    });
+}
+
+// Test to ensure that the rolling minimum and maximum match the incremental ones for several windows.
+TEST(IndicatorsTests, RollingExtremaMatchIncremental) {
+    const std::vector<double> prices = makePrices(1003);
+    for (std::size_t window : {1u, 7u, 64u, 2000u}) {
+        indicators::RollingMin rollingMin(window);
+        indicators::RollingMax rollingMax(window);
+        std::vector<double> minimums;
+        std::vector<double> maximums;
+        for (double price : prices) {
+            minimums.push_back(rollingMin.update(price));
+            maximums.push_back(rollingMax.update(price));
+        }
+
+        forEachSimdLevel([&] {
+            std::vector<double> out(prices.size());
+            indicators::rollingMin(prices, window, out);
+            expectSeriesNear(out, minimums, 0.0);
+            indicators::rollingMax(prices, window, out);
+            expectSeriesNear(out, maximums, 0.0);
+        });
+    }
+
+    indicators::RollingMax rollingMax(3);
+    rollingMax.update(1.0);
+    rollingMax.update(5.0);
+    EXPECT_DOUBLE_EQ(rollingMax.update(2.0), 5.0);
+    EXPECT_DOUBLE_EQ(rollingMax.update(3.0), 5.0);
+    EXPECT_DOUBLE_EQ(rollingMax.update(1.0), 3.0);  // 5.0 leaves the window
+}
+
+// Test to ensure that an instruction set the CPU lacks is never selected.
+TEST(IndicatorsTests, SelectsSupportedSimdLevel) {
+    const indicators::SimdLevel saved = indicators::simdLevel();
+    EXPECT_EQ(indicators::setSimdLevel(indicators::SimdLevel::Scalar), indicators::SimdLevel::Scalar);
+    EXPECT_EQ(indicators::simdLevel(), indicators::SimdLevel::Scalar);
+    const indicators::SimdLevel selected = indicators::setSimdLevel(indicators::SimdLevel::Avx2);
+    EXPECT_EQ(indicators::simdLevel(), selected);
+    indicators::setSimdLevel(saved);
+}
+
+// Test to ensure that invalid windows and short outputs are rejected.
+TEST(IndicatorsTests, RejectsInvalidArguments) {
+    const std::vector<double> prices = makePrices(10);
+    std::vector<double> out(prices.size());
+    std::vector<double> shortOut(prices.size() - 1);
+    EXPECT_THROW(indicators::sma(prices, 0, out), std::runtime_error);
+    EXPECT_THROW(indicators::sma(prices, 3, shortOut), std::runtime_error);
+    EXPECT_THROW(indicators::ema(prices, 0.0, out), std::runtime_error);
+    EXPECT_THROW(indicators::rsi(prices, 0, out), std::runtime_error);
+    EXPECT_THROW(indicators::rollingMax(prices, 0, out), std::runtime_error);
+    EXPECT_THROW(indicators::Vwap(0), std::runtime_error);
+    EXPECT_THROW(indicators::Rsi(0), std::runtime_error);
+    EXPECT_THROW(indicators::RollingMin(0), std::runtime_error);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "mean_reversion_strategy.h"
+
+// Test to ensure that the mean price is the moving average of the last bar closes of each instrument.
+TEST(MeanReversionStrategyTests, TracksMeanOfBarCloses) {
+    MeanReversionStrategy strategy;
+    const int period = config::MEAN_REVERSION_STRATEGY_PERIOD;
+
+    Bar bar;
+    bar.instrumentId = 2;
+    for (int i = 0; i < period - 1; ++i) {
+        bar.close = 50.0;
+        strategy.onBar(bar);
+    }
+    EXPECT_DOUBLE_EQ(strategy.meanPrice(2), 100.0);  // Default until the window is full
+
+    bar.close = 50.0;
+    strategy.onBar(bar);
+    EXPECT_DOUBLE_EQ(strategy.meanPrice(2), 50.0);
+
+    // One more bar pushes the oldest close out of the window
+    bar.close = 50.0 + period;
+    strategy.onBar(bar);
+    EXPECT_DOUBLE_EQ(strategy.meanPrice(2), 51.0);
+    EXPECT_DOUBLE_EQ(strategy.meanPrice(0), 100.0);
+
+    // Bars of invalid instrument ids are ignored
+    bar.instrumentId = kInvalidInstrument;
+    strategy.onBar(bar);
+    EXPECT_DOUBLE_EQ(strategy.meanPrice(kInvalidInstrument), 100.0);
+}
+
+// Test to ensure that the strategy sells when the mid price is far above the mean, buys back when it
+// reverts, and keeps its position in between.
+TEST(MeanReversionStrategyTests, TradesOnZScore) {
+    OrderChannel channel;
+    MeanReversionStrategy strategy;
+    strategy.setOrderChannel(&channel);
+
+    Bar bar;
+    bar.instrumentId = 1;
+    for (int i = 0; i < config::MEAN_REVERSION_STRATEGY_PERIOD; ++i) {
+        bar.close = i % 2 == 0 ? 99.0 : 101.0;
+        strategy.onBar(bar);
+    }
+    EXPECT_DOUBLE_EQ(strategy.meanPrice(1), 100.0);
+
+    BookUpdate update;
+    update.instrumentId = 1;
+    update.tickSize = 0.01;
+    auto quote = [&](PriceTicks bid, PriceTicks ask) {
+        update.bidPrice = bid;
+        update.askPrice = ask;
+        strategy.onBookUpdate(update);
+    };
+    std::vector<OrderIntent> intents;
+    auto route = [&] {
+        channel.route([&intents](const OrderIntent& intent) {
+            intents.push_back(intent);
+            return true;
+        });
+        channel.deliverFills([&strategy](const Fill& fill) { strategy.onFill(fill); });
+    };
+
+    quote(10499, 10501);  // z is about 4.9: sell at the bid
+    quote(10399, 10401);  // Still beyond the exit threshold: no new order
+    route();
+    ASSERT_EQ(intents.size(), 1u);
+    EXPECT_EQ(intents[0].quantity, -config::MEAN_REVERSION_ORDER_QUANTITY);
+    EXPECT_EQ(intents[0].price, 10499);
+    EXPECT_EQ(strategy.position(1), -config::MEAN_REVERSION_ORDER_QUANTITY);
+
+    quote(9999, 10001);  // Back at the mean: buy back at the ask
+    route();
+    ASSERT_EQ(intents.size(), 2u);
+    EXPECT_EQ(intents[1].quantity, config::MEAN_REVERSION_ORDER_QUANTITY);
+    EXPECT_EQ(intents[1].price, 10001);
+    EXPECT_EQ(strategy.position(1), 0);
+    EXPECT_EQ(strategy.analyzeResults(), "Mean reversion strategy executed 2 trades.");
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "rolling_stats.h"
+
+// Test to ensure that the statistics cover exactly the last `window` values.
+TEST(RollingStatsTests, TracksWindowMeanAndVariance) {
+    RollingStats stats(4);
+    EXPECT_DOUBLE_EQ(stats.mean(), 0.0);
+    EXPECT_DOUBLE_EQ(stats.variance(), 0.0);
+
+    for (double value : {1.0, 2.0, 3.0}) {
+        stats.add(value);
+    }
+    EXPECT_FALSE(stats.full());
+    EXPECT_DOUBLE_EQ(stats.mean(), 2.0);
+    EXPECT_DOUBLE_EQ(stats.variance(), 1.0);
+
+    stats.add(4.0);
+    stats.add(9.0);  // 1.0 leaves the window
+    EXPECT_TRUE(stats.full());
+    EXPECT_EQ(stats.count(), 4u);
+    EXPECT_DOUBLE_EQ(stats.mean(), 4.5);
+    EXPECT_NEAR(stats.variance(), 29.0 / 3.0, 1e-12);
+    EXPECT_NEAR(stats.zScore(4.5 + stats.stddev() * 2.0), 2.0, 1e-12);
+}
+
+// Test to ensure that the sliding updates agree with a direct computation over a long, offset series.
+TEST(RollingStatsTests, MatchesDirectComputation) {
+    constexpr std::size_t kWindow = 20;
+    RollingStats stats(kWindow);
+    std::vector<double> values;
+    for (int i = 0; i < 100000; ++i) {
+        values.push_back(1.0e6 + std::sin(i * 0.1) * 3.0 + (i % 7) * 0.01);
+        stats.add(values.back());
+    }
+
+    double sum = 0.0;
+    for (std::size_t i = values.size() - kWindow; i < values.size(); ++i) {
+        sum += values[i];
+    }
+    const double mean = sum / kWindow;
+    double m2 = 0.0;
+    for (std::size_t i = values.size() - kWindow; i < values.size(); ++i) {
+        m2 += (values[i] - mean) * (values[i] - mean);
+    }
+    EXPECT_NEAR(stats.mean(), mean, 1e-6);
+    EXPECT_NEAR(stats.variance(), m2 / (kWindow - 1), 1e-6);
+}
+
+// Test to ensure that the EWMA starts at the first value and moves by its weight.
+TEST(RollingStatsTests, ComputesEwma) {
+    RollingStats stats(3, 0.5);
+    stats.add(10.0);
+    EXPECT_DOUBLE_EQ(stats.ewma(), 10.0);
+    stats.add(20.0);
+    EXPECT_DOUBLE_EQ(stats.ewma(), 15.0);
+    stats.reset();
+    EXPECT_EQ(stats.count(), 0u);
+    stats.add(4.0);
+    EXPECT_DOUBLE_EQ(stats.ewma(), 4.0);
+    EXPECT_THROW(RollingStats(0), std::runtime_error);
+}
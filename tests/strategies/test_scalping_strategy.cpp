@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
 #include "scalping_strategy.h"
 
 // Test to ensure that the ScalpingStrategy can be configured without throwing exceptions
@@ -21,3 +23,94 @@ TEST(ScalpingStrategyTests, CanExecuteStrategy) {
     // Test that the strategy reports 1 trade executed
     EXPECT_EQ(strategy.analyzeResults(), "Scalping strategy executed 1 trades.");
 }
+
+namespace {
+
+// Top of book with prices in ticks.
+BookUpdate book(PriceTicks bid, PriceTicks ask, std::int64_t bidSize, std::int64_t askSize) {
+    BookUpdate update;
+    update.instrumentId = 3;
+    update.bidPrice = bid;
+    update.askPrice = ask;
+    update.bidSize = bidSize;
+    update.askSize = askSize;
+    update.tickSize = 0.01;
+    return update;
+}
+
+// Collects the orders of a strategy and fills them all.
+std::vector<OrderIntent> fillAll(OrderChannel& channel, ScalpingStrategy& strategy) {
+    std::vector<OrderIntent> intents;
+    channel.route([&intents](const OrderIntent& intent) {
+        intents.push_back(intent);
+        return true;
+    });
+    channel.deliverFills([&strategy](const Fill& fill) { strategy.onFill(fill); });
+    return intents;
+}
+
+} // namespace
+
+// Test to ensure that the configuration is read, and that bad settings are rejected.
+TEST(ScalpingStrategyTests, ReadsConfiguration) {
+    ScalpingStrategy strategy;
+    EXPECT_NO_THROW(strategy.configure("spread=1, imbalance=50;take_profit=4 stop_loss=2 quantity=5"));
+    EXPECT_THROW(strategy.configure("spread=1.5"), std::runtime_error);
+    EXPECT_THROW(strategy.configure("imbalance=-3"), std::runtime_error);
+    EXPECT_THROW(strategy.configure("leverage=10"), std::runtime_error);
+
+    OrderChannel channel;
+    strategy.setOrderChannel(&channel);
+    strategy.onBookUpdate(book(1000, 1002, 90, 10));  // Spread of 2 is above the configured 1
+    EXPECT_TRUE(fillAll(channel, strategy).empty());
+    strategy.onBookUpdate(book(1000, 1001, 75, 25));  // Imbalance of exactly 50%
+    const auto intents = fillAll(channel, strategy);
+    ASSERT_EQ(intents.size(), 1u);
+    EXPECT_EQ(intents[0].quantity, 5);
+}
+
+// Test to ensure that the strategy enters on the heavy side of a tight book and exits on take profit,
+// stop loss or a reversed imbalance.
+TEST(ScalpingStrategyTests, TradesTopOfBookInTicks) {
+    OrderChannel channel;
+    ScalpingStrategy strategy;
+    strategy.setOrderChannel(&channel);
+
+    BookUpdate unknown = book(1000, 1001, 90, 10);
+    unknown.instrumentId = kInvalidInstrument;
+    strategy.onBookUpdate(unknown);  // Invalid instrument id: ignored
+    EXPECT_TRUE(fillAll(channel, strategy).empty());
+
+    strategy.onBookUpdate(book(1000, 1001, 50, 50));  // Balanced: nothing to do
+    strategy.onBookUpdate(book(1000, 1010, 90, 10));  // Heavy bid, but the spread is too wide
+    EXPECT_TRUE(fillAll(channel, strategy).empty());
+
+    strategy.onBookUpdate(book(1000, 1001, 90, 10));  // Heavy bid on a tight book: buy at the ask
+    auto intents = fillAll(channel, strategy);
+    ASSERT_EQ(intents.size(), 1u);
+    EXPECT_EQ(intents[0].quantity, config::SCALPING_ORDER_QUANTITY);
+    EXPECT_EQ(intents[0].price, 1001);
+    EXPECT_EQ(strategy.position(3), config::SCALPING_ORDER_QUANTITY);
+
+    strategy.onBookUpdate(book(1002, 1003, 90, 10));  // One tick of profit: hold
+    EXPECT_TRUE(fillAll(channel, strategy).empty());
+    strategy.onBookUpdate(book(1003, 1004, 90, 10));  // Two ticks: take profit at the bid
+    intents = fillAll(channel, strategy);
+    ASSERT_EQ(intents.size(), 1u);
+    EXPECT_EQ(intents[0].quantity, -config::SCALPING_ORDER_QUANTITY);
+    EXPECT_EQ(intents[0].price, 1003);
+    EXPECT_EQ(strategy.position(3), 0);
+
+    strategy.onBookUpdate(book(1000, 1001, 10, 90));  // Heavy ask: sell at the bid
+    strategy.onBookUpdate(book(1003, 1004, 40, 60));  // Three ticks against: stop loss at the ask
+    intents = fillAll(channel, strategy);
+    ASSERT_EQ(intents.size(), 2u);
+    EXPECT_EQ(intents[0].price, 1000);
+    EXPECT_EQ(intents[1].price, 1004);
+    EXPECT_EQ(strategy.position(3), 0);
+
+    strategy.onBookUpdate(book(1000, 1001, 90, 10));  // Buy...
+    strategy.onBookUpdate(book(1000, 1001, 10, 90));  // ...and leave when the imbalance turns
+    EXPECT_EQ(fillAll(channel, strategy).size(), 2u);
+    EXPECT_EQ(strategy.analyzeResults(), "Scalping strategy executed 6 trades.");
+}
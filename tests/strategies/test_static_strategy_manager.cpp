@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "static_strategy_manager.h"
+#include "strategy_manager.h"
+
+namespace {
+
+// Strategy that buys one lot on every trade and records what it sees.
+class TradeFollower final : public BaseStrategy {
+public:
+    void execute() override { ++executions; }
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+    TickColumnMask requiredColumns() const override { return tickColumnBit(TickColumn::TradePrice); }
+
+    void onBookUpdate(const BookUpdate& update) override { lastBid = update.bidPrice; }
+
+    void onTrade(const Trade& trade) override {
+        OrderIntent intent;
+        intent.instrumentId = trade.instrumentId;
+        intent.quantity = 1;
+        intent.price = trade.price;
+        intent.tickSize = trade.tickSize;
+        submitOrder(intent);
+    }
+
+    void onFill(const Fill& fill) override { position += fill.quantity; }
+    void onBar(const Bar& bar) override { lastClose = bar.close; }
+    void onTimer(const TimerEvent& timer) override { lastTimer = timer.timestamp; }
+
+    int executions = 0;
+    PriceTicks lastBid = 0;
+    std::int64_t position = 0;
+    double lastClose = 0.0;
+    std::int64_t lastTimer = 0;
+};
+
+// Strategy that reads the batch columns itself.
+class ColumnReader final : public BaseStrategy {
+public:
+    void execute() override {}
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+    TickColumnMask requiredColumns() const override { return tickColumnBit(TickColumn::BidPrice); }
+
+    void onBatch(const TickBatch& batch) override {
+        rows += batch.size();
+        ++batches;
+    }
+
+    void onBookUpdate(const BookUpdate&) override { ++updates; }
+
+    std::size_t rows = 0;
+    int batches = 0;
+    int updates = 0;
+};
+
+TickBatch makeBatch() {
+    TickBatch batch;
+    Tick tick;
+    tick.instrumentId = 1;
+    tick.bidPrice = 4.0;
+    batch.append(tick);
+    tick.tradePrice = 4.5;
+    tick.tradeQuantity = 10;
+    batch.append(tick);
+    return batch;
+}
+
+} // namespace
+
+// Test to ensure that batches reach every strategy of the pack, through onBatch() for strategies that
+// override it and through the decoded events for the others.
+TEST(StaticStrategyManagerTests, DispatchesBatchesAtCompileTime) {
+    InstrumentRegistry registry;
+    registry.add({"AAA", 0.01, 1});
+    registry.add({"BBB", 0.5, 1});
+    StaticStrategyManager<TradeFollower, ColumnReader> manager;
+    manager.setInstruments(registry);
+
+    const TickBatch batch = makeBatch();
+    manager.executeStrategies(batch);
+    manager.executeStrategies(batch);
+
+    TradeFollower& follower = manager.strategy<TradeFollower>();
+    ColumnReader& reader = manager.strategy<1>();
+    EXPECT_EQ(follower.lastBid, 8);
+    EXPECT_EQ(follower.executions, 0);
+    EXPECT_EQ(reader.rows, 4u);
+    EXPECT_EQ(reader.batches, 2);
+    EXPECT_EQ(reader.updates, 0);  // Its own onBatch() does not forward to onBookUpdate()
+    EXPECT_EQ(manager.batchTime().count, 2u);
+    EXPECT_EQ(manager.requiredColumns(),
+              tickColumnBit(TickColumn::TradePrice) | tickColumnBit(TickColumn::BidPrice));
+
+    std::vector<OrderIntent> routed;
+    EXPECT_EQ(manager.routeOrders([&routed](const OrderIntent& intent) {
+        routed.push_back(intent);
+        return true;
+    }), 2u);
+    EXPECT_EQ(follower.position, 2);
+    ASSERT_EQ(routed.size(), 2u);
+    EXPECT_EQ(routed[0].price, 9);
+    EXPECT_EQ(routed[1].orderId, 2u);
+
+    Bar bar;
+    bar.close = 7.0;
+    manager.executeStrategies(std::span<const Bar>(&bar, 1));
+    manager.executeTimers(TimerEvent{99});
+    EXPECT_DOUBLE_EQ(follower.lastClose, 7.0);
+    EXPECT_EQ(follower.lastTimer, 99);
+}
+
+// Test to ensure that the static and the dynamic managers deliver the same events.
+TEST(StaticStrategyManagerTests, MatchesDynamicManager) {
+    StaticStrategyManager<TradeFollower> staticManager;
+    StrategyManager dynamicManager;
+    auto dynamicStrategy = std::make_shared<TradeFollower>();
+    dynamicManager.addStrategy(dynamicStrategy);
+
+    const TickBatch batch = makeBatch();
+    auto fillAll = [](const OrderIntent&) { return true; };
+    for (int i = 0; i < 3; ++i) {
+        staticManager.executeStrategies(batch);
+        dynamicManager.executeStrategies(batch);
+        staticManager.routeOrders(fillAll);
+        dynamicManager.routeOrders(fillAll);
+    }
+    EXPECT_EQ(staticManager.strategy<0>().position, dynamicStrategy->position);
+    EXPECT_EQ(staticManager.strategy<0>().lastBid, dynamicStrategy->lastBid);
+    EXPECT_EQ(staticManager.strategy<0>().position, 3);
+}
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "strategy_manager.h"
+
+namespace {
+
+// Strategy that records the last bid seen per instrument and can be made slow.
+class RecordingStrategy : public BaseStrategy {
+public:
+    explicit RecordingStrategy(std::chrono::microseconds delay) : delay_(delay) {}
+
+    void execute() override {}
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+
+    void onBatch(const TickBatch& batch) override {
+        std::this_thread::sleep_for(delay_);
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            lastBid[batch.instrumentIds()[i]] = batch.bidPrices()[i];
+        }
+        rows += batch.size();
+    }
+
+    void onBar(const Bar&) override { rowsAtBar = rows; }
+
+    double lastBid[2] = {0.0, 0.0};
+    std::size_t rows = 0;
+    std::size_t rowsAtBar = 0;  // Rows seen when the last bar arrived
+
+private:
+    std::chrono::microseconds delay_;
+};
+
+} // namespace
+
+// Test to ensure that serial delivery runs every strategy over every row.
+TEST(StrategyManagerTests, DeliversSerially) {
+    StrategyManager manager;
+    auto strategy = std::make_shared<RecordingStrategy>(std::chrono::microseconds(0));
+    manager.addStrategy(strategy);
+
+    TickBatch batch;
+    Tick tick;
+    tick.bidPrice = 10.0;
+    batch.append(tick);
+    batch.append(tick);
+    manager.executeStrategies(batch);
+    EXPECT_EQ(strategy->rows, 2u);
+    EXPECT_EQ(manager.strategyTime(0).count, 1u);
+    EXPECT_EQ(manager.strategyTime(1).count, 0u);
+}
+
+// Test to ensure that in conflated mode a slow strategy gets the latest state per instrument
+// instead of every update, and does not hold back the others.
+TEST(StrategyManagerTests, ConflatesForSlowStrategies) {
+    StrategyManager manager;
+    auto slow = std::make_shared<RecordingStrategy>(std::chrono::milliseconds(20));
+    auto fast = std::make_shared<RecordingStrategy>(std::chrono::microseconds(0));
+    manager.addStrategy(slow);
+    manager.setDeliveryMode(StrategyManager::DeliveryMode::Conflated);
+    manager.addStrategy(fast);
+
+    constexpr int kBatches = 50;
+    TickBatch batch;
+    for (int i = 1; i <= kBatches; ++i) {
+        batch.clear();
+        for (InstrumentId id = 0; id < 2; ++id) {
+            Tick tick;
+            tick.instrumentId = id;
+            tick.bidPrice = i * 10.0 + id;
+            batch.append(tick);
+        }
+        manager.executeStrategies(batch);
+    }
+    manager.waitUntilIdle();
+
+    for (const auto& strategy : {slow, fast}) {
+        EXPECT_DOUBLE_EQ(strategy->lastBid[0], kBatches * 10.0);
+        EXPECT_DOUBLE_EQ(strategy->lastBid[1], kBatches * 10.0 + 1);
+    }
+    EXPECT_LT(slow->rows, 2u * kBatches);
+    EXPECT_GT(manager.conflatedUpdates(0), 0u);
+    EXPECT_EQ(manager.droppedUpdates(0), 0u);
+    EXPECT_GE(manager.strategyTime(0).max, 20'000'000);
+    EXPECT_EQ(manager.strategyTime(0).count, slow->rows / 2);
+
+    // An instrument beyond the buffers is counted, not silently lost.
+    batch.clear();
+    Tick unknown;
+    unknown.instrumentId = config::CONFLATION_MAX_INSTRUMENTS;
+    batch.append(unknown);
+    manager.executeStrategies(batch);
+    manager.waitUntilIdle();
+    EXPECT_EQ(manager.droppedUpdates(1), 1u);
+
+    manager.setDeliveryMode(StrategyManager::DeliveryMode::Serial);
+    EXPECT_EQ(manager.deliveryMode(), StrategyManager::DeliveryMode::Serial);
+    EXPECT_EQ(manager.strategyTime(0).count, slow->rows / 2);  // Kept after the strategy threads stop
+}
+
+// Test to ensure that in multicast mode every strategy sees every batch on its own thread, including a
+// strategy added while batches are flowing.
+TEST(StrategyManagerTests, MulticastsEveryBatch) {
+    StrategyManager manager;
+    auto first = std::make_shared<RecordingStrategy>(std::chrono::microseconds(0));
+    auto slow = std::make_shared<RecordingStrategy>(std::chrono::microseconds(200));
+    manager.addStrategy(first);
+    manager.addStrategy(slow);
+    manager.setWaitStrategy(WaitStrategy::Yield);
+    manager.setDeliveryMode(StrategyManager::DeliveryMode::Multicast);
+
+    TickBatch batch;
+    auto publish = [&](int count) {
+        for (int i = 1; i <= count; ++i) {
+            batch.clear();
+            for (InstrumentId id = 0; id < 2; ++id) {
+                Tick tick;
+                tick.instrumentId = id;
+                tick.bidPrice = i * 10.0 + id;
+                batch.append(tick);
+            }
+            manager.executeStrategies(batch);
+        }
+    };
+    publish(50);
+    auto late = std::make_shared<RecordingStrategy>(std::chrono::microseconds(0));
+    manager.addStrategy(late);
+    publish(20);
+    manager.waitUntilIdle();
+
+    EXPECT_EQ(first->rows, 140u);
+    EXPECT_EQ(slow->rows, 140u);  // Nothing is conflated away
+    EXPECT_EQ(late->rows, 40u);   // Only the batches published after it joined
+    EXPECT_DOUBLE_EQ(first->lastBid[1], 201.0);
+    EXPECT_EQ(manager.strategyTime(1).count, 70u);
+    EXPECT_EQ(manager.conflatedUpdates(0), 0u);
+
+    manager.setDeliveryMode(StrategyManager::DeliveryMode::Serial);
+    publish(1);
+    EXPECT_EQ(late->rows, 42u);
+}
+
+// Test to ensure that a strategy the multicast ring has no cursor for is rejected without disturbing the
+// others, and that entering multicast mode with too many strategies falls back to serial delivery.
+TEST(StrategyManagerTests, RejectsStrategiesBeyondRingConsumers) {
+    StrategyManager manager;
+    manager.setWaitStrategy(WaitStrategy::Yield);
+    manager.setDeliveryMode(StrategyManager::DeliveryMode::Multicast);
+    std::vector<std::shared_ptr<RecordingStrategy>> strategies;
+    for (unsigned i = 0; i <= config::MULTICAST_RING_MAX_CONSUMERS; ++i) {
+        strategies.push_back(std::make_shared<RecordingStrategy>(std::chrono::microseconds(0)));
+    }
+    for (unsigned i = 0; i < config::MULTICAST_RING_MAX_CONSUMERS; ++i) {
+        manager.addStrategy(strategies[i]);
+    }
+    EXPECT_THROW(manager.addStrategy(strategies.back()), std::runtime_error);
+
+    TickBatch batch;
+    Tick tick;
+    tick.bidPrice = 10.0;
+    batch.append(tick);
+    manager.executeStrategies(batch);
+    manager.waitUntilIdle();
+    manager.setDeliveryMode(StrategyManager::DeliveryMode::Serial);
+    manager.executeStrategies(batch);
+    EXPECT_EQ(strategies.front()->rows, 2u);
+    EXPECT_EQ(strategies[config::MULTICAST_RING_MAX_CONSUMERS - 1]->rows, 2u);
+    EXPECT_EQ(strategies.back()->rows, 0u);  // Never registered
+
+    manager.addStrategy(strategies.back());  // Serial mode has no cursor limit
+    EXPECT_THROW(manager.setDeliveryMode(StrategyManager::DeliveryMode::Multicast), std::runtime_error);
+    manager.executeStrategies(batch);        // Still delivered serially
+    EXPECT_EQ(strategies.front()->rows, 3u);
+    EXPECT_EQ(strategies.back()->rows, 1u);
+}
+
+// Test to ensure that in the threaded modes bars reach a strategy only after its thread has finished the
+// batches published before them, so the strategy is never called from two threads at once.
+TEST(StrategyManagerTests, WaitsForStrategyThreadsBeforeBars) {
+    for (auto mode : {StrategyManager::DeliveryMode::Conflated, StrategyManager::DeliveryMode::Multicast}) {
+        StrategyManager manager;
+        auto strategy = std::make_shared<RecordingStrategy>(std::chrono::milliseconds(10));
+        manager.addStrategy(strategy);
+        manager.setDeliveryMode(mode);
+
+        TickBatch batch;
+        batch.append(Tick{});
+        manager.executeStrategies(batch);
+        const Bar bar{};
+        manager.executeStrategies(std::span<const Bar>(&bar, 1));
+        EXPECT_EQ(strategy->rowsAtBar, 1u);
+    }
+}
+
+namespace {
+
+// Strategy that buys one lot on every book update and counts its fills and timers.
+class OrderingStrategy : public BaseStrategy {
+public:
+    void execute() override {}
+    void configure(const std::string&) override {}
+    std::string analyzeResults() const override { return ""; }
+
+    void onBookUpdate(const BookUpdate& update) override {
+        OrderIntent intent;
+        intent.instrumentId = update.instrumentId;
+        intent.quantity = 1;
+        intent.price = update.askPrice;
+        intent.tickSize = update.tickSize;
+        submitOrder(intent);
+    }
+
+    void onFill(const Fill& fill) override {
+        ++fills;
+        position += fill.quantity;
+        lastFillPrice = fill.price;
+    }
+
+    void onTimer(const TimerEvent& timer) override { lastTimer = timer.timestamp; }
+
+    int fills = 0;
+    std::int64_t position = 0;
+    PriceTicks lastFillPrice = 0;
+    std::int64_t lastTimer = 0;
+};
+
+} // namespace
+
+// Test to ensure that routed orders come back to their strategy as fills, on the strategy's thread in
+// the threaded modes, and that timers reach every strategy.
+TEST(StrategyManagerTests, RoutesOrdersAndReportsFills) {
+    StrategyManager manager;
+    auto strategy = std::make_shared<OrderingStrategy>();
+    manager.addStrategy(strategy);
+
+    TickBatch batch;
+    Tick tick;
+    tick.askPrice = 2.5;
+    batch.append(tick);
+    batch.append(tick);
+    manager.executeStrategies(batch);
+
+    std::vector<OrderIntent> routed;
+    auto router = [&routed](const OrderIntent& intent) {
+        routed.push_back(intent);
+        return intent.orderId != 2;  // The second order is not executed
+    };
+    EXPECT_EQ(manager.routeOrders(router), 2u);
+    EXPECT_EQ(strategy->fills, 1);  // Serial mode: delivered at once
+    EXPECT_EQ(strategy->lastFillPrice, 250);
+
+    manager.setDeliveryMode(StrategyManager::DeliveryMode::Multicast);
+    manager.executeStrategies(batch);
+    manager.waitUntilIdle();
+    EXPECT_EQ(manager.routeOrders(router), 2u);
+    manager.executeStrategies(batch);  // The fills are delivered before this batch
+    manager.waitUntilIdle();
+    EXPECT_EQ(strategy->fills, 3);
+    EXPECT_EQ(strategy->position, 3);
+
+    manager.executeTimers(TimerEvent{42});
+    EXPECT_EQ(strategy->lastTimer, 42);
+    EXPECT_EQ(routed.size(), 4u);
+    EXPECT_EQ(manager.orderChannel(0).rejected(), 0u);
+}
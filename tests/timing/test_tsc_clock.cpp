@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "latency_stats.h"
+#include "tsc_clock.h"
+
+// Test to ensure that the clock agrees with the system clocks it is calibrated against.
+TEST(TscClockTests, MatchesSystemClocks) {
+    TscClock::calibrate();  // As main() does, so the readings below do not wait for the calibration
+    const std::int64_t realtime = TscClock::systemNanos(CLOCK_REALTIME);
+    const std::int64_t monotonic = TscClock::systemNanos(CLOCK_MONOTONIC);
+    EXPECT_NEAR(static_cast<double>(TscClock::now()), static_cast<double>(realtime), 1e6);
+    EXPECT_NEAR(static_cast<double>(TscClock::monotonicNow()), static_cast<double>(monotonic), 1e6);
+    if (TscClock::usesTsc()) {
+        EXPECT_GT(TscClock::cyclesPerNanosecond(), 0.1);
+        EXPECT_LT(TscClock::cyclesPerNanosecond(), 10.0);
+    }
+}
+
+// Test to ensure that a cycle count converts to the duration it took.
+TEST(TscClockTests, ConvertsCyclesToNanoseconds) {
+    const std::uint64_t start = TscClock::cycles();
+    const std::int64_t monotonicStart = TscClock::systemNanos(CLOCK_MONOTONIC);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const std::int64_t elapsed = TscClock::toNanos(TscClock::cycles() - start);
+    const std::int64_t expected = TscClock::systemNanos(CLOCK_MONOTONIC) - monotonicStart;
+    EXPECT_NEAR(static_cast<double>(elapsed), static_cast<double>(expected), expected * 0.02 + 100000.0);
+}
+
+// Test to ensure that readings never go backwards and stay accurate while the drift correction slews the clock.
+TEST(TscClockTests, StaysMonotonicAcrossRecalibration) {
+    TscClock::startDriftCorrection(std::chrono::milliseconds(1));
+    std::int64_t previous = TscClock::monotonicNow();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(30);
+    std::int64_t backwards = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        const std::int64_t current = TscClock::monotonicNow();
+        backwards = std::max(backwards, previous - current);
+        previous = current;
+    }
+    TscClock::stopDriftCorrection();
+
+    EXPECT_EQ(backwards, 0);
+    EXPECT_NEAR(static_cast<double>(TscClock::monotonicNow()),
+                static_cast<double>(TscClock::systemNanos(CLOCK_MONOTONIC)), 1e6);
+}
+
+// Test to ensure that latency samples are accumulated and merged.
+TEST(TscClockTests, LatencyStatsAccumulate) {
+    LatencyStats stats;
+    EXPECT_DOUBLE_EQ(stats.mean(), 0.0);
+    stats.add(100);
+    stats.add(300);
+    stats.add(-5);  // Clock skew is clamped to 0
+    EXPECT_EQ(stats.count, 3u);
+    EXPECT_EQ(stats.max, 300);
+    EXPECT_DOUBLE_EQ(stats.mean(), 400.0 / 3.0);
+
+    LatencyStats other;
+    other.add(1000);
+    stats.merge(other);
+    EXPECT_EQ(stats.count, 4u);
+    EXPECT_EQ(stats.total, 1400);
+    EXPECT_EQ(stats.max, 1000);
+    stats.reset();
+    EXPECT_EQ(stats.count, 0u);
+}
+
+// Test to ensure that without the TSC, cycle counts are still converted to the right durations.
+TEST(TscClockTests, FallsBackToSystemClock) {
+    TscClock::disable();
+    EXPECT_FALSE(TscClock::usesTsc());
+    const std::uint64_t start = TscClock::cycles();
+    const std::int64_t monotonicStart = TscClock::systemNanos(CLOCK_MONOTONIC);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const std::int64_t elapsed = TscClock::toNanos(TscClock::cycles() - start);
+    const std::int64_t expected = TscClock::systemNanos(CLOCK_MONOTONIC) - monotonicStart;
+    EXPECT_NEAR(static_cast<double>(elapsed), static_cast<double>(expected), 100000.0);
+    EXPECT_NEAR(static_cast<double>(TscClock::now()),
+                static_cast<double>(TscClock::systemNanos(CLOCK_REALTIME)), 1e6);
+
+    TscClock::calibrate();  // Restore the TSC for the other tests
+}